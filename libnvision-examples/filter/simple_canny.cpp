@@ -19,20 +19,15 @@ int main(int argc, const char **argv)
     std::cout << "Load " << argv[1] << std::endl;
     nvision::imload(argv[1], src);
 
-    nvision::GaussFilter<nvision::float32, 3> smoothFilter;
-    nvision::SobelFilter<nvision::float32> gradientFilter;
+    // Create a Canny detector object. The template parameter determines the
+    // internal Scalar type, which is used for computations. The detector
+    // smoothes the image, computes the gradients and detects the edges in a
+    // single pass over bands of the image.
+    nvision::CannyEdgeDetector<nvision::float32> edgeDetector(1, 0.078f, 0.3992f);
 
-    // Create a Canny filter object. The template parameter determines the
-    // internal Scalar type, which is used for computations (e.g. Kernel and
-    // Kernel application).
-    nvision::CannyEdgeFilter<nvision::float32> edgeFilter;
-
-    // Apply the filter to the source image and store it in dest.
+    // Apply the detector to the source image and store it in dest.
     std::cout << "Apply filter" << std::endl;
-    nvision::Image<nvision::Grayf> smooth = smoothFilter(src);
-    nvision::Image<nvision::Grayf> gradientX = gradientFilter(smooth, nvision::GradientMode::X{});
-    nvision::Image<nvision::Grayf> gradientY = gradientFilter(smooth, nvision::GradientMode::Y{});
-    nvision::Image<nvision::Grayf> dest = edgeFilter(gradientX, gradientY);
+    nvision::Image<nvision::Gray> dest = edgeDetector(src);
 
     // Save the image to a file. The file type is determined by the extension
     // of the file.
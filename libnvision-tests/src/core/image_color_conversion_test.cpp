@@ -0,0 +1,35 @@
+/* image_color_conversion_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image.h"
+
+using namespace nvision;
+
+TEST_CASE("image color conversion", "[core]")
+{
+    Image<RGB> img(3, 4);
+    img(0, 0) = Pixel<RGB>(122, 36, 209);  img(0, 1) = Pixel<RGB>(21, 241, 78);  img(0, 2) = Pixel<RGB>(0, 0, 0);       img(0, 3) = Pixel<RGB>(255, 255, 255);
+    img(1, 0) = Pixel<RGB>(255, 0, 0);     img(1, 1) = Pixel<RGB>(0, 255, 0);    img(1, 2) = Pixel<RGB>(0, 0, 255);     img(1, 3) = Pixel<RGB>(128, 128, 0);
+    img(2, 0) = Pixel<RGB>(255, 10, 100);  img(2, 1) = Pixel<RGB>(7, 80, 80);    img(2, 2) = Pixel<RGB>(90, 30, 90);    img(2, 3) = Pixel<RGB>(1, 2, 3);
+
+    SECTION("RGB to HSV")
+    {
+        Image<HSV> expected = image::convert<HSV>(img);
+        Image<HSV> actual = image::rgbToHSV(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-5);
+    }
+
+    SECTION("HSV to RGB")
+    {
+        Image<HSV> hsv = image::convert<HSV>(img);
+        Image<RGBf> expected = image::convert<RGBf>(hsv);
+        Image<RGBf> actual = image::hsvToRGB(hsv);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-5);
+    }
+}
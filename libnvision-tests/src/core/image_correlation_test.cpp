@@ -87,3 +87,98 @@ TEMPLATE_TEST_CASE("image correlation", "[core]",
         REQUIRE_IMAGE_APPROX(expected, result, 1);
     }
 }
+
+TEMPLATE_TEST_CASE("image correlation runtime kernel size", "[core]", Gray, RGB, Grayf, RGBf)
+{
+    Image<TestType> img(17, 14);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<typename TestType::ValueType>((r * 37 + c * 91 + d * 53) % 256);
+
+    // reference implementation, which applies the border handling to every tap
+    const auto reference = [&img](const Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic> &kernel, const auto &handling)
+    {
+        Image<TestType> result(img.rows(), img.cols());
+        for(Index c = 0; c < img.cols(); ++c)
+        {
+            for(Index r = 0; r < img.rows(); ++r)
+            {
+                for(Index d = 0; d < result(r, c).size(); ++d)
+                {
+                    float32 sum = 0;
+                    for(Index kc = 0; kc < kernel.cols(); ++kc)
+                        for(Index kr = 0; kr < kernel.rows(); ++kr)
+                            sum += kernel(kr, kc) * static_cast<float32>(handling(img, r + kr - kernel.rows() / 2, c + kc - kernel.cols() / 2)[d]);
+                    result(r, c)[d] = static_cast<typename TestType::ValueType>(sum);
+                }
+            }
+        }
+        return result;
+    };
+
+    SECTION("unrolled kernel sizes")
+    {
+        for(Index size = 1; size <= 13; size += 2)
+        {
+            Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic> kernel(size, size);
+            for(Index i = 0; i < kernel.size(); ++i)
+                kernel(i) = static_cast<float32>((i * 7) % 11) / static_cast<float32>(6 * kernel.size());
+
+            Image<TestType> expected = reference(kernel, BorderReflect{});
+            Image<TestType> actual = image::correlate(img, kernel);
+            REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+            expected = reference(kernel, BorderConstant<TestType>());
+            actual = image::correlate(img, kernel, BorderConstant<TestType>());
+            REQUIRE_IMAGE_APPROX(expected, actual, 1);
+        }
+    }
+
+    SECTION("non-square kernel")
+    {
+        Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic> kernel(3, 5);
+        kernel << 0.1f, 0.0f, 0.2f, 0.1f, 0.0f,
+                  0.0f, 0.1f, 0.1f, 0.0f, 0.1f,
+                  0.1f, 0.1f, 0.0f, 0.0f, 0.1f;
+
+        Image<TestType> expected = reference(kernel, BorderRepeat{});
+        Image<TestType> actual = image::correlate(img, kernel, BorderRepeat{});
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("separable kernel")
+    {
+        Eigen::Matrix<float32, 7, 1> vertical;
+        vertical << 0.05f, 0.1f, 0.2f, 0.3f, 0.2f, 0.1f, 0.05f;
+        Eigen::Matrix<float32, 9, 1> horizontal;
+        horizontal << -0.1f, 0.0f, 0.1f, 0.2f, 0.4f, 0.2f, 0.1f, 0.0f, 0.1f;
+        const Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic> kernel = vertical * horizontal.transpose();
+
+        Eigen::Array<float32, Eigen::Dynamic, 1> verticalOut;
+        Eigen::Array<float32, Eigen::Dynamic, 1> horizontalOut;
+        REQUIRE(image::internal::separateKernel(kernel, verticalOut, horizontalOut));
+        const Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic> product = verticalOut.matrix() * horizontalOut.matrix().transpose();
+        REQUIRE_MATRIX_APPROX(kernel, product, 1e-6);
+
+        Image<TestType> expected = reference(kernel, BorderReflect{});
+        Image<TestType> actual = image::correlate(img, kernel);
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+        expected = reference(kernel, BorderConstant<TestType>(Pixel<TestType>(50)));
+        actual = image::correlate(img, kernel, BorderConstant<TestType>(Pixel<TestType>(50)));
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("non-separable kernel")
+    {
+        Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic> kernel(3, 3);
+        kernel << 1, 0, 0,
+                  0, 1, 0,
+                  0, 0, 1;
+
+        Eigen::Array<float32, Eigen::Dynamic, 1> vertical;
+        Eigen::Array<float32, Eigen::Dynamic, 1> horizontal;
+        REQUIRE_FALSE(image::internal::separateKernel(kernel, vertical, horizontal));
+    }
+}
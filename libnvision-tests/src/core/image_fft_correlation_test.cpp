@@ -0,0 +1,93 @@
+/* image_fft_correlation_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image.h"
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("image fft correlation", "[core]", Gray, RGB, Grayf, RGBf)
+{
+    // spans multiple rows and columns of tiles
+    Image<TestType> img(70, 65);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<typename TestType::ValueType>((r * 37 + c * 91 + d * 53) % 256);
+
+    Eigen::Array<float32, 5, 3> kernel;
+    kernel << 0.02f, 0.05f, 0.01f,
+              0.06f, 0.10f, 0.04f,
+              0.03f, 0.20f, 0.08f,
+              0.07f, 0.12f, 0.05f,
+              0.01f, 0.09f, 0.07f;
+
+    SECTION("border reflect")
+    {
+        Image<TestType> expected = image::correlate(img, kernel, BorderReflect{});
+        Image<TestType> actual = image::correlate(img, kernel, CorrelationMode::FFT{}, BorderReflect{});
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("border constant")
+    {
+        const auto handling = BorderConstant<TestType>(Pixel<TestType>(10));
+        Image<TestType> expected = image::correlate(img, kernel, handling);
+        Image<TestType> actual = image::correlate(img, kernel, CorrelationMode::FFT{}, handling);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("reused spectrum")
+    {
+        const auto spectrum = KernelSpectrum<float32>(kernel);
+        REQUIRE(spectrum.kernelRows() == 5);
+        REQUIRE(spectrum.kernelCols() == 3);
+        REQUIRE(spectrum.fftRows() == 32);
+        REQUIRE(spectrum.fftCols() == 32);
+
+        Image<TestType> expected = image::correlate(img, kernel);
+        Image<TestType> actual = image::correlate(img, spectrum);
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+        Image<TestType> small = img.block(3, 4, 9, 7);
+        expected = image::correlate(small, kernel, BorderRepeat{});
+        actual = image::correlate(small, spectrum, BorderRepeat{});
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("automatic mode")
+    {
+        Image<TestType> expected = image::correlate(img, kernel);
+        Image<TestType> actual = image::correlate(img, kernel, CorrelationMode::Auto{});
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("convolution")
+    {
+        const Eigen::Array<float32, 5, 3> reversed = kernel.reverse();
+        Image<TestType> expected = image::correlate(img, reversed);
+        Image<TestType> direct = image::convolve(img, kernel, CorrelationMode::Direct{});
+        Image<TestType> fft = image::convolve(img, kernel, CorrelationMode::FFT{});
+
+        REQUIRE_IMAGE_APPROX(expected, direct, 1e-3);
+        REQUIRE_IMAGE_APPROX(expected, fft, 1);
+    }
+}
+
+TEST_CASE("image fft correlation cost model", "[core]")
+{
+    REQUIRE(KernelSpectrum<float32>::fftSize(1) == 32);
+    REQUIRE(KernelSpectrum<float32>::fftSize(9) == 64);
+    REQUIRE(KernelSpectrum<float32>::fftSize(31) == 128);
+
+    REQUIRE_FALSE(image::internal::preferFFTCorrelation(512, 512, 3, 3));
+    REQUIRE(image::internal::preferFFTCorrelation(512, 512, 9, 9));
+    REQUIRE(image::internal::preferFFTCorrelation(512, 512, 31, 31));
+    REQUIRE_FALSE(image::internal::preferFFTCorrelation(16, 16, 9, 9));
+}
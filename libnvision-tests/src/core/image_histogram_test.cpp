@@ -0,0 +1,46 @@
+/* image_histogram_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image_histogram.h"
+
+using namespace nvision;
+
+TEST_CASE("image histogram", "[core]")
+{
+    SECTION("gray image")
+    {
+        Image<Gray> img(5, 3);
+        img(0, 0).setConstant(0);   img(0, 1).setConstant(255); img(0, 2).setConstant(125);
+        img(1, 0).setConstant(255); img(1, 1).setConstant(0);   img(1, 2).setConstant(0);
+        img(2, 0).setConstant(255); img(2, 1).setConstant(255); img(2, 2).setConstant(255);
+        img(3, 0).setConstant(125); img(3, 1).setConstant(0);   img(3, 2).setConstant(255);
+        img(4, 0).setConstant(7);   img(4, 1).setConstant(7);   img(4, 2).setConstant(125);
+
+        const auto hist = image::histogram(img);
+
+        REQUIRE(15 == hist.sum());
+        REQUIRE(4 == hist(0, 0));
+        REQUIRE(2 == hist(7, 0));
+        REQUIRE(3 == hist(125, 0));
+        REQUIRE(6 == hist(255, 0));
+    }
+
+    SECTION("rgb image")
+    {
+        Image<RGB> img(130, 70);
+        for(Index i = 0; i < img.size(); ++i)
+            img(i) = Pixel<RGB>(static_cast<uint8>(i % 256), 3, static_cast<uint8>(i % 2));
+
+        const auto hist = image::histogram(img);
+
+        REQUIRE(3 == hist.cols());
+        REQUIRE(img.size() == hist.col(0).sum());
+        REQUIRE(img.size() == hist(3, 1));
+        REQUIRE(img.size() / 2 == hist(0, 2));
+        REQUIRE(img.size() / 2 == hist(1, 2));
+    }
+}
@@ -0,0 +1,95 @@
+/* image_integral_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image.h"
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("image integral", "[core]", Gray, RGB, BGRA, Grayf, RGBf)
+{
+    Image<TestType> img(3, 3);
+
+    img(0, 0).setConstant(44);
+    img(0, 1).setConstant(121);
+    img(0, 2).setConstant(14);
+
+    img(1, 0).setConstant(32);
+    img(1, 1).setConstant(158);
+    img(1, 2).setConstant(101);
+
+    img(2, 0).setConstant(219);
+    img(2, 1).setConstant(11);
+    img(2, 2).setConstant(82);
+
+    const auto integral = image::integral(img);
+
+    SECTION("table")
+    {
+        REQUIRE(3 == integral.rows());
+        REQUIRE(3 == integral.cols());
+        REQUIRE(4 == integral.sum(0).rows());
+        REQUIRE(4 == integral.sum(0).cols());
+
+        REQUIRE(0 == integral.sum(0)(0, 2));
+        REQUIRE(0 == integral.sum(0)(2, 0));
+        REQUIRE(Approx(44) == integral.sum(0)(1, 1));
+        REQUIRE(Approx(355) == integral.sum(0)(2, 2));
+        REQUIRE(Approx(782) == integral.sum(0)(3, 3));
+    }
+
+    SECTION("box sum")
+    {
+        for(Index d = 0; d < TestType::Dimension; ++d)
+        {
+            REQUIRE(Approx(782) == integral.boxSum(0, 0, 3, 3)(d));
+            REQUIRE(Approx(158) == integral.boxSum(1, 1, 1, 1)(d));
+            REQUIRE(Approx(352) == integral.boxSum(1, 1, 2, 2)(d));
+            REQUIRE(Approx(135) == integral.boxSum(0, 1, 1, 2)(d));
+            REQUIRE(Approx(0) == integral.boxSum(1, 1, 0, 2)(d));
+        }
+    }
+
+    SECTION("box sum of squares")
+    {
+        for(Index d = 0; d < TestType::Dimension; ++d)
+        {
+            REQUIRE(Approx(107768) == integral.boxSumSq(0, 0, 3, 3)(d));
+            REQUIRE(Approx(24964) == integral.boxSumSq(1, 1, 1, 1)(d));
+            REQUIRE(Approx(2960) == integral.boxSumSq(0, 0, 2, 1)(d));
+        }
+    }
+}
+
+TEST_CASE("image integral of large image", "[core]")
+{
+    Image<RGB> img(300, 280);
+    for(Index i = 0; i < img.size(); ++i)
+        img(i) = Pixel<RGB>(static_cast<uint8>(i % 251), static_cast<uint8>(i % 13), 255);
+
+    const auto integral = image::integral(img);
+    const Index row = 17;
+    const Index col = 33;
+    const Index height = 270;
+    const Index width = 201;
+
+    Eigen::Array<int64, 3, 1> expected = Eigen::Array<int64, 3, 1>::Zero();
+    Eigen::Array<int64, 3, 1> expectedSq = Eigen::Array<int64, 3, 1>::Zero();
+    for(Index c = col; c < col + width; ++c)
+    {
+        for(Index r = row; r < row + height; ++r)
+        {
+            for(Index d = 0; d < 3; ++d)
+            {
+                expected(d) += img(r, c)[d];
+                expectedSq(d) += img(r, c)[d] * img(r, c)[d];
+            }
+        }
+    }
+
+    REQUIRE_MATRIX(expected, integral.boxSum(row, col, height, width));
+    REQUIRE_MATRIX(expectedSq, integral.boxSumSq(row, col, height, width));
+}
@@ -0,0 +1,62 @@
+/* image_separable_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image.h"
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("image separable filter", "[core]", Grayf, RGBf, BGRAf)
+{
+    Image<TestType> img(5, 6);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c).setConstant((r * 37 + c * 91) % 256);
+
+    SECTION("matches runtime kernel")
+    {
+        using Kernel = SeparableKernel<KernelTaps<1, 2, 1>, KernelTaps<-1, 0, 3, 0, 1>>;
+        Eigen::Matrix<float32, 3, 5> kernel;
+        kernel << -1, 0, 3, 0, 1,
+                  -2, 0, 6, 0, 2,
+                  -1, 0, 3, 0, 1;
+
+        Image<TestType> expected = image::filter<3, 5>(img, kernel, BorderReflect());
+        Image<TestType> actual = image::filterSeparable<Kernel, float32>(img, BorderReflect());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
+    }
+
+    SECTION("one dimensional kernel")
+    {
+        using Kernel = SeparableKernel<KernelTaps<-1, 0, 1>, KernelTaps<1>>;
+        Eigen::Matrix<float32, 3, 1> kernel(-1, 0, 1);
+
+        Image<TestType> expected = image::filter<3, 1>(img, kernel, BorderRepeat());
+        Image<TestType> actual = image::filterSeparable<Kernel, float32>(img, BorderRepeat());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
+    }
+}
+
+TEMPLATE_TEST_CASE("image separable filter fixed point", "[core]", Gray, RGB)
+{
+    Image<TestType> img(5, 6);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c).setConstant((r * 37 + c * 91) % 256);
+
+    using Kernel = SeparableKernel<KernelTaps<1, 2, 1>, KernelTaps<1, 2, 1>>;
+    Eigen::Matrix<int16, 3, 3> kernel;
+    kernel << 1, 2, 1,
+              2, 4, 2,
+              1, 2, 1;
+
+    Image<TestType> expected = image::filterFixedPoint<3, 3, TestType>(img, kernel, 4, BorderReflect());
+    Image<TestType> actual = image::filterSeparableFixedPoint<Kernel, TestType>(img, 4, BorderReflect());
+
+    REQUIRE_IMAGE_APPROX(expected, actual, 0);
+}
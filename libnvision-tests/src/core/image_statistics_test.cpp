@@ -0,0 +1,102 @@
+/* image_statistics_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image.h"
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("image statistics", "[core]", Gray, RGB, BGRA, Grayf, RGBf, BGRAf)
+{
+    Image<TestType> img(3, 3);
+
+    img(0, 0).setConstant(44);
+    img(0, 1).setConstant(121);
+    img(0, 2).setConstant(14);
+
+    img(1, 0).setConstant(32);
+    img(1, 1).setConstant(158);
+    img(1, 2).setConstant(101);
+
+    img(2, 0).setConstant(219);
+    img(2, 1).setConstant(11);
+    img(2, 2).setConstant(82);
+
+    SECTION("without mask")
+    {
+        const auto stats = image::statistics(img);
+
+        REQUIRE(9 == stats.count());
+        for(Index i = 0; i < TestType::Dimension; ++i)
+        {
+            REQUIRE(Approx(11) == stats.minimum()[i]);
+            REQUIRE(Approx(219) == stats.maximum()[i]);
+            REQUIRE(Approx(782) == stats.sum()(i));
+            REQUIRE(Approx(107768) == stats.sumSq()(i));
+            REQUIRE(Approx(86.888889) == stats.mean()(i));
+            REQUIRE(Approx(4424.543210) == stats.variance()(i));
+            REQUIRE(Approx(66.517240) == stats.stddev()(i));
+        }
+
+        REQUIRE(0 == stats.histogram().rows());
+    }
+
+    SECTION("with mask")
+    {
+        Image<Gray> mask(3, 3);
+        mask.setConstant(Pixel<Gray>(0));
+        mask(0, 0).setConstant(1);
+        mask(1, 1).setConstant(1);
+        mask(2, 1).setConstant(1);
+
+        const auto stats = image::statistics(img, mask);
+
+        REQUIRE(3 == stats.count());
+        for(Index i = 0; i < TestType::Dimension; ++i)
+        {
+            REQUIRE(Approx(11) == stats.minimum()[i]);
+            REQUIRE(Approx(158) == stats.maximum()[i]);
+            REQUIRE(Approx(213) == stats.sum()(i));
+        }
+    }
+
+    SECTION("histogram")
+    {
+        const auto stats = image::statistics(img, 4);
+
+        REQUIRE(4 == stats.histogram().rows());
+        REQUIRE(TestType::Dimension == stats.histogram().cols());
+        REQUIRE(stats.count() == stats.histogram().col(0).sum());
+    }
+}
+
+TEST_CASE("image statistics histogram", "[core]")
+{
+    Image<Gray> img(2, 3);
+    img(0, 0).setConstant(0);   img(0, 1).setConstant(63);  img(0, 2).setConstant(64);
+    img(1, 0).setConstant(128); img(1, 1).setConstant(200); img(1, 2).setConstant(255);
+
+    const auto stats = image::statistics(img, 4);
+
+    REQUIRE(2 == stats.histogram()(0, 0));
+    REQUIRE(1 == stats.histogram()(1, 0));
+    REQUIRE(1 == stats.histogram()(2, 0));
+    REQUIRE(2 == stats.histogram()(3, 0));
+}
+
+TEMPLATE_TEST_CASE("image normalize", "[core]", Gray, Grayf)
+{
+    Image<TestType> img(2, 2);
+    img(0, 0).setConstant(TestType::maximum[0] / 4);
+    img(0, 1).setConstant(TestType::maximum[0] / 2);
+    img(1, 0).setConstant(TestType::maximum[0] / 4);
+    img(1, 1).setConstant(TestType::maximum[0] / 2);
+
+    Image<TestType> actual = image::normalize(img);
+
+    REQUIRE(Approx(TestType::minimum[0]) == actual(0, 0)[0]);
+    REQUIRE(Approx(TestType::maximum[0]) == actual(0, 1)[0]);
+}
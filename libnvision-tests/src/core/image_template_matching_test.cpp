@@ -0,0 +1,146 @@
+/* image_template_matching_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include <eigen_require.h>
+#include "nvision/src/core/image.h"
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("image template matching", "[core]", Gray, RGB, Grayf)
+{
+    using ValueType = typename TestType::ValueType;
+
+    Image<TestType> img(90, 110);
+    for(Index c = 0; c < img.cols(); ++c)
+    {
+        for(Index r = 0; r < img.rows(); ++r)
+        {
+            for(Index d = 0; d < img(r, c).size(); ++d)
+            {
+                const auto value = 128 + 40 * std::sin(0.21 * r + 0.5 * d) + 40 * std::cos(0.13 * c)
+                                 + 30 * std::sin(0.07 * r + 0.17 * c) + 20 * std::cos(0.31 * c - 0.11 * r);
+                img(r, c)[d] = static_cast<ValueType>(static_cast<int>(value));
+            }
+        }
+    }
+
+    const Index row = 31;
+    const Index col = 47;
+    Image<TestType> templ = img.block(row, col, 24, 20);
+
+    SECTION("zero-mean normalized cross-correlation")
+    {
+        const auto scores = image::matchTemplate(img, templ, MatchScore::ZNCC{});
+        REQUIRE(scores.rows() == 67);
+        REQUIRE(scores.cols() == 91);
+        REQUIRE(scores.maxCoeff() <= 1);
+        REQUIRE(scores.minCoeff() >= -1);
+        REQUIRE(Approx(scores(row, col)).margin(1e-4) == 1);
+
+        const auto matches = image::findMatches(scores, 3, 10, MatchScore::ZNCC{});
+        REQUIRE(matches.size() == 3);
+        REQUIRE(matches[0].row == row);
+        REQUIRE(matches[0].col == col);
+        for(size_t i = 1; i < matches.size(); ++i)
+        {
+            const auto dr = matches[i].row - row;
+            const auto dc = matches[i].col - col;
+            REQUIRE(dr * dr + dc * dc >= 100);
+            REQUIRE(matches[i].score <= matches[i - 1].score);
+        }
+    }
+
+    SECTION("zero-mean normalized cross-correlation is invariant to contrast")
+    {
+        Image<TestType> scaled = templ;
+        for(Index i = 0; i < scaled.size(); ++i)
+            for(Index d = 0; d < scaled(i).size(); ++d)
+                scaled(i)[d] = static_cast<ValueType>(scaled(i)[d] / 2 + 10);
+
+        const auto scores = image::matchTemplate(img, scaled, MatchScore::ZNCC{});
+        const auto matches = image::findMatches(scores, 1, 0, MatchScore::ZNCC{});
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].row == row);
+        REQUIRE(matches[0].col == col);
+        REQUIRE(Approx(matches[0].score).margin(1e-2) == 1);
+    }
+
+    SECTION("sum of squared differences")
+    {
+        const auto scores = image::matchTemplate(img, templ, MatchScore::SSD{});
+        REQUIRE(scores(row, col) == 0);
+
+        const auto matches = image::findMatches(scores, 1, 0, MatchScore::SSD{});
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].row == row);
+        REQUIRE(matches[0].col == col);
+    }
+
+    SECTION("sum of absolute differences")
+    {
+        const auto scores = image::matchTemplate(img, templ, MatchScore::SAD{});
+        REQUIRE(scores(row, col) == 0);
+
+        float32 expected = 0;
+        for(Index c = 0; c < templ.cols(); ++c)
+            for(Index r = 0; r < templ.rows(); ++r)
+                for(Index d = 0; d < templ(r, c).size(); ++d)
+                    expected += std::abs(static_cast<float32>(img(r + 2, c + 3)[d]) - static_cast<float32>(templ(r, c)[d]));
+        REQUIRE(Approx(scores(2, 3)).epsilon(1e-5) == expected);
+
+        const auto matches = image::findMatches(scores, 1, 0, MatchScore::SAD{});
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].row == row);
+        REQUIRE(matches[0].col == col);
+    }
+
+    SECTION("flat template")
+    {
+        Image<TestType> flat(5, 5);
+        flat.setConstant(Pixel<TestType>(100));
+
+        const auto scores = image::matchTemplate(img, flat, MatchScore::ZNCC{});
+        REQUIRE(scores.isZero());
+    }
+
+    SECTION("coarse-to-fine search")
+    {
+        const auto matcher = TemplateMatcher<float32>(3, 2, 10);
+        const auto matches = matcher(img, templ);
+
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0].row == row);
+        REQUIRE(matches[0].col == col);
+        REQUIRE(Approx(matches[0].score).margin(1e-4) == 1);
+    }
+
+    SECTION("coarse-to-fine search with small template")
+    {
+        const auto matcher = TemplateMatcher<float32, MatchScore::SSD>(4, 1, 10);
+        Image<TestType> small = img.block(row, col, 9, 9);
+        const auto matches = matcher(img, small);
+
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].row == row);
+        REQUIRE(matches[0].col == col);
+    }
+
+    SECTION("coarse-to-fine search at the image border")
+    {
+        // the match lies on the last valid position, which the upscaled
+        // coarse positions may exceed
+        auto matcher = TemplateMatcher<float32, MatchScore::SSD>(3, 1, 10);
+        matcher.setSearchRadius(1);
+        const Index lastRow = img.rows() - 23;
+        const Index lastCol = img.cols() - 21;
+        Image<TestType> corner = img.block(lastRow, lastCol, 23, 21);
+        const auto matches = matcher(img, corner);
+
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].row == lastRow);
+        REQUIRE(matches[0].col == lastCol);
+    }
+}
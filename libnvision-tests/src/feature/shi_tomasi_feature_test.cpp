@@ -6,10 +6,29 @@
 
 #include "eigen_require.h"
 #include "corner_generator.h"
+#include <Eigen/Eigenvalues>
 #include <nvision/src/feature/shi_tomasi_feature.h>
 
 using namespace nvision;
 
+TEMPLATE_TEST_CASE("shi tomasi score", "[feature]", nvision::float32, nvision::float64)
+{
+    using Scalar = TestType;
+    using Matrix2 = Eigen::Matrix<Scalar, 2, 2>;
+
+    Matrix2 M;
+    M << 4, 1,
+         1, 2;
+
+    ShiTomasiScore<Scalar> score;
+    const auto expected = M.eigenvalues().real().minCoeff();
+    REQUIRE(Approx(score(M)).epsilon(1e-6) == expected);
+
+    M << 3, 0,
+         0, 3;
+    REQUIRE(Approx(score(M)).epsilon(1e-6) == Scalar{3});
+}
+
 TEMPLATE_TEST_CASE("shi tomasi feature", "[feature]", nvision::float32, nvision::float64)
 {
     using Scalar = TestType;
@@ -0,0 +1,96 @@
+/* bilateral_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/bilateral_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("bilateral filter", "[filter]", Grayf, RGBf, BGRAf)
+{
+    using ValueType = typename TestType::ValueType;
+
+    // step edge with a small amount of texture
+    Image<TestType> img(40, 30);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<ValueType>((c < 15 ? 0.2 : 0.7) + 0.01 * ((r * 7 + c * 3 + d * 5) % 5) + 0.05 * d);
+
+    SECTION("constant image")
+    {
+        Image<TestType> constant(20, 20);
+        constant.setConstant(Pixel<TestType>(0.4));
+
+        BilateralFilter<float32> exact(2, 0.1f);
+        Image<TestType> actual = exact(constant);
+        REQUIRE_IMAGE_APPROX(constant, actual, 1e-5);
+
+        BilateralFilter<float32, BilateralMode::Grid> grid(2, 0.1f);
+        actual = grid(constant);
+        REQUIRE_IMAGE_APPROX(constant, actual, 1e-5);
+    }
+
+    SECTION("exact mode")
+    {
+        BilateralFilter<float32> filter(1.5f, 0.1f);
+        REQUIRE(filter.radius() == 3);
+
+        const auto handling = BorderRepeat{};
+        Image<TestType> expected(img.rows(), img.cols());
+        for(Index c = 0; c < img.cols(); ++c)
+        {
+            for(Index r = 0; r < img.rows(); ++r)
+            {
+                Eigen::Array<float64, TestType::Dimension, 1> sum = Eigen::Array<float64, TestType::Dimension, 1>::Zero();
+                float64 weights = 0;
+                for(Index j = -3; j <= 3; ++j)
+                {
+                    for(Index i = -3; i <= 3; ++i)
+                    {
+                        if(i * i + j * j > 9)
+                            continue;
+
+                        const auto &pixel = handling(img, r + i, c + j);
+                        float64 distance = 0;
+                        for(Index d = 0; d < TestType::Dimension; ++d)
+                            distance += std::pow(static_cast<float64>(pixel[d]) - static_cast<float64>(img(r, c)[d]), 2);
+
+                        const auto weight = std::exp(-(i * i + j * j) / (2 * 1.5 * 1.5)) * std::exp(-distance / (2 * 0.1 * 0.1));
+                        for(Index d = 0; d < TestType::Dimension; ++d)
+                            sum(d) += weight * static_cast<float64>(pixel[d]);
+                        weights += weight;
+                    }
+                }
+
+                for(Index d = 0; d < TestType::Dimension; ++d)
+                    expected(r, c)[d] = static_cast<ValueType>(sum(d) / weights);
+            }
+        }
+
+        Image<TestType> actual = filter(img, handling);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-4);
+    }
+
+    SECTION("grid mode")
+    {
+        BilateralFilter<float32> exact(3, 0.1f);
+        Image<TestType> expected = exact(img);
+
+        BilateralFilter<float32, BilateralMode::Grid> grid(3, 0.1f);
+        Image<TestType> actual = grid(img);
+
+        // the edge is preserved
+        for(Index r = 0; r < img.rows(); ++r)
+        {
+            REQUIRE(Approx(actual(r, 14)[0]).margin(0.02) == 0.22);
+            REQUIRE(Approx(actual(r, 15)[0]).margin(0.02) == 0.72);
+        }
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0.02);
+    }
+}
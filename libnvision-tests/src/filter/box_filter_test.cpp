@@ -30,6 +30,11 @@ TEMPLATE_TEST_CASE("box filter", "[filter]", Gray, RGB, BGR, RGBA, BGRA, Grayf,
         Image<TestType> actual = filter(img);
 
         REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+        BoxFilterX<float> dynamicFilter(1);
+        Image<TestType> dynamicActual = dynamicFilter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, dynamicActual, 1);
     }
 
 
@@ -46,5 +51,59 @@ TEMPLATE_TEST_CASE("box filter", "[filter]", Gray, RGB, BGR, RGBA, BGRA, Grayf,
         Image<TestType> actual = filter(img);
 
         REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+        BoxFilterX<float> dynamicFilter(2);
+        Image<TestType> dynamicActual = dynamicFilter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, dynamicActual, 1);
+    }
+}
+
+TEMPLATE_TEST_CASE("dynamic box filter", "[filter]", Gray, RGB, Grayf, RGBf)
+{
+    Image<TestType> img(12, 9);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c).setConstant((r * 37 + c * 91) % 256);
+
+    SECTION("border repeat")
+    {
+        BoxFilter<float, 7> filter;
+        Image<TestType> expected = filter(img, BorderRepeat());
+
+        BoxFilterX<float> dynamicFilter(3);
+        Image<TestType> actual = dynamicFilter(img, BorderRepeat());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("border constant")
+    {
+        BoxFilter<float, 7> filter;
+        Image<TestType> expected = filter(img, BorderConstant<TestType>());
+
+        BoxFilterX<float> dynamicFilter(3);
+        Image<TestType> actual = dynamicFilter(img, BorderConstant<TestType>());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1);
+    }
+
+    SECTION("iterations")
+    {
+        BoxFilter<float, 3> filter;
+        Image<TestType> expected = filter(filter(img).eval());
+
+        BoxFilterX<float> dynamicFilter(1, 2);
+        Image<TestType> actual = dynamicFilter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 2);
     }
 }
+
+TEST_CASE("dynamic box filter radius for sigma", "[filter]")
+{
+    REQUIRE(0 == BoxFilterX<float>::radiusForSigma(0, 3));
+    REQUIRE(1 == BoxFilterX<float>::radiusForSigma(1, 3));
+    REQUIRE(6 == BoxFilterX<float>::radiusForSigma(6, 3));
+    REQUIRE(10 == BoxFilterX<float>::radiusForSigma(6, 1));
+}
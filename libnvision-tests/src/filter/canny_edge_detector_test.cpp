@@ -0,0 +1,102 @@
+/* canny_edge_detector_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/canny_edge_detector.h>
+#include <nvision/src/filter/gauss_filter.h>
+#include <nvision/src/filter/sobel_filter.h>
+
+using namespace nvision;
+
+TEST_CASE("canny edge detector", "[filter]")
+{
+    // disc with a superimposed pattern of rectangles
+    Image<Grayf> img(70, 90);
+    for(Index c = 0; c < img.cols(); ++c)
+    {
+        for(Index r = 0; r < img.rows(); ++r)
+        {
+            const auto x = static_cast<float32>(c - 45);
+            const auto y = static_cast<float32>(r - 35);
+            const auto disc = x * x + y * y < 400 ? 0.6f : 0.1f;
+            const auto pattern = std::sin(0.3f * c) * std::cos(0.4f * r) > 0.3f ? 0.3f : 0.0f;
+            img(r, c)[0] = disc + pattern;
+        }
+    }
+
+    CannyEdgeDetector<float32> detector;
+
+    SECTION("matches the separate filter pipeline")
+    {
+        GaussFilter<float32, 7> smoothFilter(1);
+        SobelFilter<float32> gradientFilter;
+        CannyEdgeFilter<float32> edgeFilter;
+
+        Image<Grayf> smooth = smoothFilter(img);
+        Image<Grayf> expected = edgeFilter(gradientFilter(smooth, GradientMode::XY{}));
+
+        Image<Gray> actual = detector(img);
+
+        for(Index i = 0; i < img.size(); ++i)
+            REQUIRE((expected(i)[0] != 0) == (actual(i)[0] == 255));
+    }
+
+    SECTION("result does not depend on the band size")
+    {
+        detector.setBandRows(img.rows());
+        Image<Gray> expected = detector(img);
+
+        for(const Index bandRows : {1, 3, 7, 16})
+        {
+            detector.setBandRows(bandRows);
+            Image<Gray> actual = detector(img);
+
+            REQUIRE_IMAGE_APPROX(expected, actual, 0);
+        }
+    }
+
+    SECTION("edge list")
+    {
+        detector.setBandRows(8);
+        Image<Gray> expected = detector(img);
+
+        CannyEdgeDetector<float32>::EdgeList edges;
+        detector(img, edges);
+
+        Index count = 0;
+        for(Index i = 0; i < expected.size(); ++i)
+            count += expected(i)[0] != 0 ? 1 : 0;
+
+        REQUIRE(count > 0);
+        REQUIRE(edges.cols() == count);
+        for(Index i = 0; i < edges.cols(); ++i)
+            REQUIRE(expected(edges(1, i), edges(0, i))[0] == 255);
+
+        // column-major order
+        for(Index i = 1; i < edges.cols(); ++i)
+            REQUIRE(edges(0, i) * img.rows() + edges(1, i) > edges(0, i - 1) * img.rows() + edges(1, i - 1));
+    }
+
+    SECTION("multi-channel image")
+    {
+        Image<RGBf> rgb(img.rows(), img.cols());
+        for(Index i = 0; i < img.size(); ++i)
+            rgb(i) = Pixel<RGBf>(img(i)[0], img(i)[0] / 2, 0.0f);
+
+        Image<Gray> expected = detector(img);
+        Image<Gray> actual = detector(rgb);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+
+    SECTION("empty image")
+    {
+        Image<Grayf> empty;
+        Image<Gray> actual = detector(empty);
+
+        REQUIRE(actual.size() == 0);
+    }
+}
@@ -38,3 +38,79 @@ TEMPLATE_TEST_CASE("canny filter", "[filter]", Grayf, RGBf, BGRf, RGBAf, BGRAf)
         // REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
     }
 }
+
+TEMPLATE_TEST_CASE("canny filter hysteresis", "[filter]", Grayf, RGBf)
+{
+    Image<TestType> gradientX(7, 10);
+    Image<TestType> gradientY(7, 10);
+    gradientX.setConstant(Pixel<TestType>(0));
+    gradientY.setConstant(Pixel<TestType>(0));
+
+    // weak edge in row 2, which starts at a strong pixel
+    gradientY(2, 0).setConstant(0.5);
+    for(Index c = 1; c < 9; ++c)
+        gradientY(2, c).setConstant(0.2);
+
+    // weak edge in row 5 without strong pixels
+    for(Index c = 0; c < 9; ++c)
+        gradientY(5, c).setConstant(-0.2);
+
+    Image<TestType> expected(7, 10);
+    expected.setConstant(Pixel<TestType>(0));
+    for(Index c = 0; c < 9; ++c)
+        expected(2, c).setConstant(1);
+
+    CannyEdgeFilter<float32> edgeFilter;
+    Image<TestType> actual = edgeFilter(gradientX, gradientY);
+
+    REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+}
+
+TEMPLATE_TEST_CASE("canny filter non-maximum suppression", "[filter]", Grayf, RGBf)
+{
+    // sharp vertical step, whose gradient has the same magnitude in the
+    // two columns next to the step
+    Image<TestType> img(12, 12);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c).setConstant(c < 6 ? 0 : 1);
+
+    SobelFilter<float32> gradientFilter;
+    const auto gradient = gradientFilter(img, GradientMode::XY{});
+
+    Image<TestType> expected(12, 12);
+    expected.setConstant(Pixel<TestType>(0));
+    for(Index r = 0; r < img.rows(); ++r)
+        expected(r, 6).setConstant(1);
+
+    CannyEdgeFilter<float32> edgeFilter;
+    Image<TestType> actual = edgeFilter(gradient);
+
+    REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+
+    SECTION("diagonal step")
+    {
+        for(Index c = 0; c < img.cols(); ++c)
+            for(Index r = 0; r < img.rows(); ++r)
+                img(r, c).setConstant(r + c < 12 ? 0 : 1);
+
+        const auto diagonal = gradientFilter(img, GradientMode::XY{});
+        actual = edgeFilter(diagonal);
+
+        // the edge is a thin 4-connected staircase along the diagonal
+        for(Index r = 1; r < img.rows() - 1; ++r)
+        {
+            Index count = 0;
+            for(Index c = 1; c < img.cols() - 1; ++c)
+            {
+                if(actual(r, c)[0] != 0)
+                {
+                    ++count;
+                    REQUIRE(std::abs(r + c - 12) <= 1);
+                }
+            }
+            REQUIRE(count >= 1);
+            REQUIRE(count <= 2);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/* clahe_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/clahe_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("clahe filter", "[filter]", Gray, RGB)
+{
+    Image<TestType> img(32, 48);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c).setConstant(static_cast<uint8>(100 + (r + c) % 16));
+
+    SECTION("single tile without clipping maps by cumulative distribution")
+    {
+        CLAHEFilter<float32> filter(256, 1, 1);
+        Image<TestType> actual = filter(img);
+
+        // unlike global equalization CLAHE does not map the lowest value
+        // to zero, but scales the plain cumulative distribution
+        const auto hist = image::histogram(img);
+        Image<TestType> expected(img.rows(), img.cols());
+        for(Index i = 0; i < img.size(); ++i)
+        {
+            for(Index d = 0; d < img(i).size(); ++d)
+            {
+                const auto cdf = hist.col(d).head(img(i)[d] + 1).sum();
+                expected(i)[d] = static_cast<uint8>(std::round(255.0f * static_cast<float32>(cdf) / static_cast<float32>(img.size())));
+            }
+        }
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+
+    SECTION("increases contrast")
+    {
+        CLAHEFilter<float32> filter(4, 4, 4);
+        Image<TestType> actual = filter(img);
+
+        const auto before = image::statistics(img);
+        const auto after = image::statistics(actual);
+
+        REQUIRE(after.stddev()(0) > before.stddev()(0));
+    }
+
+    SECTION("constant image stays smooth")
+    {
+        img.setConstant(Pixel<TestType>(80));
+
+        CLAHEFilter<float32> filter(2, 4, 4);
+        Image<TestType> actual = filter(img);
+
+        for(Index i = 1; i < actual.size(); ++i)
+            REQUIRE(actual(i) == actual(0));
+    }
+}
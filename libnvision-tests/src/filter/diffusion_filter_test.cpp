@@ -32,3 +32,147 @@ TEMPLATE_TEST_CASE("diffusion filter", "[filter]", Grayf, RGBf, BGRf, RGBAf, BGR
         // REQUIRE_IMAGE_APPROX(expected, actual, 1);
     }
 }
+
+TEMPLATE_TEST_CASE("diffusion filter fused kernel", "[filter]", Grayf, RGBf)
+{
+    using ValueType = typename TestType::ValueType;
+
+    Image<TestType> img(53, 37);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<ValueType>((c < 18 ? 40 : 200) + (r * 37 + c * 91 + r * c * 7 + d * 53) % 31);
+
+    // reference with one image per intermediate term
+    const auto diffuse = [&img](const Index iterations, const float flowFactor, const auto &handling)
+    {
+        CentralDifferencesFilter<float> gradient;
+        GaussianPenalizer<float> penalizer;
+
+        Image<TestType> u = img;
+        for(Index i = 0; i < iterations; ++i)
+        {
+            auto grad = gradient(u, GradientMode::XY(), handling);
+            Image<TestType> ux = grad.x;
+            Image<TestType> uy = grad.y;
+            Image<TestType> g = (ux * ux + uy * uy).unaryExpr(penalizer);
+            Image<TestType> gux = g * ux;
+            Image<TestType> guy = g * uy;
+            Image<TestType> guxx = gradient(gux, GradientMode::X(), handling);
+            Image<TestType> guyy = gradient(guy, GradientMode::Y(), handling);
+            u += (guxx + guyy) * flowFactor;
+        }
+        return u;
+    };
+
+    DiffusionFilter<float> filter(7, 0.05f);
+    filter.setTileRows(8);
+
+    SECTION("reflect border")
+    {
+        Image<TestType> expected = diffuse(7, 0.05f, BorderReflect{});
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
+    }
+
+    SECTION("constant border")
+    {
+        const auto handling = BorderConstant<TestType>(Pixel<TestType>(100));
+        Image<TestType> expected = diffuse(7, 0.05f, handling);
+        Image<TestType> actual = filter(img, handling);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
+    }
+
+    SECTION("temporal tiling")
+    {
+        Image<TestType> expected = filter(img, BorderRepeat{});
+
+        for(Index iterations = 2; iterations <= 4; ++iterations)
+        {
+            for(Index rows : {3, 8, 64})
+            {
+                filter.setTileIterations(iterations);
+                filter.setTileRows(rows);
+                Image<TestType> actual = filter(img, BorderRepeat{});
+
+                REQUIRE_IMAGE_APPROX(expected, actual, 0);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("diffusion filter AOS scheme", "[filter]", Grayf, RGBf)
+{
+    using ValueType = typename TestType::ValueType;
+
+    Image<TestType> img(60, 50);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<ValueType>(std::sin(0.2 * r + d) * std::cos(0.15 * c) + d);
+
+    SECTION("constant image")
+    {
+        Image<TestType> constant(20, 20);
+        constant.setConstant(Pixel<TestType>(3));
+
+        DiffusionFilter<float> filter(3, 2.0f);
+        Image<TestType> actual = filter(constant, DiffusionScheme::AOS());
+
+        REQUIRE_IMAGE_APPROX(constant, actual, 1e-5);
+    }
+
+    SECTION("same diffusion time as explicit scheme")
+    {
+        DiffusionFilter<float> explicitFilter(40, 0.025f);
+        Image<TestType> expected = explicitFilter(img);
+
+        DiffusionFilter<float> aosFilter(4, 0.25f);
+        Image<TestType> actual = aosFilter(img, DiffusionScheme::AOS());
+
+        // the schemes treat the borders differently
+        const auto margin = 8;
+        const auto rows = img.rows() - 2 * margin;
+        const auto cols = img.cols() - 2 * margin;
+        Image<TestType> expectedInner = expected.block(margin, margin, rows, cols);
+        Image<TestType> actualInner = actual.block(margin, margin, rows, cols);
+        REQUIRE_IMAGE_APPROX(expectedInner, actualInner, 0.02);
+    }
+
+    SECTION("large flow factor")
+    {
+        DiffusionFilter<float, TotalVariationPenalizer<float>> filter(2, 50.0f);
+        Image<TestType> actual = filter(img, DiffusionScheme::AOS());
+
+        // the mean is preserved and no new extrema arise
+        for(Index d = 0; d < img(0, 0).size(); ++d)
+        {
+            float64 sumExpected = 0;
+            float64 sumActual = 0;
+            ValueType minimum = img(0, 0)[d];
+            ValueType maximum = img(0, 0)[d];
+            for(Index c = 0; c < img.cols(); ++c)
+            {
+                for(Index r = 0; r < img.rows(); ++r)
+                {
+                    sumExpected += img(r, c)[d];
+                    sumActual += actual(r, c)[d];
+                    minimum = std::min(minimum, img(r, c)[d]);
+                    maximum = std::max(maximum, img(r, c)[d]);
+                }
+            }
+
+            REQUIRE(Approx(sumActual).margin(1e-2) == sumExpected);
+            for(Index c = 0; c < img.cols(); ++c)
+            {
+                for(Index r = 0; r < img.rows(); ++r)
+                {
+                    REQUIRE(actual(r, c)[d] >= minimum - 1e-4f);
+                    REQUIRE(actual(r, c)[d] <= maximum + 1e-4f);
+                }
+            }
+        }
+    }
+}
@@ -30,6 +30,14 @@ TEMPLATE_TEST_CASE("gauss filter", "[filter]", Gray, RGB, BGR, RGBA, BGRA, Grayf
         Image<TestType> actual = filter(img);
 
         REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+        if constexpr (std::is_integral<typename TestType::ValueType>::value)
+        {
+            GaussFilter<int16, 3> fixedFilter;
+            Image<TestType> fixedActual = fixedFilter(img);
+
+            REQUIRE_IMAGE_APPROX(expected, fixedActual, 1);
+        }
     }
 
     SECTION("ksize = 5")
@@ -44,6 +52,14 @@ TEMPLATE_TEST_CASE("gauss filter", "[filter]", Gray, RGB, BGR, RGBA, BGRA, Grayf
         Image<TestType> actual = filter(img);
 
         REQUIRE_IMAGE_APPROX(expected, actual, 1);
+
+        if constexpr (std::is_integral<typename TestType::ValueType>::value)
+        {
+            GaussFilter<int16, 5> fixedFilter(2);
+            Image<TestType> fixedActual = fixedFilter(img);
+
+            REQUIRE_IMAGE_APPROX(expected, fixedActual, 1);
+        }
     }
 
 
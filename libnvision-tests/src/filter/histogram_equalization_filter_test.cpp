@@ -0,0 +1,39 @@
+/* histogram_equalization_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/histogram_equalization_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("histogram equalization filter", "[filter]", Gray, RGB, BGRA)
+{
+    Image<TestType> img(2, 2);
+    img(0, 0).setConstant(50); img(0, 1).setConstant(50);
+    img(1, 0).setConstant(60); img(1, 1).setConstant(70);
+
+    SECTION("spread values")
+    {
+        Image<TestType> expected(2, 2);
+        expected(0, 0).setConstant(0);   expected(0, 1).setConstant(0);
+        expected(1, 0).setConstant(128); expected(1, 1).setConstant(255);
+
+        HistogramEqualizationFilter filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+
+    SECTION("constant image")
+    {
+        img.setConstant(Pixel<TestType>(42));
+
+        HistogramEqualizationFilter filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(img, actual, 0);
+    }
+}
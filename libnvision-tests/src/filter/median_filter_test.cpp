@@ -0,0 +1,119 @@
+/* median_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/median_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("median filter", "[filter]", Gray, RGB, BGR, RGBA)
+{
+    Image<TestType> img(4, 4);
+    img(0, 0).setConstant(0);   img(0, 1).setConstant(255); img(0, 2).setConstant(125); img(0, 3).setConstant(255);
+    img(1, 0).setConstant(255); img(1, 1).setConstant(0);   img(1, 2).setConstant(0);   img(1, 3).setConstant(125);
+    img(2, 0).setConstant(255); img(2, 1).setConstant(255); img(2, 2).setConstant(255); img(2, 3).setConstant(0);
+    img(3, 0).setConstant(125); img(3, 1).setConstant(0);   img(3, 2).setConstant(255); img(3, 3).setConstant(125);
+
+    SECTION("ksize = 1")
+    {
+        MedianFilter filter(0);
+        REQUIRE(filter.size() == 1);
+
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(img, actual, 0);
+    }
+
+    SECTION("ksize = 3")
+    {
+        Image<TestType> expected(4, 4);
+
+        expected(0, 0).setConstant(0);   expected(0, 1).setConstant(0);   expected(0, 2).setConstant(125); expected(0, 3).setConstant(125);
+        expected(1, 0).setConstant(255); expected(1, 1).setConstant(255); expected(1, 2).setConstant(125); expected(1, 3).setConstant(125);
+        expected(2, 0).setConstant(125); expected(2, 1).setConstant(255); expected(2, 2).setConstant(125); expected(2, 3).setConstant(125);
+        expected(3, 0).setConstant(255); expected(3, 1).setConstant(255); expected(3, 2).setConstant(255); expected(3, 3).setConstant(255);
+
+        MedianFilter filter;
+        REQUIRE(filter.size() == 3);
+
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+}
+
+TEMPLATE_TEST_CASE("median filter runtime kernel size", "[filter]", Gray, RGB)
+{
+    // spans multiple bands of rows and lanes of the selection networks
+    Image<TestType> img(300, 41);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<uint8>((r * 37 + c * 91 + r * c * 7 + d * 53) % 256);
+
+    const auto median = [&img](const Index radius, const auto &handling)
+    {
+        Image<TestType> result(img.rows(), img.cols());
+        std::vector<uint8> values;
+        for(Index c = 0; c < img.cols(); ++c)
+        {
+            for(Index r = 0; r < img.rows(); ++r)
+            {
+                for(Index d = 0; d < result(r, c).size(); ++d)
+                {
+                    values.clear();
+                    for(Index j = -radius; j <= radius; ++j)
+                        for(Index i = -radius; i <= radius; ++i)
+                            values.push_back(handling(img, r + i, c + j)[d]);
+
+                    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+                    result(r, c)[d] = values[values.size() / 2];
+                }
+            }
+        }
+        return result;
+    };
+
+    for(const Index radius : {1, 2, 3, 4, 12})
+    {
+        MedianFilter filter(radius);
+
+        SECTION("reflect border, radius = " + std::to_string(radius))
+        {
+            Image<TestType> expected = median(radius, BorderReflect{});
+            Image<TestType> actual = filter(img);
+
+            REQUIRE_IMAGE_APPROX(expected, actual, 0);
+        }
+
+        SECTION("constant border, radius = " + std::to_string(radius))
+        {
+            const auto handling = BorderConstant<TestType>(Pixel<TestType>(200));
+            Image<TestType> expected = median(radius, handling);
+            Image<TestType> actual = filter(img, handling);
+
+            REQUIRE_IMAGE_APPROX(expected, actual, 0);
+        }
+    }
+}
+
+TEST_CASE("median filter removes salt and pepper noise", "[filter]")
+{
+    Image<Gray> img(40, 40);
+    img.setConstant(Pixel<Gray>(100));
+    img(5, 7).setConstant(255);
+    img(20, 20).setConstant(0);
+    img(21, 20).setConstant(255);
+    img(39, 0).setConstant(0);
+
+    MedianFilter filter(3);
+    Image<Gray> actual = filter(img);
+
+    Image<Gray> expected(40, 40);
+    expected.setConstant(Pixel<Gray>(100));
+
+    REQUIRE_IMAGE_APPROX(expected, actual, 0);
+}
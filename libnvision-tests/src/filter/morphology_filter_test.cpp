@@ -0,0 +1,241 @@
+/* morphology_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/morphology_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("morphology filter", "[filter]", Gray, RGB, Grayf, RGBf)
+{
+    Image<TestType> img(4, 5);
+    img(0, 0).setConstant(10);  img(0, 1).setConstant(200); img(0, 2).setConstant(30);  img(0, 3).setConstant(40);  img(0, 4).setConstant(90);
+    img(1, 0).setConstant(60);  img(1, 1).setConstant(5);   img(1, 2).setConstant(120); img(1, 3).setConstant(250); img(1, 4).setConstant(15);
+    img(2, 0).setConstant(70);  img(2, 1).setConstant(80);  img(2, 2).setConstant(35);  img(2, 3).setConstant(100); img(2, 4).setConstant(110);
+    img(3, 0).setConstant(130); img(3, 1).setConstant(20);  img(3, 2).setConstant(140); img(3, 3).setConstant(60);  img(3, 4).setConstant(160);
+
+    Image<TestType> expected(4, 5);
+
+    SECTION("erosion")
+    {
+        expected(0, 0).setConstant(5);  expected(0, 1).setConstant(5);  expected(0, 2).setConstant(5);  expected(0, 3).setConstant(15); expected(0, 4).setConstant(15);
+        expected(1, 0).setConstant(5);  expected(1, 1).setConstant(5);  expected(1, 2).setConstant(5);  expected(1, 3).setConstant(15); expected(1, 4).setConstant(15);
+        expected(2, 0).setConstant(5);  expected(2, 1).setConstant(5);  expected(2, 2).setConstant(5);  expected(2, 3).setConstant(15); expected(2, 4).setConstant(15);
+        expected(3, 0).setConstant(20); expected(3, 1).setConstant(20); expected(3, 2).setConstant(20); expected(3, 3).setConstant(35); expected(3, 4).setConstant(60);
+
+        ErosionFilter<> filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("cross-shaped erosion")
+    {
+        expected(0, 0).setConstant(10); expected(0, 1).setConstant(5);  expected(0, 2).setConstant(30); expected(0, 3).setConstant(30); expected(0, 4).setConstant(15);
+        expected(1, 0).setConstant(5);  expected(1, 1).setConstant(5);  expected(1, 2).setConstant(5);  expected(1, 3).setConstant(15); expected(1, 4).setConstant(15);
+        expected(2, 0).setConstant(60); expected(2, 1).setConstant(5);  expected(2, 2).setConstant(35); expected(2, 3).setConstant(35); expected(2, 4).setConstant(15);
+        expected(3, 0).setConstant(20); expected(3, 1).setConstant(20); expected(3, 2).setConstant(20); expected(3, 3).setConstant(60); expected(3, 4).setConstant(60);
+
+        ErosionFilter<MorphologyShape::Cross> filter(3);
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("dilation")
+    {
+        expected(0, 0).setConstant(200); expected(0, 1).setConstant(200); expected(0, 2).setConstant(250); expected(0, 3).setConstant(250); expected(0, 4).setConstant(250);
+        expected(1, 0).setConstant(200); expected(1, 1).setConstant(200); expected(1, 2).setConstant(250); expected(1, 3).setConstant(250); expected(1, 4).setConstant(250);
+        expected(2, 0).setConstant(130); expected(2, 1).setConstant(140); expected(2, 2).setConstant(250); expected(2, 3).setConstant(250); expected(2, 4).setConstant(250);
+        expected(3, 0).setConstant(130); expected(3, 1).setConstant(140); expected(3, 2).setConstant(140); expected(3, 3).setConstant(160); expected(3, 4).setConstant(160);
+
+        DilationFilter<> filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("opening")
+    {
+        expected(0, 0).setConstant(5);  expected(0, 1).setConstant(5);  expected(0, 2).setConstant(15); expected(0, 3).setConstant(15); expected(0, 4).setConstant(15);
+        expected(1, 0).setConstant(5);  expected(1, 1).setConstant(5);  expected(1, 2).setConstant(15); expected(1, 3).setConstant(15); expected(1, 4).setConstant(15);
+        expected(2, 0).setConstant(20); expected(2, 1).setConstant(20); expected(2, 2).setConstant(35); expected(2, 3).setConstant(60); expected(2, 4).setConstant(60);
+        expected(3, 0).setConstant(20); expected(3, 1).setConstant(20); expected(3, 2).setConstant(35); expected(3, 3).setConstant(60); expected(3, 4).setConstant(60);
+
+        OpeningFilter<> filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("closing")
+    {
+        expected(0, 0).setConstant(200); expected(0, 1).setConstant(200); expected(0, 2).setConstant(200); expected(0, 3).setConstant(250); expected(0, 4).setConstant(250);
+        expected(1, 0).setConstant(130); expected(1, 1).setConstant(130); expected(1, 2).setConstant(140); expected(1, 3).setConstant(250); expected(1, 4).setConstant(250);
+        expected(2, 0).setConstant(130); expected(2, 1).setConstant(130); expected(2, 2).setConstant(140); expected(2, 3).setConstant(140); expected(2, 4).setConstant(160);
+        expected(3, 0).setConstant(130); expected(3, 1).setConstant(130); expected(3, 2).setConstant(140); expected(3, 3).setConstant(140); expected(3, 4).setConstant(160);
+
+        ClosingFilter<> filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("morphological gradient")
+    {
+        expected(0, 0).setConstant(195); expected(0, 1).setConstant(195); expected(0, 2).setConstant(245); expected(0, 3).setConstant(235); expected(0, 4).setConstant(235);
+        expected(1, 0).setConstant(195); expected(1, 1).setConstant(195); expected(1, 2).setConstant(245); expected(1, 3).setConstant(235); expected(1, 4).setConstant(235);
+        expected(2, 0).setConstant(125); expected(2, 1).setConstant(135); expected(2, 2).setConstant(245); expected(2, 3).setConstant(235); expected(2, 4).setConstant(235);
+        expected(3, 0).setConstant(110); expected(3, 1).setConstant(120); expected(3, 2).setConstant(120); expected(3, 3).setConstant(125); expected(3, 4).setConstant(100);
+
+        MorphologicalGradientFilter<> filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("top-hat")
+    {
+        expected(0, 0).setConstant(5);   expected(0, 1).setConstant(195); expected(0, 2).setConstant(15);  expected(0, 3).setConstant(25);  expected(0, 4).setConstant(75);
+        expected(1, 0).setConstant(55);  expected(1, 1).setConstant(0);   expected(1, 2).setConstant(105); expected(1, 3).setConstant(235); expected(1, 4).setConstant(0);
+        expected(2, 0).setConstant(50);  expected(2, 1).setConstant(60);  expected(2, 2).setConstant(0);   expected(2, 3).setConstant(40);  expected(2, 4).setConstant(50);
+        expected(3, 0).setConstant(110); expected(3, 1).setConstant(0);   expected(3, 2).setConstant(105); expected(3, 3).setConstant(0);   expected(3, 4).setConstant(100);
+
+        TopHatFilter<> filter;
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+}
+
+TEMPLATE_TEST_CASE("morphology filter large element", "[filter]", Gray, RGBf)
+{
+    using ValueType = typename TestType::ValueType;
+
+    Image<TestType> img(37, 29);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            for(Index d = 0; d < img(r, c).size(); ++d)
+                img(r, c)[d] = static_cast<ValueType>((r * 37 + c * 91 + d * 53) % 251);
+
+    // brute force erosion over the whole neighbourhood
+    const auto erode = [&img](const Index rows, const Index cols, const bool cross, const auto &handling)
+    {
+        Image<TestType> result(img.rows(), img.cols());
+        for(Index c = 0; c < img.cols(); ++c)
+        {
+            for(Index r = 0; r < img.rows(); ++r)
+            {
+                result(r, c) = handling(img, r, c);
+                for(Index j = -cols / 2; j <= cols / 2; ++j)
+                    for(Index i = -rows / 2; i <= rows / 2; ++i)
+                        if(!cross || i == 0 || j == 0)
+                            for(Index d = 0; d < result(r, c).size(); ++d)
+                                result(r, c)[d] = std::min(result(r, c)[d], handling(img, r + i, c + j)[d]);
+            }
+        }
+        return result;
+    };
+
+    SECTION("rectangle")
+    {
+        ErosionFilter<> filter(9, 5);
+        REQUIRE(filter.rows() == 9);
+        REQUIRE(filter.cols() == 5);
+
+        Image<TestType> expected = erode(9, 5, false, BorderRepeat{});
+        Image<TestType> actual = filter(img, BorderRepeat{});
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("cross")
+    {
+        ErosionFilter<MorphologyShape::Cross> filter(7, 11);
+        const auto handling = BorderConstant<TestType>(Pixel<TestType>(3));
+
+        Image<TestType> expected = erode(7, 11, true, handling);
+        Image<TestType> actual = filter(img, handling);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+}
+
+TEMPLATE_TEST_CASE("morphology filter binary", "[filter]", Gray, Grayf)
+{
+    using ValueType = typename TestType::ValueType;
+    const auto maximum = TestType::maximum[0];
+
+    // spans multiple words of 64 rows
+    Image<TestType> img(150, 40);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c)[0] = (r * 7 + c * 13) % 11 < 8 ? maximum : ValueType{0};
+    img.block(60, 10, 20, 15).setConstant(Pixel<TestType>(maximum));
+
+    SECTION("erosion")
+    {
+        ErosionFilter<> filter(5, 3);
+        Image<TestType> expected = filter(img);
+
+        filter.setBinary(true);
+        REQUIRE(filter.binary());
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("cross-shaped dilation")
+    {
+        DilationFilter<MorphologyShape::Cross> filter(3, 7);
+        Image<TestType> expected = filter(img, BorderConstant<TestType>());
+
+        filter.setBinary(true);
+        Image<TestType> actual = filter(img, BorderConstant<TestType>());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("elements spanning multiple words")
+    {
+        Image<TestType> blocks(img.rows(), img.cols());
+        for(Index c = 0; c < blocks.cols(); ++c)
+            for(Index r = 0; r < blocks.rows(); ++r)
+                blocks(r, c)[0] = (r / 37 + c / 5) % 3 != 0 || (r * 7 + c * 13) % 29 == 0 ? maximum : ValueType{0};
+
+        for(const Index size : {1, 63, 65, 91})
+        {
+            ErosionFilter<> erosion(size, 3);
+            DilationFilter<> dilation(size, 3);
+            Image<TestType> expectedErosion = erosion(blocks);
+            Image<TestType> expectedDilation = dilation(blocks);
+
+            erosion.setBinary(true);
+            dilation.setBinary(true);
+            Image<TestType> actualErosion = erosion(blocks);
+            Image<TestType> actualDilation = dilation(blocks);
+
+            REQUIRE_IMAGE_APPROX(expectedErosion, actualErosion, 1e-6);
+            REQUIRE_IMAGE_APPROX(expectedDilation, actualDilation, 1e-6);
+        }
+    }
+
+    SECTION("non-zero values are foreground")
+    {
+        Image<TestType> scaled = img;
+        for(Index i = 0; i < scaled.size(); ++i)
+            if(scaled(i)[0] != ValueType{0})
+                scaled(i)[0] = maximum / 2;
+
+        TopHatFilter<> filter(5);
+        Image<TestType> expected = filter(img);
+
+        filter.setBinary(true);
+        Image<TestType> actual = filter(scaled);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 1e-6);
+    }
+}
@@ -0,0 +1,48 @@
+/* recursive_gauss_filter_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/filter/gauss_filter.h>
+#include <nvision/src/filter/recursive_gauss_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("recursive gauss filter", "[filter]", Gray, RGB, BGRA, Grayf, RGBf, BGRAf)
+{
+    Image<TestType> img(40, 30);
+    for(Index c = 0; c < img.cols(); ++c)
+        for(Index r = 0; r < img.rows(); ++r)
+            img(r, c).setConstant((r * 37 + c * 91) % 256);
+
+    GaussFilter<float, 25> gaussFilter(4);
+    RecursiveGaussFilter<float> filter(4);
+
+    SECTION("border reflect")
+    {
+        Image<TestType> expected = gaussFilter(img);
+        Image<TestType> actual = filter(img);
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 2);
+    }
+
+    SECTION("border repeat")
+    {
+        Image<TestType> expected = gaussFilter(img, BorderRepeat());
+        Image<TestType> actual = filter(img, BorderRepeat());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 2);
+    }
+
+    SECTION("constant image")
+    {
+        Image<TestType> constant(10, 10);
+        constant.setConstant(Pixel<TestType>(100));
+
+        Image<TestType> actual = filter(constant, BorderConstant<TestType>(Pixel<TestType>(100)));
+
+        REQUIRE_IMAGE_APPROX(constant, actual, 1e-3);
+    }
+}
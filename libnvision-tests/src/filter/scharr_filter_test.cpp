@@ -46,3 +46,44 @@ TEMPLATE_TEST_CASE("scharr filter", "[filter]", Grayf, RGBf, BGRf, RGBAf, BGRAf)
         REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
     }
 }
+
+TEMPLATE_TEST_CASE("scharr filter fixed point", "[filter]", Gray, RGB)
+{
+    using OutputColorSpace = typename GetSignedColorSpace<TestType>::type;
+
+    Image<TestType> img(4, 4);
+    img(0, 0).setConstant(0);   img(0, 1).setConstant(255); img(0, 2).setConstant(125); img(0, 3).setConstant(255);
+    img(1, 0).setConstant(255); img(1, 1).setConstant(0);   img(1, 2).setConstant(0);   img(1, 3).setConstant(125);
+    img(2, 0).setConstant(255); img(2, 1).setConstant(255); img(2, 2).setConstant(255); img(2, 3).setConstant(0);
+    img(3, 0).setConstant(125); img(3, 1).setConstant(0);   img(3, 2).setConstant(255); img(3, 3).setConstant(125);
+
+    SECTION("x-derivative")
+    {
+        // the fixed point gradients are divided by two
+        Image<OutputColorSpace> expected(4, 4);
+        expected(0, 0).setConstant(0); expected(0, 1).setConstant(-1860);  expected(0, 2).setConstant(5875);   expected(0, 3).setConstant(0);
+        expected(1, 0).setConstant(0); expected(1, 1).setConstant(-17717); expected(1, 2).setConstant(4133);   expected(1, 3).setConstant(0);
+        expected(2, 0).setConstant(0); expected(2, 1).setConstant(-2937);  expected(2, 2).setConstant(-14780); expected(2, 3).setConstant(0);
+        expected(3, 0).setConstant(0); expected(3, 1).setConstant(10530);  expected(3, 2).setConstant(-1860);  expected(3, 3).setConstant(0);
+
+        ScharrFilter<int16> filter;
+        Image<OutputColorSpace> actual = filter(img, GradientMode::X());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+
+    SECTION("y-derivative")
+    {
+        // the fixed point gradients are divided by two
+        Image<OutputColorSpace> expected(4, 4);
+        expected(0, 0).setConstant(0);      expected(0, 1).setConstant(0);    expected(0, 2).setConstant(0);     expected(0, 3).setConstant(0);
+        expected(1, 0).setConstant(20655);  expected(1, 1).setConstant(9048); expected(1, 2).setConstant(4538);  expected(1, 3).setConstant(-14545);
+        expected(2, 0).setConstant(-10530); expected(2, 1).setConstant(2938); expected(2, 2).setConstant(20655); expected(2, 3).setConstant(11985);
+        expected(3, 0).setConstant(0);      expected(3, 1).setConstant(0);    expected(3, 2).setConstant(0);     expected(3, 3).setConstant(0);
+
+        ScharrFilter<int16> filter;
+        Image<OutputColorSpace> actual = filter(img, GradientMode::Y());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+}
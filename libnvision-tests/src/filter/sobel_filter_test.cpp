@@ -45,4 +45,81 @@ TEMPLATE_TEST_CASE("sobel filter", "[filter]", Grayf, RGBf, BGRf, RGBAf, BGRAf)
 
         REQUIRE_IMAGE_APPROX(expected, actual, 1e-3);
     }
+
+    SECTION("xy-derivative")
+    {
+        SobelFilter<float> filter;
+        Image<TestType> expectedX = filter(img, GradientMode::X());
+        Image<TestType> expectedY = filter(img, GradientMode::Y());
+
+        ImageGradient<TestType> actual = filter(img, GradientMode::XY());
+
+        REQUIRE_IMAGE_APPROX(expectedX, actual.x, 1e-3);
+        REQUIRE_IMAGE_APPROX(expectedY, actual.y, 1e-3);
+    }
+
+    SECTION("magnitude and direction")
+    {
+        SobelFilter<float> filter;
+        ImageGradient<TestType> gradient = filter(img, GradientMode::XY());
+
+        Image<TestType> magnitude = image::magnitude(gradient);
+        Image<TestType> direction = image::direction(gradient);
+
+        REQUIRE(Approx(510) == magnitude(1, 0)[0]);
+        REQUIRE(Approx(std::sqrt(385.0 * 385.0 * 2)) == magnitude(1, 1)[0]);
+        REQUIRE(Approx(pi<float>() / 2).margin(1e-4) == direction(1, 0)[0]);
+        REQUIRE(Approx(3 * pi<float>() / 4).margin(1e-4) == direction(1, 1)[0]);
+    }
+}
+
+TEMPLATE_TEST_CASE("sobel filter fixed point", "[filter]", Gray, RGB)
+{
+    using OutputColorSpace = typename GetSignedColorSpace<TestType>::type;
+
+    Image<TestType> img(4, 4);
+    img(0, 0).setConstant(0);   img(0, 1).setConstant(255); img(0, 2).setConstant(125); img(0, 3).setConstant(255);
+    img(1, 0).setConstant(255); img(1, 1).setConstant(0);   img(1, 2).setConstant(0);   img(1, 3).setConstant(125);
+    img(2, 0).setConstant(255); img(2, 1).setConstant(255); img(2, 2).setConstant(255); img(2, 3).setConstant(0);
+    img(3, 0).setConstant(125); img(3, 1).setConstant(0);   img(3, 2).setConstant(255); img(3, 3).setConstant(125);
+
+    SECTION("x-derivative")
+    {
+        Image<OutputColorSpace> expected(4, 4);
+        expected(0, 0).setConstant(0); expected(0, 1).setConstant(-260);  expected(0, 2).setConstant(250); expected(0, 3).setConstant(0);
+        expected(1, 0).setConstant(0); expected(1, 1).setConstant(-385);  expected(1, 2).setConstant(-5);    expected(1, 3).setConstant(0);
+        expected(2, 0).setConstant(0); expected(2, 1).setConstant(-125);  expected(2, 2).setConstant(-260);  expected(2, 3).setConstant(0);
+        expected(3, 0).setConstant(0); expected(3, 1).setConstant(260); expected(3, 2).setConstant(-260);  expected(3, 3).setConstant(0);
+
+        SobelFilter<int16> filter;
+        Image<OutputColorSpace> actual = filter(img, GradientMode::X());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+
+    SECTION("y-derivative")
+    {
+        Image<OutputColorSpace> expected(4, 4);
+        expected(0, 0).setConstant(0);    expected(0, 1).setConstant(0);   expected(0, 2).setConstant(0);   expected(0, 3).setConstant(0);
+        expected(1, 0).setConstant(510);  expected(1, 1).setConstant(385); expected(1, 2).setConstant(5);   expected(1, 3).setConstant(-250);
+        expected(2, 0).setConstant(-260); expected(2, 1).setConstant(125); expected(2, 2).setConstant(510); expected(2, 3).setConstant(510);
+        expected(3, 0).setConstant(0);    expected(3, 1).setConstant(0);   expected(3, 2).setConstant(0);   expected(3, 3).setConstant(0);
+
+        SobelFilter<int16> filter;
+        Image<OutputColorSpace> actual = filter(img, GradientMode::Y());
+
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+
+    SECTION("xy-derivative")
+    {
+        SobelFilter<int16> filter;
+        Image<OutputColorSpace> expectedX = filter(img, GradientMode::X());
+        Image<OutputColorSpace> expectedY = filter(img, GradientMode::Y());
+
+        ImageGradient<OutputColorSpace> actual = filter(img, GradientMode::XY());
+
+        REQUIRE_IMAGE_APPROX(expectedX, actual.x, 0);
+        REQUIRE_IMAGE_APPROX(expectedY, actual.y, 0);
+    }
 }
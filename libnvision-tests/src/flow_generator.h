@@ -0,0 +1,93 @@
+#ifndef NVISION_TEST_FLOW_GENERATOR_H_
+#define NVISION_TEST_FLOW_GENERATOR_H_
+
+#include <catch2/catch.hpp>
+#include <nvision/src/core/image.h>
+#include <nvision/src/optflow/flow_field.h>
+
+namespace nvision::test
+{
+    /** Smooth intensity pattern in [0.15, 0.85], which has gradients in
+      * all directions and no periodicity within the test images. */
+    inline float32 flowPattern(const float32 row, const float32 col)
+    {
+        return 0.5f + 0.2f * std::sin(0.3f * col) * std::cos(0.25f * row) + 0.15f * std::sin(0.11f * col + 0.17f * row);
+    }
+
+    /** Returns the pattern at the given position, each channel is offset
+      * by 0.1 times its index. */
+    template<typename ColorSpace>
+    inline Pixel<ColorSpace> flowPatternPixel(const float32 row, const float32 col)
+    {
+        using ValueType = typename ColorSpace::ValueType;
+
+        Pixel<ColorSpace> pixel;
+        for(Index d = 0; d < ColorSpace::Dimension; ++d)
+            pixel[d] = static_cast<ValueType>(flowPattern(row, col) + 0.1f * static_cast<float32>(d));
+        return pixel;
+    }
+
+    /** Generates an image pair of the given size, whose content moves by
+      * the given shift from the first to the second image. */
+    template<typename ColorSpace>
+    inline void generateFlowImages(const Index rows,
+        const Index cols,
+        const float32 shiftX,
+        const float32 shiftY,
+        Image<ColorSpace> &imgA,
+        Image<ColorSpace> &imgB)
+    {
+        imgA.resize(rows, cols);
+        imgB.resize(rows, cols);
+        for(Index c = 0; c < cols; ++c)
+        {
+            for(Index r = 0; r < rows; ++r)
+            {
+                imgA(r, c) = flowPatternPixel<ColorSpace>(r, c);
+                imgB(r, c) = flowPatternPixel<ColorSpace>(r - shiftY, c - shiftX);
+            }
+        }
+    }
+
+    /** Requires the flow of all pixels, which are at least margin pixels
+      * away from the border, to match the given shift. Pixels close to the
+      * border move out of the image. */
+    inline void requireFlow(const FlowField<float32> &flow,
+        const float32 shiftX,
+        const float32 shiftY,
+        const float32 eps,
+        const Index margin = 10)
+    {
+        for(Index c = margin; c < flow.cols() - margin; ++c)
+        {
+            for(Index r = margin; r < flow.rows() - margin; ++r)
+            {
+                REQUIRE(Approx(flow(r, c)(0)).margin(eps) == shiftX);
+                REQUIRE(Approx(flow(r, c)(1)).margin(eps) == shiftY);
+            }
+        }
+    }
+
+    /** Returns the mean endpoint error of all pixels, which are at least
+      * margin pixels away from the border, with respect to the given shift. */
+    inline float32 meanFlowError(const FlowField<float32> &flow,
+        const float32 shiftX,
+        const float32 shiftY,
+        const Index margin = 10)
+    {
+        float32 error = 0;
+        Index count = 0;
+        for(Index c = margin; c < flow.cols() - margin; ++c)
+        {
+            for(Index r = margin; r < flow.rows() - margin; ++r)
+            {
+                error += (flow(r, c) - FlowVector<float32>(shiftX, shiftY)).norm();
+                ++count;
+            }
+        }
+
+        return error / static_cast<float32>(count);
+    }
+}
+
+#endif
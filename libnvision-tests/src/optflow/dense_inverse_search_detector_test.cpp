@@ -0,0 +1,88 @@
+/* dense_inverse_search_detector_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include "flow_generator.h"
+#include <nvision/src/optflow/dense_inverse_search_detector.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("dense inverse search detector", "[optflow]", Grayf, RGBf)
+{
+    const float32 shiftX = 3.0f;
+    const float32 shiftY = 1.8f;
+
+    Image<TestType> imgA;
+    Image<TestType> imgB;
+    test::generateFlowImages(80, 100, shiftX, shiftY, imgA, imgB);
+
+    const auto requireFlow = [&](const FlowField<float32> &flow, const float32 eps)
+    {
+        REQUIRE(flow.rows() == imgA.rows());
+        REQUIRE(flow.cols() == imgA.cols());
+        test::requireFlow(flow, shiftX, shiftY, eps);
+    };
+
+    // patches at the border cause single outliers without refinement
+    const auto requireMeanError = [&](const FlowField<float32> &flow, const float32 eps)
+    {
+        REQUIRE(flow.rows() == imgA.rows());
+        REQUIRE(flow.cols() == imgA.cols());
+        REQUIRE(test::meanFlowError(flow, shiftX, shiftY) < eps);
+    };
+
+    SECTION("without refinement")
+    {
+        DenseInverseSearchDetector<float32> detector;
+        detector.setRefinementEnabled(false);
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireMeanError(flow, 0.05f);
+    }
+
+    SECTION("with refinement")
+    {
+        DenseInverseSearchDetector<float32> detector;
+        REQUIRE(detector.refinementEnabled());
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireFlow(flow, 0.1f);
+    }
+
+    SECTION("coarse finest level")
+    {
+        DenseInverseSearchDetector<float32> detector;
+        detector.setFinestLevel(1);
+        REQUIRE(detector.finestLevel() == 1);
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireMeanError(flow, 0.1f);
+    }
+
+    SECTION("planar flow field")
+    {
+        DenseInverseSearchDetector<float32> detector;
+
+        FlowField<float32> expected;
+        detector(imgA, imgB, expected);
+
+        PlanarFlowField<float32> actual;
+        detector(imgA, imgB, actual);
+
+        REQUIRE(actual.rows() == expected.rows());
+        REQUIRE(actual.cols() == expected.cols());
+        const FlowPlane<float32> expectedU = flowU(expected);
+        const FlowPlane<float32> expectedV = flowV(expected);
+        REQUIRE_MATRIX_APPROX(expectedU, actual.u(), 1e-6f);
+        REQUIRE_MATRIX_APPROX(expectedV, actual.v(), 1e-6f);
+    }
+}
@@ -0,0 +1,89 @@
+/* flow_field_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/optflow/flow_field.h>
+#include <nvision/src/optflow/flow_image.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("planar flow field", "[optflow]", float32, float64)
+{
+    using Scalar = TestType;
+
+    FlowField<Scalar> flow(4, 5);
+    for(Index c = 0; c < flow.cols(); ++c)
+        for(Index r = 0; r < flow.rows(); ++r)
+            flow(r, c) << static_cast<Scalar>(r - c), static_cast<Scalar>(2 * r + c) / 3;
+
+    SECTION("conversion")
+    {
+        const PlanarFlowField<Scalar> planar(flow);
+        REQUIRE(planar.rows() == flow.rows());
+        REQUIRE(planar.cols() == flow.cols());
+        for(Index c = 0; c < flow.cols(); ++c)
+        {
+            for(Index r = 0; r < flow.rows(); ++r)
+            {
+                REQUIRE(planar.u()(r, c) == flow(r, c)(0));
+                REQUIRE(planar.v()(r, c) == flow(r, c)(1));
+                REQUIRE(planar(r, c) == flow(r, c));
+            }
+        }
+
+        const FlowField<Scalar> actual = planar.toFlowField();
+        for(Index i = 0; i < flow.size(); ++i)
+            REQUIRE(actual(i) == flow(i));
+    }
+
+    SECTION("move construction")
+    {
+        const PlanarFlowField<Scalar> expected(flow);
+        FlowPlane<Scalar> u = expected.u();
+        FlowPlane<Scalar> v = expected.v();
+        const Scalar *dataU = u.data();
+        const Scalar *dataV = v.data();
+
+        PlanarFlowField<Scalar> planar(std::move(u), std::move(v));
+        REQUIRE(planar.u().data() == dataU);
+        REQUIRE(planar.v().data() == dataV);
+        REQUIRE_MATRIX_APPROX(expected.u(), planar.u(), 0);
+        REQUIRE_MATRIX_APPROX(expected.v(), planar.v(), 0);
+    }
+
+    SECTION("views")
+    {
+        const PlanarFlowField<Scalar> planar(flow);
+        const FlowField<Scalar> actual = planar.view();
+        for(Index i = 0; i < flow.size(); ++i)
+            REQUIRE(actual(i) == flow(i));
+
+        // component views write through to the interleaved field
+        flowU(flow) *= 2;
+        flowV(flow).setConstant(1);
+        for(Index i = 0; i < flow.size(); ++i)
+        {
+            REQUIRE(flow(i)(0) == 2 * planar.u()(i));
+            REQUIRE(flow(i)(1) == Scalar{1});
+        }
+    }
+
+    SECTION("magnitude")
+    {
+        const PlanarFlowField<Scalar> planar(flow);
+        const auto magnitude = planar.magnitude();
+        for(Index i = 0; i < flow.size(); ++i)
+            REQUIRE(Approx(magnitude(i)) == flow(i).norm());
+    }
+
+    SECTION("color wheel")
+    {
+        const PlanarFlowField<Scalar> planar(flow);
+        const Image<RGBf> expected = imflow<RGBf>(flow);
+        const Image<RGBf> actual = imflow<RGBf>(planar);
+        REQUIRE_IMAGE_APPROX(expected, actual, 0);
+    }
+}
@@ -0,0 +1,75 @@
+/* flow_image_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include <nvision/src/optflow/flow_image.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("flow color wheel", "[optflow]", float32, float64)
+{
+    using Scalar = TestType;
+
+    const FlowColorWheel<Scalar, RGBf> colorWheel;
+
+    SECTION("colors match exact conversion")
+    {
+        // directions cover the full circle, magnitudes vary independently
+        FlowField<Scalar> flow(9, 12);
+        for(Index c = 0; c < flow.cols(); ++c)
+        {
+            for(Index r = 0; r < flow.rows(); ++r)
+            {
+                const auto angle = 2 * pi<Scalar>() * static_cast<Scalar>(c * flow.rows() + r) / static_cast<Scalar>(flow.size()) + Scalar{0.1};
+                const auto magnitude = Scalar{0.5} + Scalar{0.3} * static_cast<Scalar>((7 * r + 3 * c) % 11);
+                flow(r, c) << magnitude * std::cos(angle), magnitude * std::sin(angle);
+            }
+        }
+
+        Scalar maxMagnitude = 0;
+        for(Index i = 0; i < flow.size(); ++i)
+            maxMagnitude = std::max(maxMagnitude, flow(i).norm());
+
+        Image<HSV> hsv(flow.rows(), flow.cols());
+        for(Index i = 0; i < flow.size(); ++i)
+        {
+            auto angle = std::atan2(flow(i)(1), flow(i)(0));
+            if(angle < 0)
+                angle += 2 * pi<Scalar>();
+            const auto hue = static_cast<float32>(angle / (2 * pi<Scalar>()));
+            const auto saturation = static_cast<float32>(flow(i).norm() / maxMagnitude);
+            hsv(i) = Pixel<HSV>(hue, saturation, 0.9f);
+        }
+        const Image<RGBf> expected = image::hsvToRGB(hsv);
+
+        // half a bin of 360 angle and 64 magnitude steps changes each
+        // channel by less than 0.0075
+        const Image<RGBf> actual = colorWheel(flow);
+        REQUIRE_IMAGE_APPROX(expected, actual, 0.02);
+
+        const Image<RGBf> defaultActual = imflow<RGBf>(flow);
+        REQUIRE_IMAGE_APPROX(actual, defaultActual, 0);
+    }
+
+    SECTION("zero flow")
+    {
+        FlowField<Scalar> flow(4, 5);
+        flow.setConstant(FlowVector<Scalar>::Zero());
+
+        // no direction and no magnitude, thus unsaturated
+        const Image<RGBf> actual = colorWheel(flow);
+        REQUIRE(actual.rows() == flow.rows());
+        REQUIRE(actual.cols() == flow.cols());
+        for(Index i = 0; i < actual.size(); ++i)
+        {
+            for(Index d = 0; d < actual(i).size(); ++d)
+            {
+                REQUIRE(std::isfinite(actual(i)[d]));
+                REQUIRE(Approx(actual(i)[d]).margin(1e-6) == 0.9f);
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/* horn_schunck_detector_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include "flow_generator.h"
+#include <nvision/src/optflow/horn_schunck_detector.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("horn schunck detector", "[optflow]", Grayf, RGBf)
+{
+    const float32 shiftX = 3.0f;
+    const float32 shiftY = 1.8f;
+
+    Image<TestType> imgA;
+    Image<TestType> imgB;
+    test::generateFlowImages(80, 100, shiftX, shiftY, imgA, imgB);
+
+    const auto requireFlow = [&](const FlowField<float32> &flow, const float32 eps)
+    {
+        REQUIRE(flow.rows() == imgA.rows());
+        REQUIRE(flow.cols() == imgA.cols());
+        test::requireFlow(flow, shiftX, shiftY, eps);
+    };
+
+    SECTION("multigrid")
+    {
+        HornSchunckDetector<float32> detector;
+        REQUIRE(detector.solver() == HornSchunckSolver::Multigrid);
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireFlow(flow, 0.1f);
+    }
+
+    SECTION("red-black SOR")
+    {
+        HornSchunckDetector<float32> detector;
+        detector.setSolver(HornSchunckSolver::SOR);
+        detector.setIterations(30);
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireFlow(flow, 0.1f);
+    }
+
+    SECTION("solvers converge to the same flow")
+    {
+        HornSchunckDetector<float32> detector(10, 0.1f);
+        detector.setPyramid(1, 0.5f);
+        detector.setWarps(1);
+
+        FlowField<float32> expected;
+        detector.setSolver(HornSchunckSolver::SOR);
+        detector.setIterations(1000);
+        detector(imgA, imgB, expected);
+
+        FlowField<float32> actual;
+        detector.setSolver(HornSchunckSolver::Multigrid);
+        detector.setIterations(5);
+        detector(imgA, imgB, actual);
+
+        for(Index i = 0; i < expected.size(); ++i)
+            REQUIRE_MATRIX_APPROX(expected(i), actual(i), 1e-3);
+    }
+
+    SECTION("multigrid solves single level hierarchies")
+    {
+        // too small to be coarsened, thus each V-cycle is a direct solve
+        // on the coarsest level with 30 SOR sweeps
+        const Image<TestType> smallA = imgA.block(20, 20, 14, 14);
+        const Image<TestType> smallB = imgB.block(20, 20, 14, 14);
+
+        HornSchunckDetector<float32> detector(30, 0.1f);
+        detector.setPyramid(1, 0.5f);
+        detector.setWarps(1);
+
+        FlowField<float32> expected;
+        detector.setSolver(HornSchunckSolver::SOR);
+        detector.setRelaxation(1.5f);
+        detector(smallA, smallB, expected);
+
+        FlowField<float32> actual;
+        detector.setSolver(HornSchunckSolver::Multigrid);
+        detector.setIterations(1);
+        detector(smallA, smallB, actual);
+
+        REQUIRE(flowU(actual).abs().maxCoeff() > 0.1f);
+        for(Index i = 0; i < expected.size(); ++i)
+            REQUIRE_MATRIX_APPROX(expected(i), actual(i), 1e-4);
+    }
+}
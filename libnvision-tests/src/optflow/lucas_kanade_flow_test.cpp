@@ -0,0 +1,158 @@
+/* lucas_kanade_flow_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include "flow_generator.h"
+#include <Eigen/LU>
+#include <nvision/src/optflow/lucas_kanade_flow.h>
+#include <nvision/src/filter/box_filter.h>
+#include <nvision/src/filter/recursive_gauss_filter.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("lucas kanade flow", "[optflow]", Grayf, RGBf)
+{
+    using ValueType = typename TestType::ValueType;
+
+    const float32 shiftX = 0.5f;
+    const float32 shiftY = 0.3f;
+
+    Image<TestType> imgA;
+    Image<TestType> imgB;
+    test::generateFlowImages(40, 50, shiftX, shiftY, imgA, imgB);
+
+    SECTION("closed form solution")
+    {
+        // reference with smoothed gradient products and matrix inverse
+        SobelFilter<float32> sobel;
+        GaussFilter<float32, 5> gauss(1.5f);
+        Image<Grayf> productXX(imgA.rows(), imgA.cols());
+        Image<Grayf> productXY(imgA.rows(), imgA.cols());
+        Image<Grayf> productYY(imgA.rows(), imgA.cols());
+        Image<Grayf> productXT(imgA.rows(), imgA.cols());
+        Image<Grayf> productYT(imgA.rows(), imgA.cols());
+        productXX.setZero();
+        productXY.setZero();
+        productYY.setZero();
+        productXT.setZero();
+        productYT.setZero();
+
+        const auto gradient = sobel(imgA, GradientMode::XY{});
+        const auto channels = static_cast<float32>(TestType::Dimension);
+        for(Index i = 0; i < imgA.size(); ++i)
+        {
+            for(Index d = 0; d < TestType::Dimension; ++d)
+            {
+                const auto x = gradient.x(i)[d] / 8;
+                const auto y = gradient.y(i)[d] / 8;
+                const auto t = imgB(i)[d] - imgA(i)[d];
+                productXX(i)[0] += x * x / channels;
+                productXY(i)[0] += x * y / channels;
+                productYY(i)[0] += y * y / channels;
+                productXT(i)[0] += x * t / channels;
+                productYT(i)[0] += y * t / channels;
+            }
+        }
+
+        const Image<Grayf> sumXX = gauss(productXX);
+        const Image<Grayf> sumXY = gauss(productXY);
+        const Image<Grayf> sumYY = gauss(productYY);
+        const Image<Grayf> sumXT = gauss(productXT);
+        const Image<Grayf> sumYT = gauss(productYT);
+
+        LucasKanadeFlow<float32, GaussFilter<float32, 5>> flow;
+        flow.setSmoothFilter(gauss);
+
+        FlowField<float32> actual;
+        flow(imgA, imgB, actual);
+
+        REQUIRE(actual.rows() == imgA.rows());
+        REQUIRE(actual.cols() == imgA.cols());
+        for(Index i = 0; i < actual.size(); ++i)
+        {
+            Eigen::Matrix2f tensor;
+            tensor << sumXX(i)[0], sumXY(i)[0],
+                      sumXY(i)[0], sumYY(i)[0];
+            const Eigen::Vector2f expected = -tensor.inverse() * Eigen::Vector2f(sumXT(i)[0], sumYT(i)[0]);
+
+            REQUIRE_MATRIX_APPROX(expected, actual(i), 1e-3);
+        }
+    }
+
+    SECTION("recover shift")
+    {
+        LucasKanadeFlow<float32, GaussFilter<float32, 7>> flow;
+        flow.setSmoothFilter(GaussFilter<float32, 7>(2.0f));
+
+        FlowField<float32> actual;
+        flow(imgA, imgB, actual);
+
+        test::requireFlow(actual, shiftX, shiftY, 0.1f, 5);
+    }
+
+    SECTION("window weights from kernel of smooth filter")
+    {
+        STATIC_REQUIRE(internal::HasSquareKernel<BoxFilter<float32, 7>>::value);
+        STATIC_REQUIRE_FALSE(internal::HasSquareKernel<RecursiveGaussFilter<float32>>::value);
+
+        LucasKanadeFlow<float32, BoxFilter<float32, 7>> flow;
+
+        FlowField<float32> actual;
+        flow(imgA, imgB, actual);
+
+        test::requireFlow(actual, shiftX, shiftY, 0.1f, 5);
+    }
+
+    SECTION("empty image")
+    {
+        LucasKanadeFlow<float32> flow;
+        const Image<TestType> empty;
+
+        PlanarFlowField<float32> actual;
+        flow(empty, empty, actual);
+
+        REQUIRE(actual.size() == 0);
+    }
+
+    SECTION("planar layout")
+    {
+        LucasKanadeFlow<float32> flow;
+
+        FlowField<float32> expected;
+        flow(imgA, imgB, expected);
+
+        PlanarFlowField<float32> actual;
+        flow(imgA, imgB, actual);
+
+        REQUIRE(actual.rows() == imgA.rows());
+        REQUIRE(actual.cols() == imgA.cols());
+        for(Index i = 0; i < expected.size(); ++i)
+        {
+            REQUIRE(expected(i)(0) == actual.u()(i));
+            REQUIRE(expected(i)(1) == actual.v()(i));
+        }
+    }
+
+    SECTION("reject ill-conditioned pixels")
+    {
+        // vertical stripes only constrain the horizontal flow
+        for(Index c = 0; c < imgA.cols(); ++c)
+        {
+            for(Index r = 0; r < imgA.rows(); ++r)
+            {
+                imgA(r, c).setConstant(static_cast<ValueType>(0.5f + 0.2f * std::sin(0.3f * c)));
+                imgB(r, c).setConstant(static_cast<ValueType>(0.5f + 0.2f * std::sin(0.3f * (c - shiftX))));
+            }
+        }
+
+        LucasKanadeFlow<float32> flow;
+        FlowField<float32> actual;
+        flow(imgA, imgB, actual);
+
+        for(Index i = 0; i < actual.size(); ++i)
+            REQUIRE_MATRIX_APPROX(FlowVector<float32>::Zero().eval(), actual(i), 1e-6);
+    }
+}
@@ -0,0 +1,93 @@
+/* lucas_kanade_tracker_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include "flow_generator.h"
+#include <nvision/src/optflow/lucas_kanade_tracker.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("lucas kanade tracker", "[optflow]", Grayf, RGBf)
+{
+    using ValueType = typename TestType::ValueType;
+    using Tracker = LucasKanadeTracker<float32>;
+
+    const float32 shiftX = 4.3f;
+    const float32 shiftY = -2.6f;
+
+    Image<TestType> imgA;
+    Image<TestType> imgB;
+    test::generateFlowImages(90, 120, shiftX, shiftY, imgA, imgB);
+
+    // subpixel points, whose windows stay inside both images
+    Tracker::FeatureMatrix pointsA(2, 30);
+    for(Index i = 0; i < pointsA.cols(); ++i)
+        pointsA.col(i) << 20.3f + static_cast<float32>((i * 37) % 70), 20.6f + static_cast<float32>((i * 53) % 50);
+
+    SECTION("track points")
+    {
+        Tracker tracker;
+
+        Tracker::FeatureMatrix pointsB;
+        Tracker::StatusVector status;
+        tracker(imgA, imgB, pointsA, pointsB, status);
+
+        REQUIRE(pointsB.cols() == pointsA.cols());
+        REQUIRE(status.size() == pointsA.cols());
+        REQUIRE(status.all());
+
+        const Eigen::Vector2f shift(shiftX, shiftY);
+        for(Index i = 0; i < pointsA.cols(); ++i)
+            REQUIRE_MATRIX_APPROX((pointsA.col(i) + shift).eval(), pointsB.col(i).eval(), 0.05);
+    }
+
+    SECTION("precomputed pyramids")
+    {
+        Tracker tracker;
+        tracker.setPyramid(2, 0.5f);
+
+        Tracker::FeatureMatrix expected;
+        Tracker::StatusVector expectedStatus;
+        tracker(imgA, imgB, pointsA, expected, expectedStatus);
+
+        const ImagePyramid<float32, TestType> pyramidA(imgA, 2, 0.5f);
+        const ImagePyramid<float32, TestType> pyramidB(imgB, 2, 0.5f);
+        Tracker::FeatureMatrix actual;
+        Tracker::StatusVector actualStatus;
+        tracker(pyramidA, pyramidB, pointsA, actual, actualStatus);
+
+        REQUIRE((expectedStatus == actualStatus).all());
+        REQUIRE_MATRIX_APPROX(expected, actual, 1e-6);
+    }
+
+    SECTION("lose points")
+    {
+        Tracker::FeatureMatrix points(2, 2);
+        // the first point moves out of the image, the second one lies in
+        // a region without texture
+        points.col(0) << 117.5f, 45.0f;
+        points.col(1) << 60.0f, 45.0f;
+
+        for(Index c = 50; c < 70; ++c)
+        {
+            for(Index r = 35; r < 55; ++r)
+            {
+                imgA(r, c).setConstant(static_cast<ValueType>(0.5f));
+                imgB(r, c).setConstant(static_cast<ValueType>(0.5f));
+            }
+        }
+
+        Tracker tracker;
+        tracker.setWindowRadius(5);
+
+        Tracker::FeatureMatrix pointsB;
+        Tracker::StatusVector status;
+        tracker(imgA, imgB, points, pointsB, status);
+
+        REQUIRE(!status(0));
+        REQUIRE(!status(1));
+    }
+}
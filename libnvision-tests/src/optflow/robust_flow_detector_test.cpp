@@ -0,0 +1,106 @@
+/* robust_flow_detector_test.cpp
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#include "eigen_require.h"
+#include "flow_generator.h"
+#include <nvision/src/optflow/horn_schunck_detector.h>
+#include <nvision/src/optflow/robust_flow_detector.h>
+
+using namespace nvision;
+
+TEMPLATE_TEST_CASE("robust flow detector", "[optflow]", Grayf, RGBf)
+{
+    const float32 shiftX = 3.0f;
+    const float32 shiftY = 1.8f;
+
+    Image<TestType> imgA;
+    Image<TestType> imgB;
+    test::generateFlowImages(80, 100, shiftX, shiftY, imgA, imgB);
+
+    const auto requireFlow = [&](const FlowField<float32> &flow, const float32 eps)
+    {
+        REQUIRE(flow.rows() == imgA.rows());
+        REQUIRE(flow.cols() == imgA.cols());
+        test::requireFlow(flow, shiftX, shiftY, eps);
+    };
+
+    SECTION("brightness constancy")
+    {
+        RobustFlowDetector<float32> detector;
+        REQUIRE(detector.gradientConstant() == 0);
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireFlow(flow, 0.1f);
+    }
+
+    SECTION("gradient constancy")
+    {
+        RobustFlowDetector<float32> detector(5, 0.02f, 1.0f);
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        requireFlow(flow, 0.1f);
+    }
+
+    SECTION("flow direction matches horn schunck detector")
+    {
+        // both detectors map pixels of the first image to their position
+        // in the second image
+        RobustFlowDetector<float32> robust;
+        HornSchunckDetector<float32> hornSchunck;
+
+        FlowField<float32> expected;
+        hornSchunck(imgA, imgB, expected);
+
+        FlowField<float32> actual;
+        robust(imgA, imgB, actual);
+
+        for(Index c = 10; c < imgA.cols() - 10; ++c)
+        {
+            for(Index r = 10; r < imgA.rows() - 10; ++r)
+            {
+                REQUIRE(expected(r, c)(0) > 0);
+                REQUIRE(expected(r, c)(1) > 0);
+                REQUIRE_MATRIX_APPROX(expected(r, c), actual(r, c), 0.2);
+            }
+        }
+    }
+
+    SECTION("motion boundary")
+    {
+        // the left half moves to the right, the right half to the left
+        const Index boundary = imgA.cols() / 2;
+        for(Index c = boundary; c < imgA.cols(); ++c)
+            for(Index r = 0; r < imgA.rows(); ++r)
+                imgB(r, c) = test::flowPatternPixel<TestType>(r, c + 2);
+
+        RobustFlowDetector<float32> detector;
+
+        FlowField<float32> flow;
+        detector(imgA, imgB, flow);
+
+        // the occluded columns next to the boundary are excluded
+        float32 error = 0;
+        Index count = 0;
+        for(Index c = 10; c < imgA.cols() - 10; ++c)
+        {
+            if(c >= boundary - 4 && c < boundary + 4)
+                continue;
+
+            for(Index r = 10; r < imgA.rows() - 10; ++r)
+            {
+                const Eigen::Vector2f expected = c < boundary ? Eigen::Vector2f(shiftX, shiftY) : Eigen::Vector2f(-2, 0);
+                error += (flow(r, c) - expected).norm();
+                ++count;
+            }
+        }
+
+        REQUIRE(error / static_cast<float32>(count) < 0.05f);
+    }
+}
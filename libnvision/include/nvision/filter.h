@@ -9,6 +9,7 @@
 
 #include "nvision/src/filter/box_filter.h"
 #include "nvision/src/filter/gauss_filter.h"
+#include "nvision/src/filter/recursive_gauss_filter.h"
 #include "nvision/src/filter/backward_differences_filter.h"
 #include "nvision/src/filter/forward_differences_filter.h"
 #include "nvision/src/filter/central_differences_filter.h"
@@ -17,5 +18,11 @@
 #include "nvision/src/filter/laplace_filter.h"
 #include "nvision/src/filter/diffusion_filter.h"
 #include "nvision/src/filter/canny_edge_filter.h"
+#include "nvision/src/filter/canny_edge_detector.h"
+#include "nvision/src/filter/histogram_equalization_filter.h"
+#include "nvision/src/filter/clahe_filter.h"
+#include "nvision/src/filter/morphology_filter.h"
+#include "nvision/src/filter/median_filter.h"
+#include "nvision/src/filter/bilateral_filter.h"
 
 #endif
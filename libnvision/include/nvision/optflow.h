@@ -10,5 +10,9 @@
 #include "nvision/src/optflow/flow_field.h"
 #include "nvision/src/optflow/flow_image.h"
 #include "nvision/src/optflow/lucas_kanade_flow.h"
+#include "nvision/src/optflow/lucas_kanade_tracker.h"
+#include "nvision/src/optflow/horn_schunck_detector.h"
+#include "nvision/src/optflow/robust_flow_detector.h"
+#include "nvision/src/optflow/dense_inverse_search_detector.h"
 
 #endif
@@ -43,6 +43,23 @@ namespace nvision
         static constexpr bool value = true;
     };
 
+    /** Gray color space with signed 16-bit types.
+      * This color space is used to store derivatives of Gray images. */
+    struct Gray16s
+    {
+        using ValueType = int16;
+        static constexpr Index Dimension = 1;
+
+        static constexpr std::array<ValueType, Dimension> minimum = {-32768};
+        static constexpr std::array<ValueType, Dimension> maximum = {32767};
+    };
+
+    template<>
+    struct IsColorSpace<Gray16s>
+    {
+        static constexpr bool value = true;
+    };
+
     // Grayf
     namespace pixel
     {
@@ -119,6 +136,12 @@ namespace nvision
     {
         using type = Gray;
     };
+
+    template<>
+    struct GetSignedColorSpace<Gray>
+    {
+        using type = Gray16s;
+    };
 }
 
 #endif
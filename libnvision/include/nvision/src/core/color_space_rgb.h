@@ -45,6 +45,23 @@ namespace nvision
         static constexpr bool value = true;
     };
 
+    /** RGB color space with signed 16-bit types.
+      * This color space is used to store derivatives of RGB images. */
+    struct RGB16s
+    {
+        using ValueType = int16;
+        static constexpr Index Dimension = 3;
+
+        static constexpr std::array<ValueType, Dimension> minimum = {-32768, -32768, -32768};
+        static constexpr std::array<ValueType, Dimension> maximum = {32767, 32767, 32767};
+    };
+
+    template<>
+    struct IsColorSpace<RGB16s>
+    {
+        static constexpr bool value = true;
+    };
+
     // RGBf
     namespace pixel
     {
@@ -100,6 +117,12 @@ namespace nvision
     {
         using type = RGB;
     };
+
+    template<>
+    struct GetSignedColorSpace<RGB>
+    {
+        using type = RGB16s;
+    };
 }
 
 #endif
@@ -18,6 +18,12 @@ namespace nvision
     template<typename T>
     struct GetIntegralColorSpace
     { };
+
+    /// Type trait which determines the signed 16-bit color space, which is
+    /// used to store derivatives of a color space with 8-bit values.
+    template<typename T>
+    struct GetSignedColorSpace
+    { };
 }
 
 #endif
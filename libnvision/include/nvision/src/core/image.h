@@ -11,9 +11,16 @@
 #include "nvision/src/core/image_interpolation.h"
 #include "nvision/src/core/image_resizing.h"
 #include "nvision/src/core/image_generic_ops.h"
+#include "nvision/src/core/image_color_conversion.h"
+#include "nvision/src/core/image_statistics.h"
+#include "nvision/src/core/image_histogram.h"
+#include "nvision/src/core/image_integral.h"
 #include "nvision/src/core/image_border_handling.h"
 #include "nvision/src/core/image_correlation.h"
 #include "nvision/src/core/image_filter.h"
+#include "nvision/src/core/image_separable_filter.h"
+#include "nvision/src/core/image_fft_correlation.h"
+#include "nvision/src/core/image_template_matching.h"
 #include "nvision/src/core/image_pyramid.h"
 
 #endif
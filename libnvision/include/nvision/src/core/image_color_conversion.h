@@ -0,0 +1,109 @@
+/* image_color_conversion.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_COLOR_CONVERSION_H_
+#define NVISION_IMAGE_COLOR_CONVERSION_H_
+
+#include <type_traits>
+#include "nvision/src/core/image_type.h"
+#include "nvision/src/core/image_generic_ops.h"
+
+namespace nvision::image
+{
+    namespace internal
+    {
+        using ColorPlane = Eigen::Array<float32, Eigen::Dynamic, Eigen::Dynamic>;
+
+        /** Merges three planes into a single image of the given color space. */
+        template<typename ColorSpace>
+        inline Image<ColorSpace> mergePlanes(const ColorPlane &plane0, const ColorPlane &plane1, const ColorPlane &plane2)
+        {
+            static_assert(ColorSpace::Dimension == 3, "color space must have three channels");
+
+            Image<ColorSpace> result(plane0.rows(), plane0.cols());
+            for(Index i = 0; i < result.size(); ++i)
+                result(i) = Pixel<ColorSpace>(plane0(i), plane1(i), plane2(i));
+
+            return result;
+        }
+    }
+
+    /** Converts a whole HSV image to RGB.
+      * In contrast to image::convert<RGBf>() this function operates on
+      * separate channel planes, such that the conversion is vectorized
+      * by Eigen instead of being evaluated pixel by pixel.
+      * The results are equal to pixel::convert<HSV, RGBf>().
+      * @param img HSV image
+      * @return converted RGB image */
+    template<typename Derived>
+    inline Image<RGBf> hsvToRGB(const ImageBase<Derived> &img)
+    {
+        static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+        static_assert(std::is_same<typename ImageBase<Derived>::Scalar::ColorSpace, HSV>::value, "input must be a HSV image");
+
+        const internal::ColorPlane h = channel<float32>(img, 0) * float32{6};
+        const internal::ColorPlane s = channel<float32>(img, 1);
+        const internal::ColorPlane v = channel<float32>(img, 2);
+        const internal::ColorPlane vs = v * s;
+
+        // see pixel::convert<HSV, RGBf>(), fmod is replaced by a floor
+        // operation, which is available as packet operation
+        const auto f = [&h, &v, &vs](const float32 n) -> internal::ColorPlane
+        {
+            const internal::ColorPlane t = h + n;
+            const internal::ColorPlane k = t - float32{6} * (t / float32{6}).floor();
+            return v - vs * k.min(float32{4} - k).min(float32{1}).max(float32{0});
+        };
+
+        return internal::mergePlanes<RGBf>(f(5), f(3), f(1));
+    }
+
+    /** Converts a whole image to HSV.
+      * Images which are not RGBf are converted to RGBf first.
+      * In contrast to image::convert<HSV>() this function operates on
+      * separate channel planes, such that the conversion is vectorized
+      * by Eigen instead of being evaluated pixel by pixel.
+      * The results are equal to pixel::convert<RGBf, HSV>().
+      * @param img input image
+      * @return converted HSV image */
+    template<typename Derived>
+    inline Image<HSV> rgbToHSV(const ImageBase<Derived> &img)
+    {
+        static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+        using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+
+        if constexpr (!std::is_same<ColorSpace, RGBf>::value)
+        {
+            const Image<RGBf> rgb = convert<RGBf>(img);
+            return rgbToHSV(rgb);
+        }
+        else
+        {
+            const internal::ColorPlane r = channel<float32>(img, 0);
+            const internal::ColorPlane g = channel<float32>(img, 1);
+            const internal::ColorPlane b = channel<float32>(img, 2);
+
+            const internal::ColorPlane xmax = r.max(g).max(b);
+            const internal::ColorPlane xmin = r.min(g).min(b);
+            const internal::ColorPlane c = xmax - xmin;
+            // avoid divisions by zero, the affected entries are masked below
+            const internal::ColorPlane cinv = (c == float32{0}).select(float32{0}, c.inverse());
+
+            const internal::ColorPlane s = (xmax == float32{0}).select(float32{0}, c / xmax);
+
+            // the sector hues are selected in reverse order of precedence of
+            // pixel::convert<RGBf, HSV>()
+            internal::ColorPlane h = ((r - g) * cinv + float32{4});
+            h = (xmax == g).select((b - r) * cinv + float32{2}, h);
+            h = (xmax == r).select((g - b) * cinv, h);
+            h = (c == float32{0}).select(float32{0}, h) / float32{6};
+
+            return internal::mergePlanes<HSV>(h, s, xmax);
+        }
+    }
+}
+
+#endif
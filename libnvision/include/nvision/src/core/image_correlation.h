@@ -7,13 +7,57 @@
 #ifndef NVISION_IMAGE_CORRELATION_H_
 #define NVISION_IMAGE_CORRELATION_H_
 
+#include <array>
+#include <memory>
+#include <Eigen/SVD>
 #include "nvision/src/core/image_type.h"
 #include "nvision/src/core/image_border_handling.h"
+#include "nvision/src/core/parallel.h"
 
 namespace nvision::image
 {
     namespace internal
     {
+        /** Splits a rank-1 kernel into a vertical and a horizontal vector,
+          * such that kernel = vertical * horizontal^T.
+          * The rank is determined by the singular values of the kernel. The
+          * vectors are taken from the row and column of the largest kernel
+          * element, such that kernels with identical weights are separated
+          * exactly.
+          * @return true if the kernel has rank 1, false otherwise */
+        template<typename KernelType, typename Vector>
+        inline bool separateKernel(const KernelType &kernel, Vector &vertical, Vector &horizontal)
+        {
+            using Scalar = typename KernelType::Scalar;
+            using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+            if(kernel.rows() < 2 || kernel.cols() < 2)
+                return false;
+
+            const Matrix matrix = kernel;
+            const Eigen::JacobiSVD<Matrix> svd(matrix);
+            const auto &singular = svd.singularValues();
+            if(singular(0) <= Scalar{0} || singular(1) > Eigen::NumTraits<Scalar>::dummy_precision() * singular(0))
+                return false;
+
+            Index row;
+            Index col;
+            matrix.cwiseAbs().maxCoeff(&row, &col);
+
+            vertical = matrix.col(col);
+            horizontal = matrix.row(row).transpose() / matrix(row, col);
+            return true;
+        }
+
+        /** Correlates an image with a kernel of runtime size.
+          *
+          * Rank-1 kernels, which are large enough to benefit from it, are
+          * applied in two 1D passes. The vertical pass is computed when the
+          * functor is constructed, the horizontal pass is computed for each
+          * pixel. Square kernels of size 3, 5, 7, 9 and 11 are dispatched to
+          * fully unrolled loops, which skip the border handling for pixels
+          * whose neighbourhood lies within the image. All other kernels use
+          * a generic loop. */
         template<typename Derived, typename KernelType, typename BorderHandling>
         class CorrelateFunctor
         {
@@ -25,29 +69,42 @@ namespace nvision::image
             using PixelType = typename ImageBase<Derived>::Scalar;
             using ColorSpace = typename PixelType::ColorSpace;
             using ImageValueType = typename ColorSpace::ValueType;
+            static constexpr Index Dimension = ColorSpace::Dimension;
+            using Values = Eigen::Array<KernelScalar, Dimension, 1>;
+            using Plane = Eigen::Array<KernelScalar, Eigen::Dynamic, Eigen::Dynamic>;
+            using Vector = Eigen::Array<KernelScalar, Eigen::Dynamic, 1>;
+            using Planes = std::array<Plane, Dimension>;
 
             CorrelateFunctor(const ImageBase<Derived> &img, const KernelType &kernel, const BorderHandling &handling)
             : _img(img), _kernel(kernel), _handling(handling)
-            { }
+            {
+                // the additional sweep of the vertical pass only pays off
+                // if it saves enough multiplications
+                Vector vertical;
+                if(_kernel.size() > 2 * (_kernel.rows() + _kernel.cols()) && separateKernel(_kernel, vertical, _horizontal))
+                    _vertical = std::make_shared<const Planes>(correlateVertical(vertical));
+            }
 
             Pixel<ColorSpace> operator()(const Index row, const Index col) const
             {
                 // use the kernel scalars to accumulate
                 // these are typically floating points
-                Eigen::Array<KernelScalar, ColorSpace::Dimension, 1> result;
-                result.setZero();
+                Values result = Values::Zero();
 
-                for(Index kcol = 0; kcol < _kernel.cols(); ++kcol)
+                if(_vertical != nullptr)
                 {
-                    const Index vcol = col + kcol - _kernel.cols() / 2;
-
-                    for(Index krow = 0; krow < _kernel.rows(); ++krow)
+                    correlateHorizontal(result, row, col);
+                }
+                else
+                {
+                    switch(_kernel.rows() == _kernel.cols() ? _kernel.rows() : 0)
                     {
-                        const Index vrow = row + krow - _kernel.rows() / 2;
-                        const auto &pixel = _handling(_img, vrow, vcol);
-
-                        for(Index i = 0; i < ColorSpace::Dimension; ++i)
-                            result(i, 0) += _kernel(krow, kcol) * static_cast<KernelScalar>(pixel[i]);
+                    case 3: correlateFixed<3>(result, row, col); break;
+                    case 5: correlateFixed<5>(result, row, col); break;
+                    case 7: correlateFixed<7>(result, row, col); break;
+                    case 9: correlateFixed<9>(result, row, col); break;
+                    case 11: correlateFixed<11>(result, row, col); break;
+                    default: correlateDynamic(result, row, col); break;
                     }
                 }
 
@@ -61,12 +118,103 @@ namespace nvision::image
 
         private:
             const ImageBase<Derived> &_img;
-            const KernelType &_kernel;
+            Plane _kernel;
             const BorderHandling _handling;
+            Vector _horizontal = {};
+            std::shared_ptr<const Planes> _vertical = nullptr;
+
+            static void accumulate(Values &result, const KernelScalar weight, const PixelType &pixel)
+            {
+                for(Index i = 0; i < Dimension; ++i)
+                    result(i) += weight * static_cast<KernelScalar>(pixel[i]);
+            }
+
+            template<Index Size>
+            void correlateFixed(Values &result, const Index row, const Index col) const
+            {
+                constexpr Index half = Size / 2;
+                const KernelScalar *weights = _kernel.data();
+
+                if(row >= half && row + half < _img.rows() && col >= half && col + half < _img.cols())
+                {
+                    for(Index kcol = 0; kcol < Size; ++kcol)
+                        for(Index krow = 0; krow < Size; ++krow)
+                            accumulate(result, weights[kcol * Size + krow], _img(row + krow - half, col + kcol - half));
+                }
+                else
+                {
+                    for(Index kcol = 0; kcol < Size; ++kcol)
+                        for(Index krow = 0; krow < Size; ++krow)
+                            accumulate(result, weights[kcol * Size + krow], _handling(_img, row + krow - half, col + kcol - half));
+                }
+            }
+
+            void correlateDynamic(Values &result, const Index row, const Index col) const
+            {
+                for(Index kcol = 0; kcol < _kernel.cols(); ++kcol)
+                {
+                    const Index vcol = col + kcol - _kernel.cols() / 2;
+
+                    for(Index krow = 0; krow < _kernel.rows(); ++krow)
+                    {
+                        const Index vrow = row + krow - _kernel.rows() / 2;
+                        accumulate(result, _kernel(krow, kcol), _handling(_img, vrow, vcol));
+                    }
+                }
+            }
+
+            /** Correlates all columns of the image including the columns,
+              * which are added by the border handling on both sides, with
+              * the vertical kernel. The columns run in parallel. */
+            Planes correlateVertical(const Vector &vertical) const
+            {
+                const auto rows = _img.rows();
+                const auto half = vertical.size() / 2;
+                const auto margin = _kernel.cols() / 2;
+
+                Planes planes;
+                for(auto &plane : planes)
+                    plane.resize(rows, _img.cols() + 2 * margin);
+
+                parallel::forEach(0, _img.cols() + 2 * margin, [&](const Index c)
+                {
+                    const auto col = c - margin;
+                    for(Index r = 0; r < rows; ++r)
+                    {
+                        Values sum = Values::Zero();
+                        if(col >= 0 && col < _img.cols() && r >= half && r + half < rows)
+                        {
+                            for(Index k = 0; k < vertical.size(); ++k)
+                                accumulate(sum, vertical(k), _img(r + k - half, col));
+                        }
+                        else
+                        {
+                            for(Index k = 0; k < vertical.size(); ++k)
+                                accumulate(sum, vertical(k), _handling(_img, r + k - half, col));
+                        }
+
+                        for(Index d = 0; d < Dimension; ++d)
+                            planes[d](r, c) = sum(d);
+                    }
+                });
+
+                return planes;
+            }
+
+            void correlateHorizontal(Values &result, const Index row, const Index col) const
+            {
+                const auto &planes = *_vertical;
+                for(Index k = 0; k < _horizontal.size(); ++k)
+                    for(Index d = 0; d < Dimension; ++d)
+                        result(d) += _horizontal(k) * planes[d](row, col + k);
+            }
         };
     }
 
     /** Convolves an image with the given kernel and border handling.
+      * The kernel is copied, so the expression does not refer to it.
+      * If the kernel has rank 1, the vertical pass of the separated kernel
+      * is computed immediately, otherwise the expression is evaluated lazily.
       * @param img image which is convolved
       * @param kernel kernel which is used to correlate the image
       * @param handling border handling that is used for convolving
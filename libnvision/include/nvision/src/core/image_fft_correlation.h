@@ -0,0 +1,394 @@
+/* image_fft_correlation.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_FFT_CORRELATION_H_
+#define NVISION_IMAGE_FFT_CORRELATION_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <unsupported/Eigen/FFT>
+#include "nvision/src/core/math.h"
+#include "nvision/src/core/parallel.h"
+#include "nvision/src/core/image_correlation.h"
+
+namespace nvision
+{
+    struct CorrelationMode
+    {
+        /** Evaluates the kernel for each pixel. */
+        struct Direct {};
+        /** Multiplies the spectra of image tiles and kernel. */
+        struct FFT {};
+        /** Chooses Direct or FFT by the estimated number of operations. */
+        struct Auto {};
+    };
+
+    /** Precomputed spectrum of a correlation kernel, which can be reused to
+      * correlate any number of images of arbitrary size with the same kernel.
+      *
+      * The size of the transform only depends on the size of the kernel,
+      * images are processed in tiles of fftRows() - kernelRows() + 1 by
+      * fftCols() - kernelCols() + 1 pixels.
+      *
+      * For convolution construct the spectrum from the reversed kernel,
+      * i.e. KernelSpectrum<float32>(kernel.reverse()). */
+    template<typename _Scalar>
+    class KernelSpectrum
+    {
+    public:
+        using Scalar = _Scalar;
+        using Complex = std::complex<Scalar>;
+        using Plane = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+        using Spectrum = Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "spectrum must have floating point scalars");
+
+        KernelSpectrum() = default;
+
+        template<typename KernelType>
+        explicit KernelSpectrum(const KernelType &kernel)
+        {
+            setKernel(kernel);
+        }
+
+        /** Computes the spectrum of the given kernel.
+          * @param kernel kernel with odd number of rows and columns */
+        template<typename KernelType>
+        void setKernel(const KernelType &kernel)
+        {
+            assert(kernel.rows() % 2 == 1 && kernel.cols() % 2 == 1);
+
+            _kernelRows = kernel.rows();
+            _kernelCols = kernel.cols();
+            _fftRows = fftSize(_kernelRows);
+            _fftCols = fftSize(_kernelCols);
+
+            // the tiles are convolved with the spectrum, thus the kernel
+            // is stored reversed to obtain a correlation
+            Plane plane = Plane::Zero(_fftRows, _fftCols);
+            for(Index c = 0; c < _kernelCols; ++c)
+                for(Index r = 0; r < _kernelRows; ++r)
+                    plane(_kernelRows - 1 - r, _kernelCols - 1 - c) = static_cast<Scalar>(kernel(r, c));
+
+            Eigen::FFT<Scalar> fft;
+            fft.SetFlag(Eigen::FFT<Scalar>::HalfSpectrum);
+            forward(fft, plane, _kernelCols, _spectrum);
+        }
+
+        Index kernelRows() const
+        {
+            return _kernelRows;
+        }
+
+        Index kernelCols() const
+        {
+            return _kernelCols;
+        }
+
+        Index fftRows() const
+        {
+            return _fftRows;
+        }
+
+        Index fftCols() const
+        {
+            return _fftCols;
+        }
+
+        /** Returns the half spectrum of the reversed kernel with
+          * fftRows() / 2 + 1 rows and fftCols() columns. */
+        const Spectrum &spectrum() const
+        {
+            return _spectrum;
+        }
+
+        /** Computes the size of the transform for a kernel of the given size.
+          * The transform is a power of two and at least four times the
+          * kernel size, such that the tiles are larger than the kernel. */
+        static Index fftSize(const Index kernelSize)
+        {
+            Index size = 32;
+            while(size < 4 * kernelSize)
+                size *= 2;
+            return size;
+        }
+
+        /** Computes the 2D half spectrum of the given real plane.
+          * Only the first cols columns of the plane may be non-zero. */
+        static void forward(Eigen::FFT<Scalar> &fft, const Plane &plane, const Index cols, Spectrum &spectrum)
+        {
+            const auto rows = plane.rows();
+            spectrum.resize(rows / 2 + 1, plane.cols());
+
+            for(Index c = 0; c < cols; ++c)
+                fft.fwd(spectrum.col(c).data(), plane.col(c).data(), rows);
+            spectrum.rightCols(plane.cols() - cols).setZero();
+
+            Eigen::Matrix<Complex, Eigen::Dynamic, 1> in(plane.cols());
+            Eigen::Matrix<Complex, Eigen::Dynamic, 1> out(plane.cols());
+            for(Index r = 0; r < spectrum.rows(); ++r)
+            {
+                in = spectrum.row(r).transpose();
+                fft.fwd(out.data(), in.data(), in.size());
+                spectrum.row(r) = out.transpose();
+            }
+        }
+
+        /** Computes the real plane of the given 2D half spectrum.
+          * The spectrum is overwritten. */
+        static void inverse(Eigen::FFT<Scalar> &fft, Spectrum &spectrum, Plane &plane)
+        {
+            const auto rows = (spectrum.rows() - 1) * 2;
+            plane.resize(rows, spectrum.cols());
+
+            Eigen::Matrix<Complex, Eigen::Dynamic, 1> in(spectrum.cols());
+            Eigen::Matrix<Complex, Eigen::Dynamic, 1> out(spectrum.cols());
+            for(Index r = 0; r < spectrum.rows(); ++r)
+            {
+                in = spectrum.row(r).transpose();
+                fft.inv(out.data(), in.data(), in.size());
+                spectrum.row(r) = out.transpose();
+            }
+
+            for(Index c = 0; c < plane.cols(); ++c)
+                fft.inv(plane.col(c).data(), spectrum.col(c).data(), rows);
+        }
+
+    private:
+        Index _kernelRows = 0;
+        Index _kernelCols = 0;
+        Index _fftRows = 0;
+        Index _fftCols = 0;
+        Spectrum _spectrum = {};
+    };
+
+    namespace image
+    {
+        namespace internal
+        {
+            /** Estimates the number of operations of the direct and the FFT
+              * based correlation of an image with a kernel of the given size
+              * and returns true if the FFT based correlation is cheaper.
+              * The estimate of the FFT includes the forward and the inverse
+              * transform of each tile and the product of the spectra. Each
+              * tap of the direct correlation is weighted with the cost of
+              * the border handling, which is applied to every access. */
+            inline bool preferFFTCorrelation(const Index rows, const Index cols, const Index kernelRows, const Index kernelCols)
+            {
+                const auto fftRows = KernelSpectrum<float64>::fftSize(kernelRows);
+                const auto fftCols = KernelSpectrum<float64>::fftSize(kernelCols);
+                const auto tileRows = fftRows - kernelRows + 1;
+                const auto tileCols = fftCols - kernelCols + 1;
+                const auto tiles = static_cast<float64>(parallel::chunks(rows + kernelRows - 1, tileRows) * parallel::chunks(cols + kernelCols - 1, tileCols));
+                const auto fftSize = static_cast<float64>(fftRows * fftCols);
+
+                const auto directCost = static_cast<float64>(rows * cols) * static_cast<float64>(kernelRows * kernelCols) * 4;
+                const auto fftCost = tiles * fftSize * (5 * std::log2(fftSize) + 4);
+
+                return fftCost < directCost;
+            }
+        }
+
+        /** Correlates an image with the kernel of the given spectrum using
+          * the fast fourier transform.
+          *
+          * The image is split into tiles, which are transformed, multiplied
+          * with the kernel spectrum and transformed back. The responses of
+          * the tiles overlap by the kernel size and are added up
+          * (overlap-add). Rows of tiles run in parallel.
+          *
+          * The number of operations per pixel grows only logarithmically
+          * with the kernel size, which makes this preferable over the direct
+          * correlation for large kernels. Integral results are rounded.
+          * @param img image which is correlated
+          * @param spectrum precomputed spectrum of the kernel
+          * @param handling border handling that is used for correlating
+          * @return correlated image */
+        template<typename Derived, typename Scalar, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> correlate(const ImageBase<Derived> &img,
+                                                                         const KernelSpectrum<Scalar> &spectrum,
+                                                                         const BorderHandling &handling)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be a valid image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            using Plane = typename KernelSpectrum<Scalar>::Plane;
+            using Spectrum = typename KernelSpectrum<Scalar>::Spectrum;
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto kernelRows = spectrum.kernelRows();
+            const auto kernelCols = spectrum.kernelCols();
+            const auto fftRows = spectrum.fftRows();
+            const auto fftCols = spectrum.fftCols();
+
+            // size of the padded image, which contains the border handling,
+            // and the size of a single tile of the padded image
+            const auto paddedRows = rows + kernelRows - 1;
+            const auto paddedCols = cols + kernelCols - 1;
+            const auto tileRows = fftRows - kernelRows + 1;
+            const auto tileCols = fftCols - kernelCols + 1;
+            const auto tileRowCount = parallel::chunks(paddedRows, tileRows);
+            const auto tileColCount = parallel::chunks(paddedCols, tileCols);
+
+            std::array<Plane, Dimension> sums;
+            for(auto &plane : sums)
+                plane.setZero(rows, cols);
+
+            // the responses of a row of tiles reach kernelRows - 1 rows into
+            // the next row of tiles, but never into the row after, because
+            // the tiles are larger than the kernel, so every other row of
+            // tiles can be processed in parallel
+            for(Index phase = 0; phase < 2; ++phase)
+            {
+                parallel::forEach(0, (tileRowCount - phase + 1) / 2, [&](const Index idx)
+                {
+                    const auto tileRow = 2 * idx + phase;
+                    const auto beginRow = tileRow * tileRows;
+                    const auto height = std::min(tileRows, paddedRows - beginRow);
+
+                    Eigen::FFT<Scalar> fft;
+                    fft.SetFlag(Eigen::FFT<Scalar>::HalfSpectrum);
+                    std::array<Plane, Dimension> tiles;
+                    for(auto &tile : tiles)
+                        tile.resize(fftRows, fftCols);
+                    Spectrum tileSpectrum;
+                    Plane response;
+
+                    for(Index tileCol = 0; tileCol < tileColCount; ++tileCol)
+                    {
+                        const auto beginCol = tileCol * tileCols;
+                        const auto width = std::min(tileCols, paddedCols - beginCol);
+
+                        for(auto &tile : tiles)
+                            tile.setZero();
+                        for(Index c = 0; c < width; ++c)
+                        {
+                            for(Index r = 0; r < height; ++r)
+                            {
+                                const auto &pixel = handling(img, beginRow + r - kernelRows / 2, beginCol + c - kernelCols / 2);
+                                for(Index d = 0; d < Dimension; ++d)
+                                    tiles[d](r, c) = static_cast<Scalar>(pixel[d]);
+                            }
+                        }
+
+                        // the response at tile index (r, c) belongs to the
+                        // pixel at (beginRow + r - kernelRows + 1, beginCol + c - kernelCols + 1)
+                        const auto minRow = std::max<Index>(0, kernelRows - 1 - beginRow);
+                        const auto maxRow = std::min(height + kernelRows - 1, rows + kernelRows - 1 - beginRow);
+                        const auto minCol = std::max<Index>(0, kernelCols - 1 - beginCol);
+                        const auto maxCol = std::min(width + kernelCols - 1, cols + kernelCols - 1 - beginCol);
+
+                        for(Index d = 0; d < Dimension; ++d)
+                        {
+                            KernelSpectrum<Scalar>::forward(fft, tiles[d], width, tileSpectrum);
+                            tileSpectrum = tileSpectrum.cwiseProduct(spectrum.spectrum());
+                            KernelSpectrum<Scalar>::inverse(fft, tileSpectrum, response);
+
+                            sums[d].block(beginRow + minRow - kernelRows + 1, beginCol + minCol - kernelCols + 1, maxRow - minRow, maxCol - minCol)
+                                += response.block(minRow, minCol, maxRow - minRow, maxCol - minCol);
+                        }
+                    }
+                });
+            }
+
+            Image<ColorSpace> result(rows, cols);
+            parallel::forEach(0, cols, [&](const Index c)
+            {
+                for(Index r = 0; r < rows; ++r)
+                    for(Index d = 0; d < Dimension; ++d)
+                        result(r, c)[d] = roundCast<ValueType>(sums[d](r, c));
+            });
+
+            return result;
+        }
+
+        /** Correlates an image with the kernel of the given spectrum using
+          * the fast fourier transform and reflect border handling.
+          * @param img image which is correlated
+          * @param spectrum precomputed spectrum of the kernel
+          * @return correlated image */
+        template<typename Derived, typename Scalar>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> correlate(const ImageBase<Derived> &img,
+                                                                         const KernelSpectrum<Scalar> &spectrum)
+        {
+            return correlate(img, spectrum, BorderReflect{});
+        }
+
+        /** Correlates an image with the given kernel using the fast fourier
+          * transform. Use a KernelSpectrum to correlate multiple images with
+          * the same kernel.
+          * @param img image which is correlated
+          * @param kernel kernel with odd number of rows and columns
+          * @param handling border handling that is used for correlating
+          * @return correlated image */
+        template<typename Derived, typename KernelType, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> correlate(const ImageBase<Derived> &img,
+                                                                         const KernelType &kernel,
+                                                                         const CorrelationMode::FFT &,
+                                                                         const BorderHandling &handling = BorderHandling{})
+        {
+            using Scalar = typename KernelType::Scalar;
+            return correlate(img, KernelSpectrum<Scalar>(kernel), handling);
+        }
+
+        /** Correlates an image with the given kernel directly.
+          * @param img image which is correlated
+          * @param kernel kernel with odd number of rows and columns
+          * @param handling border handling that is used for correlating
+          * @return correlated image */
+        template<typename Derived, typename KernelType, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> correlate(const ImageBase<Derived> &img,
+                                                                         const KernelType &kernel,
+                                                                         const CorrelationMode::Direct &,
+                                                                         const BorderHandling &handling = BorderHandling{})
+        {
+            return correlate(img, kernel, handling);
+        }
+
+        /** Correlates an image with the given kernel either directly or
+          * using the fast fourier transform, whichever requires fewer
+          * operations for the given image and kernel size.
+          * @param img image which is correlated
+          * @param kernel kernel with odd number of rows and columns
+          * @param handling border handling that is used for correlating
+          * @return correlated image */
+        template<typename Derived, typename KernelType, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> correlate(const ImageBase<Derived> &img,
+                                                                         const KernelType &kernel,
+                                                                         const CorrelationMode::Auto &,
+                                                                         const BorderHandling &handling = BorderHandling{})
+        {
+            if(internal::preferFFTCorrelation(img.rows(), img.cols(), kernel.rows(), kernel.cols()))
+                return correlate(img, kernel, CorrelationMode::FFT{}, handling);
+            else
+                return correlate(img, kernel, CorrelationMode::Direct{}, handling);
+        }
+
+        /** Convolves an image with the given kernel, i.e. correlates the
+          * image with the reversed kernel.
+          * @param img image which is convolved
+          * @param kernel kernel with odd number of rows and columns
+          * @param mode correlation mode; defaults to CorrelationMode::Auto
+          * @param handling border handling that is used for convolving
+          * @return convolved image */
+        template<typename Derived, typename KernelType, typename Mode=CorrelationMode::Auto, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> convolve(const ImageBase<Derived> &img,
+                                                                        const KernelType &kernel,
+                                                                        const Mode &mode = Mode{},
+                                                                        const BorderHandling &handling = BorderHandling{})
+        {
+            using Scalar = typename KernelType::Scalar;
+            const Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic> reversed = kernel.reverse();
+            return correlate(img, reversed, mode, handling);
+        }
+    }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef NVISION_IMAGE_FILTER_H_
 #define NVISION_IMAGE_FILTER_H_
 
+#include <limits>
 #include "nvision/src/core/image_type.h"
 #include "nvision/src/core/image_border_handling.h"
 
@@ -66,6 +67,77 @@ namespace nvision::image
             const KernelType &_kernel;
             const BorderHandling _handling;
         };
+
+        /** Divides an accumulated fixed point value by 2^shift with rounding
+          * and saturates it to the range of the output value type. */
+        template<typename OutputValueType>
+        inline OutputValueType fixedPointValue(const int32 value, const int shift)
+        {
+            const auto offset = shift > 0 ? int32{1} << (shift - 1) : int32{0};
+            constexpr auto minval = static_cast<int32>(std::numeric_limits<OutputValueType>::lowest());
+            constexpr auto maxval = static_cast<int32>(std::numeric_limits<OutputValueType>::max());
+            return static_cast<OutputValueType>(nvision::clamp<int32>((value + offset) >> shift, minval, maxval));
+        }
+
+        template<typename Derived, typename KernelType, typename BorderHandling, Index Rows, Index Cols, typename OutputColorSpace>
+        class FixedPointFilterFunctor
+        {
+        public:
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be a valid image type");
+            static_assert(std::is_integral<typename KernelType::Scalar>::value, "kernel must have integral scalars");
+            static_assert(std::is_integral<typename ImageBase<Derived>::Scalar::ColorSpace::ValueType>::value, "image must have integral values");
+            static_assert(IsColorSpace<OutputColorSpace>::value, "output must be a valid color space");
+            static_assert(std::is_integral<typename OutputColorSpace::ValueType>::value, "output must have integral values");
+
+            using KernelScalar = typename KernelType::Scalar;
+            using Accumulator = int32;
+            static constexpr auto KernelRows = Rows;
+            static constexpr auto KernelCols = Cols;
+            using PixelType = typename ImageBase<Derived>::Scalar;
+            using ColorSpace = typename PixelType::ColorSpace;
+            using OutputValueType = typename OutputColorSpace::ValueType;
+
+            static_assert(ColorSpace::Dimension == OutputColorSpace::Dimension, "output must have the same number of channels");
+
+            FixedPointFilterFunctor(const ImageBase<Derived> &img, const KernelType &kernel, const Index shift, const BorderHandling &handling)
+            : _img(img), _kernel(kernel), _shift(static_cast<int>(shift)), _handling(handling)
+            { }
+
+            Pixel<OutputColorSpace> operator()(const Index row, const Index col) const
+            {
+                // accumulate the products of the integral kernel and the
+                // image values in 32-bit integers
+                Eigen::Array<Accumulator, ColorSpace::Dimension, 1> result;
+                result.setZero();
+
+                for(Index kcol = 0; kcol < KernelCols; ++kcol)
+                {
+                    const Index vcol = col + kcol - KernelCols / 2;
+
+                    for(Index krow = 0; krow < KernelRows; ++krow)
+                    {
+                        const Index vrow = row + krow - KernelRows / 2;
+                        const auto &pixel = _handling(_img, vrow, vcol);
+                        const auto weight = static_cast<Accumulator>(_kernel(krow, kcol));
+
+                        for(Index i = 0; i < ColorSpace::Dimension; ++i)
+                            result(i, 0) += weight * static_cast<Accumulator>(pixel[i]);
+                    }
+                }
+
+                Pixel<OutputColorSpace> resultPixel;
+                for(Index i = 0; i < ColorSpace::Dimension; ++i)
+                    resultPixel[i] = fixedPointValue<OutputValueType>(result(i), _shift);
+
+                return resultPixel;
+            }
+
+        private:
+            const ImageBase<Derived> &_img;
+            const KernelType &_kernel;
+            const int _shift;
+            const BorderHandling _handling;
+        };
     }
 
     /** Convolves an image with the given kernel and border handling.
@@ -81,6 +153,25 @@ namespace nvision::image
         return ImageBase<Derived>::NullaryExpr(img.rows(), img.cols(), functor);
     }
 
+    /** Convolves an image with integral values with the given integral
+      * kernel in fixed point arithmetic.
+      * The products are accumulated in 32-bit integers. The result is
+      * divided by 2^shift with rounding and saturated to the value range of
+      * the output color space.
+      * The kernel must have compile-time dimensions.
+      * @param img image which is convolved
+      * @param kernel integral kernel which is used to correlate the image
+      * @param shift number of fractional bits of the kernel
+      * @param handling border handling that is used for convolving
+      * @return expression of the convolution */
+    template<Index Rows, Index Cols, typename OutputColorSpace, typename Derived, typename KernelType, typename BorderHandling>
+    auto filterFixedPoint(const ImageBase<Derived> &img, const KernelType &kernel, const Index shift, const BorderHandling &handling)
+    {
+        assert(shift >= 0 && shift < 31);
+        const auto functor = internal::FixedPointFilterFunctor<Derived, KernelType, BorderHandling, Rows, Cols, OutputColorSpace>(img, kernel, shift, handling);
+        return Image<OutputColorSpace>::NullaryExpr(img.rows(), img.cols(), functor);
+    }
+
     /** Convolves an image with the given kernel and reflect border handling.
       * The kernel must have compile-time dimensions.
       * @param img image which is convolved
@@ -9,6 +9,7 @@
 
 #include <limits>
 #include "nvision/src/core/image_type.h"
+#include "nvision/src/core/image_statistics.h"
 
 namespace nvision::image
 {
@@ -22,6 +23,20 @@ namespace nvision::image
         return img.unaryExpr([](const PixelType &p) { return pixel::convert<From, To>(p); });
     }
 
+    /** Extracts a single channel of the image as expression of plain scalars.
+      * Evaluating the expression into a scalar array yields a contiguous plane,
+      * which Eigen can process with vectorized operations.
+      * @param img image from which the channel is extracted
+      * @param idx index of the channel
+      * @return expression of the channel values */
+    template<typename Scalar, typename Derived>
+    inline decltype(auto) channel(const ImageBase<Derived> &img, const Index idx)
+    {
+        static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+        using PixelType = typename ImageBase<Derived>::Scalar;
+        return img.unaryExpr([idx](const PixelType &pixel) { return static_cast<Scalar>(pixel[idx]); });
+    }
+
     /** Clamps all values in the image to the given interval. */
     template<typename Derived>
     inline decltype(auto) clamp(const ImageBase<Derived> &img,
@@ -63,7 +78,7 @@ namespace nvision::image
         static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
         using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
 
-        constexpr auto minval = std::numeric_limits<typename ColorSpace::ValueType>::min();
+        constexpr auto minval = std::numeric_limits<typename ColorSpace::ValueType>::lowest();
         auto result = Pixel<ColorSpace>(minval);
 
         for(Index c = 0; c < img.cols(); ++c)
@@ -79,20 +94,24 @@ namespace nvision::image
         return result;
     }
 
-    /** Normalizes each channel of the given image to the given interval [minval, maxval]. */
+    /** Normalizes each channel of the given image to the value range of its color space.
+      * The minimum and maximum are determined in a single pass, the returned
+      * expression performs the second pass. */
     template<typename Derived>
     inline auto normalize(const ImageBase<Derived> &img)
     {
         static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
         using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
 
-        const auto oldMin = minimum(img);
-        const auto oldMax = maximum(img);
+        const auto stats = statistics(img);
+        const auto oldMin = stats.minimum();
+        const auto oldMax = stats.maximum();
 
         // precompute normalization factors
         auto factors = Eigen::Array<float32, ColorSpace::Dimension, 1>();
+        // constant channels are mapped to the minimum of the color space
         for(Index i = 0; i < ColorSpace::Dimension; ++i)
-            factors[i] = static_cast<float32>(ColorSpace::maximum[i] - ColorSpace::minimum[i]) / static_cast<float32>(oldMax[i] - oldMin[i]);
+            factors[i] = oldMax[i] == oldMin[i] ? float32{0} : static_cast<float32>(ColorSpace::maximum[i] - ColorSpace::minimum[i]) / static_cast<float32>(oldMax[i] - oldMin[i]);
 
         return img.unaryExpr([factors, oldMin, oldMax] (const auto &a) {
             Pixel<ColorSpace> result;
@@ -0,0 +1,90 @@
+/* image_histogram.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_HISTOGRAM_H_
+#define NVISION_IMAGE_HISTOGRAM_H_
+
+#include <vector>
+#include "nvision/src/core/image_type.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Histogram of an 8-bit image. Each column holds the 256 bins of a single channel. */
+    template<Index Dimension>
+    using Histogram8 = Eigen::Array<Index, 256, Dimension>;
+
+    namespace image
+    {
+        namespace internal
+        {
+            /** Computes the histogram of a single channel within the given block of an image.
+              * Consecutive pixels are counted in separate sub-histograms, such that
+              * increments of the same bin do not depend on each other and the
+              * store-to-load forwarding of one increment does not stall the next. */
+            template<typename Derived>
+            inline Eigen::Array<Index, 256, 1> histogram8(const ImageBase<Derived> &img,
+                                                          const Index channel,
+                                                          const Index row,
+                                                          const Index col,
+                                                          const Index rows,
+                                                          const Index cols)
+            {
+                constexpr Index SubHistograms = 4;
+                Eigen::Array<uint32, 256, SubHistograms> sub;
+                sub.setZero();
+
+                for(Index c = col; c < col + cols; ++c)
+                {
+                    Index r = row;
+                    for(; r + SubHistograms <= row + rows; r += SubHistograms)
+                    {
+                        ++sub(img(r, c)[channel], 0);
+                        ++sub(img(r + 1, c)[channel], 1);
+                        ++sub(img(r + 2, c)[channel], 2);
+                        ++sub(img(r + 3, c)[channel], 3);
+                    }
+                    for(; r < row + rows; ++r)
+                        ++sub(img(r, c)[channel], 0);
+                }
+
+                return sub.rowwise().sum().template cast<Index>();
+            }
+        }
+
+        /** Computes the histogram of each channel of an 8-bit image.
+          * The image is processed in parallel over bands of columns if OpenMP
+          * is enabled.
+          * @param img input image with 8-bit channels
+          * @return histogram with 256 bins for each channel */
+        template<typename Derived>
+        inline Histogram8<ImageDepth<ImageBase<Derived>>::value> histogram(const ImageBase<Derived> &img)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(std::is_same<typename ColorSpace::ValueType, uint8>::value, "histogram requires 8-bit channels");
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            constexpr Index bandCols = 64;
+            std::vector<Histogram8<Dimension>> bands(parallel::chunks(img.cols(), bandCols));
+
+            parallel::forChunks(img.cols(), bandCols, [&img, &bands](const Index band, const Index begin, const Index end)
+            {
+                for(Index d = 0; d < Dimension; ++d)
+                    bands[band].col(d) = internal::histogram8(img, d, 0, begin, img.rows(), end - begin);
+            });
+
+            Histogram8<Dimension> result;
+            result.setZero();
+            for(const auto &hist : bands)
+                result += hist;
+
+            return result;
+        }
+    }
+}
+
+#endif
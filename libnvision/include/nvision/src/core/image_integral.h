@@ -0,0 +1,229 @@
+/* image_integral.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_INTEGRAL_H_
+#define NVISION_IMAGE_INTEGRAL_H_
+
+#include <array>
+#include <type_traits>
+#include "nvision/src/core/image_type.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Type trait which determines the accumulator type of integral images.
+      * Integral values are accumulated in 64-bit integers, such that sums of
+      * squares of 16-bit images cannot overflow for any practical image size.
+      * Floating point values are accumulated in double precision. */
+    template<typename ColorSpace>
+    struct IntegralAccumulator
+    {
+        using type = std::conditional_t<std::is_integral<typename ColorSpace::ValueType>::value, int64, float64>;
+    };
+
+    /** Summed-area table of an image, which allows to compute the sum of any
+      * rectangular region in constant time.
+      *
+      * The tables are stored separately for each channel and have one
+      * additional leading row and column of zeros, i.e. the entry (r, c)
+      * holds the sum over all pixels above and left of (r, c) exclusively. */
+    template<typename _ColorSpace>
+    class IntegralImage
+    {
+    public:
+        using ColorSpace = _ColorSpace;
+        using Accumulator = typename IntegralAccumulator<ColorSpace>::type;
+        static constexpr Index Dimension = ColorSpace::Dimension;
+        using Table = Eigen::Array<Accumulator, Eigen::Dynamic, Eigen::Dynamic>;
+        using Channels = Eigen::Array<Accumulator, Dimension, 1>;
+
+        static_assert(IsColorSpace<ColorSpace>::value, "integral image must use a color space");
+
+        IntegralImage() = default;
+
+        /** Computes the integral image of the given image.
+          * @param img input image
+          * @param squared determines if the table of squared values is computed */
+        template<typename Derived>
+        explicit IntegralImage(const ImageBase<Derived> &img, const bool squared = true)
+        {
+            compute(img, squared);
+        }
+
+        /** Computes the integral image of the given image.
+          * The computation is split into two passes. The first pass computes
+          * the prefix sums along each column and runs in parallel over
+          * columns. The second pass adds up neighbouring columns, which Eigen
+          * vectorizes, and runs in parallel over bands of rows.
+          * @param img input image
+          * @param squared determines if the table of squared values is computed */
+        template<typename Derived>
+        void compute(const ImageBase<Derived> &img, const bool squared = true)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+            static_assert(std::is_same<typename ImageBase<Derived>::Scalar::ColorSpace, ColorSpace>::value, "image must have the same color space");
+
+            _rows = img.rows();
+            _cols = img.cols();
+            _squared = squared;
+
+            for(Index d = 0; d < Dimension; ++d)
+            {
+                _sum[d].resize(_rows + 1, _cols + 1);
+                _sum[d].row(0).setZero();
+                _sum[d].col(0).setZero();
+
+                if(squared)
+                {
+                    _sumSq[d].resize(_rows + 1, _cols + 1);
+                    _sumSq[d].row(0).setZero();
+                    _sumSq[d].col(0).setZero();
+                }
+                else
+                {
+                    _sumSq[d].resize(0, 0);
+                }
+            }
+
+            // first pass: prefix sums along the columns
+            parallel::forEach(0, _cols, [this, &img, squared](const Index c)
+            {
+                Channels sum = Channels::Zero();
+                Channels sumSq = Channels::Zero();
+                for(Index r = 0; r < _rows; ++r)
+                {
+                    const auto &pixel = img(r, c);
+                    for(Index d = 0; d < Dimension; ++d)
+                    {
+                        const auto value = static_cast<Accumulator>(pixel[d]);
+                        sum(d) += value;
+                        _sum[d](r + 1, c + 1) = sum(d);
+                    }
+
+                    if(squared)
+                    {
+                        for(Index d = 0; d < Dimension; ++d)
+                        {
+                            const auto value = static_cast<Accumulator>(pixel[d]);
+                            sumSq(d) += value * value;
+                            _sumSq[d](r + 1, c + 1) = sumSq(d);
+                        }
+                    }
+                }
+            });
+
+            // second pass: prefix sums along the rows
+            constexpr Index bandRows = 256;
+            parallel::forChunks(_rows + 1, bandRows, [this, squared](const Index, const Index begin, const Index end)
+            {
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    accumulateRows(_sum[d], begin, end);
+                    if(squared)
+                        accumulateRows(_sumSq[d], begin, end);
+                }
+            });
+        }
+
+        /** Returns the number of rows of the original image. */
+        Index rows() const
+        {
+            return _rows;
+        }
+
+        /** Returns the number of columns of the original image. */
+        Index cols() const
+        {
+            return _cols;
+        }
+
+        /** Returns the summed-area table of the given channel. */
+        const Table &sum(const Index channel) const
+        {
+            return _sum[channel];
+        }
+
+        /** Returns the summed-area table of the squared values of the given channel.
+          * The table is empty if squared values were not computed. */
+        const Table &sumSq(const Index channel) const
+        {
+            return _sumSq[channel];
+        }
+
+        /** Computes the sum of all pixels within the given rectangle for each
+          * channel in constant time. The rectangle must lie within the image.
+          * @param row top row of the rectangle
+          * @param col left column of the rectangle
+          * @param height number of rows of the rectangle
+          * @param width number of columns of the rectangle
+          * @return sum of each channel */
+        Channels boxSum(const Index row, const Index col, const Index height, const Index width) const
+        {
+            return boxSum(_sum, row, col, height, width);
+        }
+
+        /** Computes the sum of all squared pixels within the given rectangle
+          * for each channel in constant time. The rectangle must lie within
+          * the image.
+          * @param row top row of the rectangle
+          * @param col left column of the rectangle
+          * @param height number of rows of the rectangle
+          * @param width number of columns of the rectangle
+          * @return sum of squares of each channel */
+        Channels boxSumSq(const Index row, const Index col, const Index height, const Index width) const
+        {
+            assert(_squared);
+            return boxSum(_sumSq, row, col, height, width);
+        }
+
+    private:
+        Index _rows = 0;
+        Index _cols = 0;
+        bool _squared = false;
+        std::array<Table, Dimension> _sum = {};
+        std::array<Table, Dimension> _sumSq = {};
+
+        static void accumulateRows(Table &table, const Index begin, const Index end)
+        {
+            for(Index c = 1; c < table.cols(); ++c)
+                table.col(c).segment(begin, end - begin) += table.col(c - 1).segment(begin, end - begin);
+        }
+
+        Channels boxSum(const std::array<Table, Dimension> &tables,
+                        const Index row,
+                        const Index col,
+                        const Index height,
+                        const Index width) const
+        {
+            assert(row >= 0 && col >= 0 && height >= 0 && width >= 0);
+            assert(row + height <= _rows && col + width <= _cols);
+
+            Channels result;
+            for(Index d = 0; d < Dimension; ++d)
+            {
+                const auto &table = tables[d];
+                result(d) = table(row + height, col + width) - table(row, col + width)
+                          - table(row + height, col) + table(row, col);
+            }
+            return result;
+        }
+    };
+
+    namespace image
+    {
+        /** Computes the summed-area tables of the given image and its squared values.
+          * @param img input image
+          * @return integral image */
+        template<typename Derived>
+        inline IntegralImage<typename ImageBase<Derived>::Scalar::ColorSpace> integral(const ImageBase<Derived> &img)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+            return IntegralImage<typename ImageBase<Derived>::Scalar::ColorSpace>(img);
+        }
+    }
+}
+
+#endif
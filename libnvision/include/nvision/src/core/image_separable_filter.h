@@ -0,0 +1,286 @@
+/* image_separable_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_SEPARABLE_FILTER_H_
+#define NVISION_IMAGE_SEPARABLE_FILTER_H_
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "nvision/src/core/image_filter.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Compile-time descriptor of a one dimensional kernel with integral
+      * weights, which is centered at its middle element. */
+    template<int... Weights>
+    struct KernelTaps
+    {
+        static constexpr Index Size = sizeof...(Weights);
+        static_assert(Size % 2 == 1, "kernel taps must have odd size");
+
+        /** Returns the weight at the given offset from the center.
+          * Offsets outside of the kernel have zero weight. */
+        static constexpr int weight(const Index offset)
+        {
+            constexpr std::array<int, Size> weights = {Weights...};
+            const auto idx = offset + Size / 2;
+            return idx < 0 || idx >= Size ? 0 : weights[idx];
+        }
+    };
+
+    /** Compile-time descriptor of a separable kernel, which is the outer
+      * product of the vertical and the horizontal taps, e.g. the Sobel
+      * x-derivative is
+      *
+      * SeparableKernel<KernelTaps<1, 2, 1>, KernelTaps<-1, 0, 1>> */
+    template<typename _VerticalTaps, typename _HorizontalTaps>
+    struct SeparableKernel
+    {
+        using VerticalTaps = _VerticalTaps;
+        using HorizontalTaps = _HorizontalTaps;
+        static constexpr Index Rows = VerticalTaps::Size;
+        static constexpr Index Cols = HorizontalTaps::Size;
+
+        /** Returns the weight at the given offset from the center.
+          * Offsets outside of the kernel have zero weight. */
+        static constexpr int weight(const Index rowOffset, const Index colOffset)
+        {
+            return VerticalTaps::weight(rowOffset) * HorizontalTaps::weight(colOffset);
+        }
+    };
+}
+
+namespace nvision::image
+{
+    namespace internal
+    {
+        /** Adds values weighted by the given compile-time weight to result.
+          * Weights of +1 and -1 are applied as additions and subtractions. */
+        template<int Weight, typename Values>
+        inline void accumulateTap(Values &result, const Values &values)
+        {
+            using Scalar = typename Values::Scalar;
+            if constexpr (Weight == 1)
+                result += values;
+            else if constexpr (Weight == -1)
+                result -= values;
+            else
+                result += static_cast<Scalar>(Weight) * values;
+        }
+
+        template<typename Derived, typename Kernel, typename BorderHandling, typename Accumulator, typename OutputColorSpace>
+        class SeparableFilterFunctor;
+
+        /** Evaluates a separable compile-time kernel for each pixel.
+          * Taps with zero weight are skipped at compile time. The vertical
+          * taps are applied to each column of the neighbourhood first, then
+          * the column sums are combined by the horizontal taps. */
+        template<typename Derived, int... VerticalWeights, int... HorizontalWeights, typename BorderHandling, typename Accumulator, typename OutputColorSpace>
+        class SeparableFilterFunctor<Derived, SeparableKernel<KernelTaps<VerticalWeights...>, KernelTaps<HorizontalWeights...>>, BorderHandling, Accumulator, OutputColorSpace>
+        {
+        public:
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be a valid image type");
+            static_assert(IsColorSpace<OutputColorSpace>::value, "output must be a valid color space");
+
+            using PixelType = typename ImageBase<Derived>::Scalar;
+            using ColorSpace = typename PixelType::ColorSpace;
+            using OutputValueType = typename OutputColorSpace::ValueType;
+            static constexpr Index Dimension = ColorSpace::Dimension;
+            static constexpr Index KernelRows = sizeof...(VerticalWeights);
+            static constexpr Index KernelCols = sizeof...(HorizontalWeights);
+            using Values = Eigen::Array<Accumulator, Dimension, 1>;
+
+            static_assert(Dimension == OutputColorSpace::Dimension, "output must have the same number of channels");
+            static_assert(!std::is_integral<Accumulator>::value || std::is_integral<typename ColorSpace::ValueType>::value, "fixed point filtering requires integral image values");
+
+            SeparableFilterFunctor(const ImageBase<Derived> &img, const Index shift, const BorderHandling &handling)
+            : _img(img), _shift(static_cast<int>(shift)), _handling(handling)
+            { }
+
+            Pixel<OutputColorSpace> operator()(const Index row, const Index col) const
+            {
+                Values result = Values::Zero();
+                accumulateColumns(result, row, col, std::make_integer_sequence<Index, KernelCols>{});
+
+                Pixel<OutputColorSpace> resultPixel;
+                for(Index i = 0; i < Dimension; ++i)
+                {
+                    if constexpr (std::is_integral<Accumulator>::value)
+                        resultPixel[i] = fixedPointValue<OutputValueType>(result(i), _shift);
+                    else
+                        resultPixel[i] = static_cast<OutputValueType>(result(i));
+                }
+
+                return resultPixel;
+            }
+
+        private:
+            const ImageBase<Derived> &_img;
+            const int _shift;
+            const BorderHandling _handling;
+
+            template<Index... Offsets>
+            void accumulateColumns(Values &result, const Index row, const Index col, std::integer_sequence<Index, Offsets...>) const
+            {
+                (accumulateColumn<HorizontalWeights>(result, row, col + Offsets - KernelCols / 2), ...);
+            }
+
+            template<int Weight>
+            void accumulateColumn(Values &result, const Index row, const Index col) const
+            {
+                if constexpr (Weight != 0)
+                {
+                    Values column = Values::Zero();
+                    accumulateRows(column, row, col, std::make_integer_sequence<Index, KernelRows>{});
+                    accumulateTap<Weight>(result, column);
+                }
+            }
+
+            template<Index... Offsets>
+            void accumulateRows(Values &column, const Index row, const Index col, std::integer_sequence<Index, Offsets...>) const
+            {
+                (accumulatePixel<VerticalWeights>(column, row + Offsets - KernelRows / 2, col), ...);
+            }
+
+            template<int Weight>
+            void accumulatePixel(Values &column, const Index row, const Index col) const
+            {
+                if constexpr (Weight != 0)
+                {
+                    const auto &pixel = _handling(_img, row, col);
+                    Values values;
+                    for(Index i = 0; i < Dimension; ++i)
+                        values(i) = static_cast<Accumulator>(pixel[i]);
+                    accumulateTap<Weight>(column, values);
+                }
+            }
+        };
+
+        /** Evaluates two compile-time kernels of the same image for each
+          * pixel, e.g. the x and y derivative. Each pixel of the union of
+          * both neighbourhoods is read only once, taps with zero weight in
+          * both kernels are skipped at compile time. */
+        template<typename Derived, typename KernelX, typename KernelY, typename BorderHandling, typename Accumulator>
+        class GradientFunctor
+        {
+        public:
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be a valid image type");
+
+            using PixelType = typename ImageBase<Derived>::Scalar;
+            using ColorSpace = typename PixelType::ColorSpace;
+            static constexpr Index Dimension = ColorSpace::Dimension;
+            static constexpr Index KernelRows = std::max(KernelX::Rows, KernelY::Rows);
+            static constexpr Index KernelCols = std::max(KernelX::Cols, KernelY::Cols);
+            using Values = Eigen::Array<Accumulator, Dimension, 1>;
+
+            GradientFunctor(const ImageBase<Derived> &img, const BorderHandling &handling)
+            : _img(img), _handling(handling)
+            { }
+
+            void operator()(const Index row, const Index col, Values &gradX, Values &gradY) const
+            {
+                gradX.setZero();
+                gradY.setZero();
+                accumulate(gradX, gradY, row, col, std::make_integer_sequence<Index, KernelRows * KernelCols>{});
+            }
+
+        private:
+            const ImageBase<Derived> &_img;
+            const BorderHandling _handling;
+
+            template<Index... Indices>
+            void accumulate(Values &gradX, Values &gradY, const Index row, const Index col, std::integer_sequence<Index, Indices...>) const
+            {
+                (accumulatePixel<Indices % KernelRows - KernelRows / 2, Indices / KernelRows - KernelCols / 2>(gradX, gradY, row, col), ...);
+            }
+
+            template<Index RowOffset, Index ColOffset>
+            void accumulatePixel(Values &gradX, Values &gradY, const Index row, const Index col) const
+            {
+                constexpr auto weightX = KernelX::weight(RowOffset, ColOffset);
+                constexpr auto weightY = KernelY::weight(RowOffset, ColOffset);
+
+                if constexpr (weightX != 0 || weightY != 0)
+                {
+                    const auto &pixel = _handling(_img, row + RowOffset, col + ColOffset);
+                    Values values;
+                    for(Index i = 0; i < Dimension; ++i)
+                        values(i) = static_cast<Accumulator>(pixel[i]);
+
+                    if constexpr (weightX != 0)
+                        accumulateTap<weightX>(gradX, values);
+                    if constexpr (weightY != 0)
+                        accumulateTap<weightY>(gradY, values);
+                }
+            }
+        };
+    }
+
+    /** Computes the responses of two compile-time kernels, typically the x
+      * and y derivative, in a single sweep over the image and passes them to
+      * func(row, col, gradX, gradY) for each pixel.
+      * The responses are passed as accumulated values, i.e. as
+      * Eigen::Array<Accumulator, Dimension, 1>, before any conversion to the
+      * value type of the image. The sweep runs in parallel over columns, so
+      * func must be safe to call concurrently for different pixels.
+      * @param img image which is convolved
+      * @param handling border handling that is used for convolving
+      * @param func functor which receives the responses of each pixel */
+    template<typename KernelX, typename KernelY, typename Accumulator, typename Derived, typename BorderHandling, typename Func>
+    void forEachGradient(const ImageBase<Derived> &img, const BorderHandling &handling, Func &&func)
+    {
+        using Functor = internal::GradientFunctor<Derived, KernelX, KernelY, BorderHandling, Accumulator>;
+        const Functor functor(img, handling);
+
+        parallel::forEach(0, img.cols(), [&func, &img, functor](const Index c)
+        {
+            typename Functor::Values gradX;
+            typename Functor::Values gradY;
+            for(Index r = 0; r < img.rows(); ++r)
+            {
+                functor(r, c, gradX, gradY);
+                func(r, c, gradX, gradY);
+            }
+        });
+    }
+
+    /** Convolves an image with the given compile-time separable kernel.
+      * In contrast to filter() the taps of the kernel are known at compile
+      * time, such that zero taps are skipped and unit taps are applied as
+      * additions and subtractions.
+      * @param img image which is convolved
+      * @param handling border handling that is used for convolving
+      * @return expression of the convolution */
+    template<typename Kernel, typename KernelScalar, typename Derived, typename BorderHandling>
+    auto filterSeparable(const ImageBase<Derived> &img, const BorderHandling &handling)
+    {
+        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "kernel must have floating point scalars");
+        using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+        const auto functor = internal::SeparableFilterFunctor<Derived, Kernel, BorderHandling, KernelScalar, ColorSpace>(img, 0, handling);
+        return ImageBase<Derived>::NullaryExpr(img.rows(), img.cols(), functor);
+    }
+
+    /** Convolves an image with integral values with the given compile-time
+      * separable kernel in fixed point arithmetic.
+      * The products are accumulated in 32-bit integers. The result is
+      * divided by 2^shift with rounding and saturated to the value range of
+      * the output color space.
+      * @param img image which is convolved
+      * @param shift number of bits by which the results are shifted right
+      * @param handling border handling that is used for convolving
+      * @return expression of the convolution */
+    template<typename Kernel, typename OutputColorSpace, typename Derived, typename BorderHandling>
+    auto filterSeparableFixedPoint(const ImageBase<Derived> &img, const Index shift, const BorderHandling &handling)
+    {
+        assert(shift >= 0 && shift < 31);
+        const auto functor = internal::SeparableFilterFunctor<Derived, Kernel, BorderHandling, int32, OutputColorSpace>(img, shift, handling);
+        return Image<OutputColorSpace>::NullaryExpr(img.rows(), img.cols(), functor);
+    }
+}
+
+#endif
@@ -0,0 +1,264 @@
+/* image_statistics.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_STATISTICS_H_
+#define NVISION_IMAGE_STATISTICS_H_
+
+#include <limits>
+#include <vector>
+#include "nvision/src/core/image_type.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Accumulated per channel statistics of an image.
+      * Minimum, maximum, sum, sum of squares and optionally a histogram are
+      * accumulated together, such that all of them require only a single
+      * pass over the image. */
+    template<typename _ColorSpace>
+    class ImageStatistics
+    {
+    public:
+        using ColorSpace = _ColorSpace;
+        using ValueType = typename ColorSpace::ValueType;
+        static constexpr Index Dimension = ColorSpace::Dimension;
+        using Channels = Eigen::Array<float64, Dimension, 1>;
+        using Histogram = Eigen::Array<Index, Eigen::Dynamic, Dimension>;
+
+        static_assert(IsColorSpace<ColorSpace>::value, "statistics must use a color space");
+
+        ImageStatistics()
+            : ImageStatistics(0)
+        { }
+
+        /** Creates empty statistics.
+          * @param bins number of histogram bins per channel, which cover the
+          *        value range of the color space; no histogram is computed if 0 */
+        ImageStatistics(const Index bins)
+            : _minimum(std::numeric_limits<ValueType>::max()),
+            _maximum(std::numeric_limits<ValueType>::lowest()),
+            _histogram(Histogram::Zero(bins, Dimension))
+        {
+            _sum.setZero();
+            _sumSq.setZero();
+
+            for(Index i = 0; i < Dimension; ++i)
+            {
+                const auto minval = static_cast<float64>(ColorSpace::minimum[i]);
+                const auto maxval = static_cast<float64>(ColorSpace::maximum[i]);
+                // integral color spaces map each value to its own bin if
+                // there are as many bins as values
+                const auto range = std::numeric_limits<ValueType>::is_integer ? maxval - minval + 1 : maxval - minval;
+                _binOffset(i) = minval;
+                _binFactor(i) = static_cast<float64>(bins) / range;
+            }
+        }
+
+        /** Adds a single pixel to the statistics. */
+        void add(const Pixel<ColorSpace> &pixel)
+        {
+            for(Index i = 0; i < Dimension; ++i)
+            {
+                const auto value = static_cast<float64>(pixel[i]);
+                _minimum[i] = std::min(_minimum[i], pixel[i]);
+                _maximum[i] = std::max(_maximum[i], pixel[i]);
+                _sum(i) += value;
+                _sumSq(i) += value * value;
+            }
+
+            if(_histogram.rows() > 0)
+            {
+                for(Index i = 0; i < Dimension; ++i)
+                {
+                    const auto bin = static_cast<Index>((static_cast<float64>(pixel[i]) - _binOffset(i)) * _binFactor(i));
+                    ++_histogram(clamp<Index>(bin, 0, _histogram.rows() - 1), i);
+                }
+            }
+
+            ++_count;
+        }
+
+        /** Merges the given statistics into these statistics.
+          * Both have to use the same number of histogram bins. */
+        void merge(const ImageStatistics<ColorSpace> &other)
+        {
+            assert(_histogram.rows() == other._histogram.rows());
+
+            for(Index i = 0; i < Dimension; ++i)
+            {
+                _minimum[i] = std::min(_minimum[i], other._minimum[i]);
+                _maximum[i] = std::max(_maximum[i], other._maximum[i]);
+            }
+
+            _sum += other._sum;
+            _sumSq += other._sumSq;
+            _histogram += other._histogram;
+            _count += other._count;
+        }
+
+        /** Returns the number of accumulated pixels. */
+        Index count() const
+        {
+            return _count;
+        }
+
+        const Pixel<ColorSpace> &minimum() const
+        {
+            return _minimum;
+        }
+
+        const Pixel<ColorSpace> &maximum() const
+        {
+            return _maximum;
+        }
+
+        const Channels &sum() const
+        {
+            return _sum;
+        }
+
+        const Channels &sumSq() const
+        {
+            return _sumSq;
+        }
+
+        /** Returns the histogram, where each column holds the bins of one channel. */
+        const Histogram &histogram() const
+        {
+            return _histogram;
+        }
+
+        Channels mean() const
+        {
+            return _count > 0 ? Channels(_sum / static_cast<float64>(_count)) : Channels(Channels::Zero());
+        }
+
+        /** Computes the population variance of each channel. */
+        Channels variance() const
+        {
+            if(_count == 0)
+                return Channels::Zero();
+
+            const Channels avg = mean();
+            return (_sumSq / static_cast<float64>(_count) - avg * avg).max(float64{0});
+        }
+
+        Channels stddev() const
+        {
+            return variance().sqrt();
+        }
+
+    private:
+        Pixel<ColorSpace> _minimum;
+        Pixel<ColorSpace> _maximum;
+        Channels _sum = {};
+        Channels _sumSq = {};
+        Histogram _histogram;
+        Channels _binOffset = {};
+        Channels _binFactor = {};
+        Index _count = 0;
+    };
+
+    namespace image
+    {
+        namespace internal
+        {
+            struct NoMask
+            {
+                bool operator()(const Index, const Index) const
+                {
+                    return true;
+                }
+            };
+
+            template<typename Derived>
+            class ImageMask
+            {
+            public:
+                static_assert(IsImage<ImageBase<Derived>>::value, "mask must be a valid image type");
+
+                ImageMask(const ImageBase<Derived> &mask)
+                    : _mask(mask)
+                { }
+
+                bool operator()(const Index row, const Index col) const
+                {
+                    return _mask(row, col)[0] != 0;
+                }
+            private:
+                const ImageBase<Derived> &_mask;
+            };
+
+            template<typename Derived, typename Mask>
+            inline ImageStatistics<typename ImageBase<Derived>::Scalar::ColorSpace> statistics(const ImageBase<Derived> &img,
+                                                                                                const Mask &mask,
+                                                                                                const Index bins)
+            {
+                using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+
+                // partition the image in bands of columns, the partial results
+                // are merged in band order, which keeps the results independent
+                // of the number of threads
+                constexpr Index bandCols = 32;
+                std::vector<ImageStatistics<ColorSpace>> bands(parallel::chunks(img.cols(), bandCols), ImageStatistics<ColorSpace>(bins));
+
+                parallel::forChunks(img.cols(), bandCols, [&img, &mask, &bands](const Index band, const Index begin, const Index end)
+                {
+                    auto &stats = bands[band];
+                    for(Index c = begin; c < end; ++c)
+                    {
+                        for(Index r = 0; r < img.rows(); ++r)
+                        {
+                            if(mask(r, c))
+                                stats.add(img(r, c));
+                        }
+                    }
+                });
+
+                auto result = ImageStatistics<ColorSpace>(bins);
+                for(const auto &stats : bands)
+                    result.merge(stats);
+
+                return result;
+            }
+        }
+
+        /** Computes minimum, maximum, sum, sum of squares and optionally a
+          * histogram of each channel in a single pass over the image.
+          * The image is processed in parallel if OpenMP is enabled.
+          * @param img input image
+          * @param bins number of histogram bins, no histogram is computed if 0
+          * @return accumulated statistics */
+        template<typename Derived>
+        inline ImageStatistics<typename ImageBase<Derived>::Scalar::ColorSpace> statistics(const ImageBase<Derived> &img,
+                                                                                            const Index bins = 0)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+            return internal::statistics(img, internal::NoMask{}, bins);
+        }
+
+        /** Computes minimum, maximum, sum, sum of squares and optionally a
+          * histogram of each channel in a single pass over the image.
+          * Only pixels, whose first mask channel is non-zero, are considered.
+          * The image is processed in parallel if OpenMP is enabled.
+          * @param img input image
+          * @param mask mask image with the same size as the input image
+          * @param bins number of histogram bins, no histogram is computed if 0
+          * @return accumulated statistics */
+        template<typename Derived, typename DerivedMask>
+        inline ImageStatistics<typename ImageBase<Derived>::Scalar::ColorSpace> statistics(const ImageBase<Derived> &img,
+                                                                                            const ImageBase<DerivedMask> &mask,
+                                                                                            const Index bins = 0)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "input must be a valid image type");
+            assert(img.rows() == mask.rows());
+            assert(img.cols() == mask.cols());
+            return internal::statistics(img, internal::ImageMask<DerivedMask>(mask), bins);
+        }
+    }
+}
+
+#endif
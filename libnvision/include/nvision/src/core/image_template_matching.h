@@ -0,0 +1,463 @@
+/* image_template_matching.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_IMAGE_TEMPLATE_MATCHING_H_
+#define NVISION_IMAGE_TEMPLATE_MATCHING_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "nvision/src/core/math.h"
+#include "nvision/src/core/image_type.h"
+#include "nvision/src/core/image_integral.h"
+#include "nvision/src/core/image_pyramid.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    struct MatchScore
+    {
+        /** Sum of squared differences, lower is better. */
+        struct SSD {};
+        /** Sum of absolute differences, lower is better. */
+        struct SAD {};
+        /** Zero-mean normalized cross-correlation in [-1, 1], higher is better. */
+        struct ZNCC {};
+    };
+
+    /** Position of a template within an image. The position refers to the
+      * top left pixel of the template. */
+    template<typename _Scalar>
+    struct TemplateMatch
+    {
+        using Scalar = _Scalar;
+
+        Index row;
+        Index col;
+        Scalar score;
+    };
+
+    namespace image
+    {
+        namespace internal
+        {
+            template<typename Scalar>
+            inline bool isBetterMatch(const Scalar lhs, const Scalar rhs, const MatchScore::SSD &)
+            {
+                return lhs < rhs;
+            }
+
+            template<typename Scalar>
+            inline bool isBetterMatch(const Scalar lhs, const Scalar rhs, const MatchScore::SAD &)
+            {
+                return lhs < rhs;
+            }
+
+            template<typename Scalar>
+            inline bool isBetterMatch(const Scalar lhs, const Scalar rhs, const MatchScore::ZNCC &)
+            {
+                return lhs > rhs;
+            }
+
+            /** Sorts the given candidates from best to worst and selects at
+              * most count of them, which keep a distance of at least
+              * minDistance to all better ones. Equal positions are never
+              * selected twice. */
+            template<typename Scalar, typename Score>
+            inline std::vector<TemplateMatch<Scalar>> selectMatches(std::vector<TemplateMatch<Scalar>> &candidates,
+                                                                    const Index count,
+                                                                    const Index minDistance,
+                                                                    const Score &score)
+            {
+                using Match = TemplateMatch<Scalar>;
+
+                std::stable_sort(candidates.begin(), candidates.end(), [&score](const Match &lhs, const Match &rhs)
+                {
+                    return isBetterMatch(lhs.score, rhs.score, score);
+                });
+
+                std::vector<Match> result;
+                const auto minDistSq = std::max<Index>(1, minDistance * minDistance);
+                for(const auto &candidate : candidates)
+                {
+                    if(static_cast<Index>(result.size()) >= count)
+                        break;
+
+                    const auto isolated = std::all_of(result.begin(), result.end(), [&](const Match &match)
+                    {
+                        const auto dr = match.row - candidate.row;
+                        const auto dc = match.col - candidate.col;
+                        return dr * dr + dc * dc >= minDistSq;
+                    });
+
+                    if(isolated)
+                        result.push_back(candidate);
+                }
+
+                return result;
+            }
+
+            /** Computes the score of a template at any position of an image.
+              *
+              * Image and template are stored as planes of scalars per channel,
+              * such that Eigen vectorizes the sums over the template area.
+              * For ZNCC the template is stored zero-mean, so the numerator
+              * is a plain cross-correlation, and the sums of the image values
+              * and their squares for the denominator are looked up from an
+              * integral image. Multiple channels are treated as a single
+              * vector of values. */
+            template<typename Scalar, typename ColorSpace, typename Score>
+            class TemplateScorer
+            {
+            public:
+                static constexpr Index Dimension = ColorSpace::Dimension;
+                using Plane = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+                template<typename Derived, typename DerivedTemplate>
+                TemplateScorer(const ImageBase<Derived> &img, const ImageBase<DerivedTemplate> &templ)
+                {
+                    assert(templ.rows() > 0 && templ.cols() > 0);
+                    assert(templ.rows() <= img.rows() && templ.cols() <= img.cols());
+
+                    toPlanes(img, _image);
+                    toPlanes(templ, _template);
+
+                    if constexpr (std::is_same<Score, MatchScore::ZNCC>::value)
+                    {
+                        _integral.compute(img, true);
+
+                        _templateVariance = 0;
+                        for(auto &plane : _template)
+                        {
+                            plane -= plane.mean();
+                            _templateVariance += static_cast<float64>(plane.square().sum());
+                        }
+                    }
+                }
+
+                /** Returns the number of rows of valid template positions. */
+                Index rows() const
+                {
+                    return _image[0].rows() - _template[0].rows() + 1;
+                }
+
+                /** Returns the number of columns of valid template positions. */
+                Index cols() const
+                {
+                    return _image[0].cols() - _template[0].cols() + 1;
+                }
+
+                /** Computes the score of the template with its top left pixel
+                  * at the given position. */
+                Scalar operator()(const Index row, const Index col) const
+                {
+                    const auto height = _template[0].rows();
+                    const auto width = _template[0].cols();
+
+                    if constexpr (std::is_same<Score, MatchScore::SSD>::value)
+                    {
+                        Scalar result = 0;
+                        for(Index d = 0; d < Dimension; ++d)
+                            result += (_image[d].block(row, col, height, width) - _template[d]).square().sum();
+                        return result;
+                    }
+                    else if constexpr (std::is_same<Score, MatchScore::SAD>::value)
+                    {
+                        Scalar result = 0;
+                        for(Index d = 0; d < Dimension; ++d)
+                            result += (_image[d].block(row, col, height, width) - _template[d]).abs().sum();
+                        return result;
+                    }
+                    else
+                    {
+                        float64 numerator = 0;
+                        for(Index d = 0; d < Dimension; ++d)
+                            numerator += static_cast<float64>((_image[d].block(row, col, height, width) * _template[d]).sum());
+
+                        const auto count = static_cast<float64>(height * width);
+                        const auto sum = _integral.boxSum(row, col, height, width);
+                        const auto sumSq = _integral.boxSumSq(row, col, height, width);
+                        float64 variance = 0;
+                        for(Index d = 0; d < Dimension; ++d)
+                        {
+                            const auto s = static_cast<float64>(sum(d));
+                            variance += static_cast<float64>(sumSq(d)) - s * s / count;
+                        }
+
+                        // flat regions or templates have no defined correlation
+                        const auto denominator = std::sqrt(std::max<float64>(0, variance) * _templateVariance);
+                        if(denominator <= 1e-9 * count)
+                            return Scalar{0};
+
+                        return static_cast<Scalar>(nvision::clamp<float64>(numerator / denominator, -1, 1));
+                    }
+                }
+
+            private:
+                std::array<Plane, Dimension> _image = {};
+                std::array<Plane, Dimension> _template = {};
+                IntegralImage<ColorSpace> _integral = {};
+                float64 _templateVariance = 0;
+
+                template<typename Derived>
+                static void toPlanes(const ImageBase<Derived> &img, std::array<Plane, Dimension> &planes)
+                {
+                    for(Index d = 0; d < Dimension; ++d)
+                    {
+                        planes[d].resize(img.rows(), img.cols());
+                        for(Index c = 0; c < img.cols(); ++c)
+                            for(Index r = 0; r < img.rows(); ++r)
+                                planes[d](r, c) = static_cast<Scalar>(img(r, c)[d]);
+                    }
+                }
+            };
+        }
+
+        /** Computes the score of the template at every position within the
+          * image. The entry (r, c) of the result holds the score of the
+          * template with its top left pixel at (r, c). The computation runs
+          * in parallel over columns.
+          * @param img image which is searched
+          * @param templ template which is searched for; must not be larger than the image
+          * @param score score type; SSD, SAD or ZNCC
+          * @return (rows - templ.rows + 1) x (cols - templ.cols + 1) matrix of scores */
+        template<typename Scalar=float32, typename Derived, typename DerivedTemplate, typename Score>
+        Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic> matchTemplate(const ImageBase<Derived> &img,
+                                                                           const ImageBase<DerivedTemplate> &templ,
+                                                                           const Score &)
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            static_assert(IsImage<ImageBase<DerivedTemplate>>::value, "template must be image type");
+            static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(std::is_same<ColorSpace, typename ImageBase<DerivedTemplate>::Scalar::ColorSpace>::value, "template must have the same color space");
+
+            const auto scorer = internal::TemplateScorer<Scalar, ColorSpace, Score>(img, templ);
+            Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic> scores(scorer.rows(), scorer.cols());
+            parallel::forEach(0, scores.cols(), [&](const Index c)
+            {
+                for(Index r = 0; r < scores.rows(); ++r)
+                    scores(r, c) = scorer(r, c);
+            });
+
+            return scores;
+        }
+
+        /** Extracts the best local extrema of a score matrix.
+          * A position is a candidate if no score in its 3x3 neighbourhood is
+          * better. Candidates are selected from best to worst and discarded
+          * if they lie within minDistance of an already selected match.
+          * @param scores score matrix as computed by matchTemplate()
+          * @param count maximum number of matches
+          * @param minDistance minimum euclidean distance between matches
+          * @param score score type, which determines if lower or higher is better
+          * @return matches sorted from best to worst */
+        template<typename Derived, typename Score>
+        std::vector<TemplateMatch<typename Derived::Scalar>> findMatches(const Eigen::DenseBase<Derived> &scores,
+                                                                         const Index count,
+                                                                         const Index minDistance,
+                                                                         const Score &score)
+        {
+            using Scalar = typename Derived::Scalar;
+            using Match = TemplateMatch<Scalar>;
+
+            std::vector<Match> candidates;
+            for(Index c = 0; c < scores.cols(); ++c)
+            {
+                for(Index r = 0; r < scores.rows(); ++r)
+                {
+                    const auto value = scores(r, c);
+                    bool extremum = true;
+                    for(Index dc = -1; dc <= 1 && extremum; ++dc)
+                    {
+                        for(Index dr = -1; dr <= 1 && extremum; ++dr)
+                        {
+                            const auto row = r + dr;
+                            const auto col = c + dc;
+                            if(row >= 0 && row < scores.rows() && col >= 0 && col < scores.cols())
+                                extremum = !internal::isBetterMatch(scores(row, col), value, score);
+                        }
+                    }
+
+                    if(extremum)
+                        candidates.push_back({r, c, value});
+                }
+            }
+
+            return internal::selectMatches(candidates, count, minDistance, score);
+        }
+    }
+
+    /** Functor, which localizes the best matches of a template within an
+      * image by a coarse-to-fine search.
+      *
+      * Image and template are downsampled by a factor of two per pyramid
+      * level. The scores are computed densely on the coarsest level only,
+      * its best matches are then refined on each finer level within a
+      * small search window around the upsampled positions. The levels are
+      * reduced automatically, such that the template keeps a size of at
+      * least minTemplateSize() pixels on the coarsest level. */
+    template<typename _Scalar, typename _Score=MatchScore::ZNCC>
+    class TemplateMatcher
+    {
+    public:
+        using Scalar = _Scalar;
+        using Score = _Score;
+        using Match = TemplateMatch<Scalar>;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        TemplateMatcher() = default;
+
+        /** Construct a template matcher with custom parameters.
+          * @param levels maximum number of pyramid levels
+          * @param maxMatches maximum number of matches that are returned
+          * @param minDistance minimum distance between matches in pixels */
+        TemplateMatcher(const Index levels, const Index maxMatches, const Index minDistance)
+        {
+            setLevels(levels);
+            setMaxMatches(maxMatches);
+            setMinDistance(minDistance);
+        }
+
+        void setLevels(const Index levels)
+        {
+            assert(levels > 0);
+            _levels = levels;
+        }
+
+        void setMaxMatches(const Index maxMatches)
+        {
+            assert(maxMatches > 0);
+            _maxMatches = maxMatches;
+        }
+
+        void setMinDistance(const Index minDistance)
+        {
+            assert(minDistance >= 0);
+            _minDistance = minDistance;
+        }
+
+        /** Sets the radius of the search window in which matches are
+          * refined on each finer pyramid level. */
+        void setSearchRadius(const Index radius)
+        {
+            assert(radius > 0);
+            _searchRadius = radius;
+        }
+
+        /** Sets the minimum size of the template on the coarsest level. */
+        void setMinTemplateSize(const Index size)
+        {
+            assert(size > 0);
+            _minTemplateSize = size;
+        }
+
+        Index levels() const
+        {
+            return _levels;
+        }
+
+        Index maxMatches() const
+        {
+            return _maxMatches;
+        }
+
+        Index minDistance() const
+        {
+            return _minDistance;
+        }
+
+        Index searchRadius() const
+        {
+            return _searchRadius;
+        }
+
+        Index minTemplateSize() const
+        {
+            return _minTemplateSize;
+        }
+
+        /** Searches the template in the given image.
+          * @param img image which is searched
+          * @param templ template which is searched for; must not be larger than the image
+          * @return matches on the original image sorted from best to worst */
+        template<typename Derived, typename DerivedTemplate>
+        std::vector<Match> operator()(const ImageBase<Derived> &img, const ImageBase<DerivedTemplate> &templ) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            static_assert(IsImage<ImageBase<DerivedTemplate>>::value, "template must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using Scorer = image::internal::TemplateScorer<Scalar, ColorSpace, Score>;
+
+            Index levels = 1;
+            while(levels < _levels && (std::min(templ.rows(), templ.cols()) >> levels) >= _minTemplateSize)
+                ++levels;
+
+            if(levels == 1)
+            {
+                const auto scores = image::matchTemplate<Scalar>(img, templ, Score{});
+                return image::findMatches(scores, _maxMatches, _minDistance, Score{});
+            }
+
+            const auto images = ImagePyramid<Scalar, ColorSpace>(img, levels, Scalar{0.5});
+            const auto templates = ImagePyramid<Scalar, ColorSpace>(templ, levels, Scalar{0.5});
+
+            // dense search on the coarsest level, keep more candidates than
+            // requested, since the ranking may change on finer levels
+            const auto coarsest = levels - 1;
+            const auto coarseScale = images.levels()[coarsest].scaleX;
+            const auto coarseDistance = static_cast<Index>(static_cast<Scalar>(_minDistance) * coarseScale);
+            const auto scores = image::matchTemplate<Scalar>(images.images()[coarsest], templates.images()[coarsest], Score{});
+            auto matches = image::findMatches(scores, 4 * _maxMatches, coarseDistance, Score{});
+
+            for(Index level = coarsest - 1; level >= 0; --level)
+            {
+                const auto scorer = Scorer(images.images()[level], templates.images()[level]);
+                const auto ratio = images.levels()[level].scaleX / images.levels()[level + 1].scaleX;
+
+                parallel::forEach(0, static_cast<Index>(matches.size()), [&](const Index idx)
+                {
+                    // clamp the center, such that the search window always
+                    // contains at least one position
+                    auto &match = matches[idx];
+                    const auto centerRow = std::clamp<Index>(static_cast<Index>(std::round(static_cast<Scalar>(match.row) * ratio)), 0, scorer.rows() - 1);
+                    const auto centerCol = std::clamp<Index>(static_cast<Index>(std::round(static_cast<Scalar>(match.col) * ratio)), 0, scorer.cols() - 1);
+                    const auto minRow = std::max<Index>(0, centerRow - _searchRadius);
+                    const auto maxRow = std::min<Index>(scorer.rows() - 1, centerRow + _searchRadius);
+                    const auto minCol = std::max<Index>(0, centerCol - _searchRadius);
+                    const auto maxCol = std::min<Index>(scorer.cols() - 1, centerCol + _searchRadius);
+
+                    Match best = {-1, -1, Scalar{0}};
+                    for(Index c = minCol; c <= maxCol; ++c)
+                    {
+                        for(Index r = minRow; r <= maxRow; ++r)
+                        {
+                            const auto value = scorer(r, c);
+                            if(best.row < 0 || image::internal::isBetterMatch(value, best.score, Score{}))
+                                best = {r, c, value};
+                        }
+                    }
+
+                    match = best;
+                });
+            }
+
+            // candidates may have converged to the same position
+            return image::internal::selectMatches(matches, _maxMatches, _minDistance, Score{});
+        }
+
+    private:
+        Index _levels = 3;
+        Index _maxMatches = 1;
+        Index _minDistance = 8;
+        Index _searchRadius = 2;
+        Index _minTemplateSize = 8;
+    };
+}
+
+#endif
@@ -7,46 +7,52 @@
 #ifndef NVISION_IMAGE_TYPE_H_
 #define NVISION_IMAGE_TYPE_H_
 
+#include <type_traits>
 #include <Eigen/Core>
 #include "nvision/src/core/pixel.h"
 
+// restricts the scalar operators to pixel images, such that plain scalar
+// arrays keep using the vectorized operators of Eigen
+#define NVISION_ENABLE_IF_IMAGE(Derived) \
+    std::enable_if_t<IsPixel<typename ImageBase<Derived>::Scalar>::value, int> = 0
+
 #define NVISION_GEN_SCALAR_OPERATORS(Scalar)\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator+(const ImageBase<Derived> &lhs, const Scalar rhs)\
     {\
         return lhs.unaryExpr([rhs](const auto &pixel) { return pixel + rhs; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator+(const Scalar lhs, const ImageBase<Derived> &rhs)\
     {\
         return rhs.unaryExpr([lhs](const auto &pixel) { return lhs + pixel; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator-(const ImageBase<Derived> &lhs, const Scalar rhs)\
     {\
         return lhs.unaryExpr([rhs](const auto &pixel) { return pixel - rhs; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator-(const Scalar lhs, const ImageBase<Derived> &rhs)\
     {\
         return rhs.unaryExpr([lhs](const auto &pixel) { return lhs - pixel; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator*(const ImageBase<Derived> &lhs, const Scalar rhs)\
     {\
         return lhs.unaryExpr([rhs](const auto &pixel) { return pixel * rhs; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator*(const Scalar lhs, const ImageBase<Derived> &rhs)\
     {\
         return rhs.unaryExpr([lhs](const auto &pixel) { return lhs * pixel; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator/(const ImageBase<Derived> &lhs, const Scalar rhs)\
     {\
         return lhs.unaryExpr([rhs](const auto &pixel) { return pixel / rhs; });\
     }\
-    template<typename Derived>\
+    template<typename Derived, NVISION_ENABLE_IF_IMAGE(Derived)>\
     inline decltype(auto) operator/(const Scalar lhs, const ImageBase<Derived> &rhs)\
     {\
         return rhs.unaryExpr([lhs](const auto &pixel) { return lhs / pixel; });\
@@ -8,6 +8,8 @@
 #define NVISION_MATH_H_
 
 #include <cmath>
+#include <algorithm>
+#include <limits>
 #include <type_traits>
 
 namespace nvision
@@ -25,6 +27,68 @@ namespace nvision
         return std::min(maxval, std::max(minval, value));
     }
 
+    /** Converts a floating point value to the given value type. If the
+      * value type is integral, the value is rounded to the nearest integer
+      * and saturated to the range of the value type, otherwise it is cast
+      * directly. */
+    template<typename ValueType, typename Scalar>
+    inline ValueType roundCast(const Scalar value)
+    {
+        if constexpr (std::is_integral<ValueType>::value)
+        {
+            constexpr auto minval = static_cast<Scalar>(std::numeric_limits<ValueType>::lowest());
+            constexpr auto maxval = static_cast<Scalar>(std::numeric_limits<ValueType>::max());
+            return static_cast<ValueType>(std::round(clamp(value, minval, maxval)));
+        }
+        else
+        {
+            return static_cast<ValueType>(value);
+        }
+    }
+
+    /** Computes an approximation of atan2(y, x) with a polynomial on the first
+      * octant. The maximum absolute error is about 1e-5 radians.
+      * @return angle in the interval [-pi, pi] */
+    template<typename Scalar>
+    inline Scalar fastAtan2(const Scalar y, const Scalar x)
+    {
+        static_assert(std::is_floating_point<Scalar>::value, "fastAtan2 must use floating point");
+
+        const auto ax = std::abs(x);
+        const auto ay = std::abs(y);
+        const auto maxval = std::max(ax, ay);
+        if(maxval == Scalar{0})
+            return Scalar{0};
+
+        const auto a = std::min(ax, ay) / maxval;
+        const auto s = a * a;
+        // see Abramowitz and Stegun, formula 4.4.49
+        auto result = a * (static_cast<Scalar>(0.9998660) + s * (static_cast<Scalar>(-0.3302995)
+                      + s * (static_cast<Scalar>(0.1801410) + s * (static_cast<Scalar>(-0.0851330)
+                      + s * static_cast<Scalar>(0.0208351)))));
+
+        if(ay > ax)
+            result = pi<Scalar>() / Scalar{2} - result;
+        if(x < Scalar{0})
+            result = pi<Scalar>() - result;
+        if(y < Scalar{0})
+            result = -result;
+
+        return result;
+    }
+
+    /** Computes the smaller eigenvalue of the symmetric 2x2 matrix
+      * [a11 a12; a12 a22] in closed form. The arguments can either be
+      * scalars or Eigen arrays, which computes the eigenvalues coefficient
+      * wise. */
+    template<typename Scalar>
+    inline Scalar minEigenvalue(const Scalar &a11, const Scalar &a12, const Scalar &a22)
+    {
+        using std::sqrt;
+        const Scalar halfDiff = (a11 - a22) / 2;
+        return (a11 + a22) / 2 - sqrt(halfDiff * halfDiff + a12 * a12);
+    }
+
     namespace angle
     {
         template<typename Scalar>
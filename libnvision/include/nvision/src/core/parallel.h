@@ -0,0 +1,77 @@
+/* parallel.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_PARALLEL_H_
+#define NVISION_PARALLEL_H_
+
+#include <algorithm>
+#include "nvision/src/core/types.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nvision::parallel
+{
+    /** Returns the maximum number of threads, which are used by parallel
+      * loops. Parallelization is enabled by compiling with OpenMP support,
+      * otherwise all loops run sequentially. */
+    inline Index threads()
+    {
+#ifdef _OPENMP
+        return static_cast<Index>(omp_get_max_threads());
+#else
+        return 1;
+#endif
+    }
+
+    /** Computes the number of chunks with the given size, which are
+      * required to cover count elements. */
+    inline Index chunks(const Index count, const Index chunkSize)
+    {
+        return (count + chunkSize - 1) / chunkSize;
+    }
+
+    /** Runs func(chunk, begin, end) for all consecutive chunks of the
+      * interval [0, count) in parallel.
+      * The partitioning only depends on count and chunkSize, but not on the
+      * number of threads. Thus results, which are stored per chunk and
+      * combined in chunk order afterwards, are deterministic.
+      * @param count number of elements
+      * @param chunkSize number of elements per chunk
+      * @param func functor which processes a single chunk */
+    template<typename Func>
+    inline void forChunks(const Index count, const Index chunkSize, Func &&func)
+    {
+        const auto chunkCnt = chunks(count, chunkSize);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(chunkCnt > 1)
+#endif
+        for(Index chunk = 0; chunk < chunkCnt; ++chunk)
+        {
+            const auto begin = chunk * chunkSize;
+            const auto end = std::min(count, begin + chunkSize);
+            func(chunk, begin, end);
+        }
+    }
+
+    /** Runs func(idx) for all indices of the interval [begin, end) in parallel.
+      * @param begin first index
+      * @param end index after the last index
+      * @param func functor which processes a single index */
+    template<typename Func>
+    inline void forEach(const Index begin, const Index end, Func &&func)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(end - begin > 1)
+#endif
+        for(Index idx = begin; idx < end; ++idx)
+            func(idx);
+    }
+}
+
+#endif
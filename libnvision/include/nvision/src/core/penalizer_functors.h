@@ -26,7 +26,8 @@ namespace nvision
         template<typename Rhs>
         Rhs operator()(const Rhs &value) const
         {
-            return nvision::exp(-value / (_lambda * _lambda));
+            using std::exp;
+            return exp(-value / (_lambda * _lambda));
         }
     private:
         Scalar _lambda = Scalar{30};
@@ -47,7 +48,8 @@ namespace nvision
         template<typename Rhs>
         Rhs operator()(const Rhs value) const
         {
-            return 1 / (2 * ::sqrt(value + _eps));
+            using std::sqrt;
+            return 1 / (2 * sqrt(value + _eps));
         }
     private:
         Scalar _eps = static_cast<Scalar>(1e-6);
@@ -138,17 +138,14 @@ namespace nvision
             using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
             static_assert(ColorSpace::Dimension == 1, "FAST only supports single channel images");
 
-            // calculate gradients
-            Image<ColorSpace> gradX = _gradient(img, GradientMode::X());
-            Image<ColorSpace> gradY = _gradient(img, GradientMode::Y());
+            // calculate the gradient products in a single sweep
+            Image<ColorSpace> productXX, productYY, productXY;
+            image::gradientProducts(_gradient, img, productXX, productYY, productXY);
 
             // accumulate values from local neighbourhood with smooth filter
-            Image<ColorSpace> tmp = gradX * gradX;
-            Image<ColorSpace> gradXX = _smooth(tmp);
-            tmp = gradY * gradY;
-            Image<ColorSpace> gradYY = _smooth(tmp);
-            tmp = gradX * gradY;
-            Image<ColorSpace> gradXY = _smooth(tmp);
+            Image<ColorSpace> gradXX = _smooth(productXX);
+            Image<ColorSpace> gradYY = _smooth(productYY);
+            Image<ColorSpace> gradXY = _smooth(productXY);
 
             // compute the harris response
             score.resize(img.rows(), img.cols());
@@ -90,19 +90,14 @@ namespace nvision
             using Matrix2 = Eigen::Matrix<Scalar, 2, 2>;
             using Vector2i = Eigen::Matrix<Index, 2, 1>;
 
-            // calculate base gradients
-            Image<ColorSpace> gradX = _gradient(img, GradientMode::X());
-            Image<ColorSpace> gradY = _gradient(img, GradientMode::Y());
+            // calculate the gradient products in a single sweep
+            Image<ColorSpace> productXX, productYY, productXY;
+            image::gradientProducts(_gradient, img, productXX, productYY, productXY);
 
             // accumulate values from local neighbourhood with smooth filter
-            Image<ColorSpace> tmp = gradX * gradX;
-            Image<ColorSpace> gradXX = _smooth(tmp);
-
-            tmp = gradY * gradY;
-            Image<ColorSpace> gradYY = _smooth(tmp);
-
-            tmp = gradX * gradY;
-            Image<ColorSpace> gradXY = _smooth(tmp);
+            Image<ColorSpace> gradXX = _smooth(productXX);
+            Image<ColorSpace> gradYY = _smooth(productYY);
+            Image<ColorSpace> gradXY = _smooth(productXY);
 
             Matrix response(img.rows(), img.cols());
 
@@ -7,24 +7,23 @@
 #ifndef NVISION_SHI_TOMASI_FEATURE_H_
 #define NVISION_SHI_TOMASI_FEATURE_H_
 
-#include <Eigen/Eigenvalues>
+#include "nvision/src/core/math.h"
 #include "nvision/src/feature/harris_feature_base.h"
 
 namespace nvision
 {
-    /** Functor which computes the Shi-Tomasi feature score. */
+    /** Functor which computes the Shi-Tomasi feature score, i.e. the smaller
+      * eigenvalue of the structure tensor. */
     template<typename _Scalar>
     class ShiTomasiScore
     {
     public:
         using Scalar = _Scalar;
         using Matrix2 = Eigen::Matrix<Scalar, 2, 2>;
-        using Vector2 = Eigen::Matrix<Scalar, 2, 1>;
 
         Scalar operator()(const Matrix2 &M) const
         {
-            Vector2 eigvals = M.eigenvalues().real();
-            return eigvals.minCoeff();
+            return minEigenvalue(M(0, 0), M(0, 1), M(1, 1));
         }
     };
 
@@ -0,0 +1,374 @@
+/* bilateral_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_BILATERAL_FILTER_H_
+#define NVISION_BILATERAL_FILTER_H_
+
+#include <vector>
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    struct BilateralMode
+    {
+        /** Evaluates the full neighbourhood within the radius of each pixel.
+          * The cost per pixel grows quadratically with the radius. */
+        struct Exact {};
+        /** Approximates the filter on a downsampled bilateral grid.
+          * The cost per pixel does not depend on the spatial sigma. */
+        struct Grid {};
+    };
+
+    /** Filter functor, which applies an edge-preserving bilateral filter to
+      * an image.
+      *
+      * Each pixel is replaced by a weighted average of its neighbourhood. The
+      * weight of a neighbour is the product of a Gaussian on the spatial
+      * distance and a Gaussian on the Euclidean distance of the pixel values,
+      * such that pixels across edges contribute little.
+      *
+      * The exact mode precomputes the spatial weights of all offsets within
+      * the radius and evaluates the range Gaussian with a lookup table.
+      *
+      * The grid mode follows Paris and Durand: the pixel values are
+      * accumulated in a 3D grid over the image coordinates, downsampled by
+      * the spatial sigma, and the mean of the channels, downsampled by the
+      * range sigma. The grid is blurred along all axes and sampled with
+      * trilinear interpolation. For multi-channel images the range weights
+      * are therefore determined by the mean of the channels.
+      *
+      * The filter works on color spaces with floating point values. */
+    template<typename _Scalar, typename _Mode=BilateralMode::Exact>
+    class BilateralFilter
+    {
+    public:
+        using Scalar = _Scalar;
+        using Mode = _Mode;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        BilateralFilter() = default;
+
+        /** Constructs a bilateral filter with the given parameters.
+          * The radius of the exact mode is set to twice the spatial sigma.
+          * @param sigmaSpatial standard deviation of the spatial Gaussian in pixels
+          * @param sigmaRange standard deviation of the range Gaussian in units of pixel values */
+        BilateralFilter(const Scalar sigmaSpatial, const Scalar sigmaRange)
+        {
+            setSigmaSpatial(sigmaSpatial);
+            setSigmaRange(sigmaRange);
+        }
+
+        /** Sets the standard deviation of the spatial Gaussian in pixels.
+          * This also sets the radius of the exact mode to twice the given sigma. */
+        void setSigmaSpatial(const Scalar sigma)
+        {
+            assert(sigma > 0);
+            _sigmaSpatial = sigma;
+            _radius = static_cast<Index>(std::ceil(2 * sigma));
+        }
+
+        /** Sets the standard deviation of the range Gaussian in units of
+          * pixel values. */
+        void setSigmaRange(const Scalar sigma)
+        {
+            assert(sigma > 0);
+            _sigmaRange = sigma;
+        }
+
+        /** Sets the radius of the neighbourhood, which is evaluated in exact mode. */
+        void setRadius(const Index radius)
+        {
+            assert(radius >= 0);
+            _radius = radius;
+        }
+
+        Scalar sigmaSpatial() const
+        {
+            return _sigmaSpatial;
+        }
+
+        Scalar sigmaRange() const
+        {
+            return _sigmaRange;
+        }
+
+        Index radius() const
+        {
+            return _radius;
+        }
+
+        /** Applies the bilateral filter to the given image.
+          * For BorderReflect in exact mode the radius must be smaller than
+          * the size of the image. The grid mode does not access pixels
+          * outside of the image and ignores the border handling.
+          * @param img the image on which the bilateral filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return filtered image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
+
+            if(img.size() == 0)
+                return Image<ColorSpace>(img.rows(), img.cols());
+
+            if constexpr (std::is_same<Mode, BilateralMode::Grid>::value)
+                return applyGrid(img);
+            else
+                return applyExact(img, handling);
+        }
+
+    private:
+        /** Number of lookup table entries per unit of the exponent. */
+        static constexpr Index LookupScale = 64;
+        /** Largest exponent in the lookup table, larger exponents have weight 0. */
+        static constexpr Index LookupMax = 16;
+        /** Margin of the bilateral grid, which covers the blur kernel. */
+        static constexpr Index GridMargin = 2;
+
+        Scalar _sigmaSpatial = 1;
+        Scalar _sigmaRange = Scalar{0.1};
+        Index _radius = 2;
+
+        struct Offset
+        {
+            Index row;
+            Index col;
+            Scalar weight;
+        };
+
+        template<typename Derived, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> applyExact(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            constexpr Index Dimension = ColorSpace::Dimension;
+            using Values = Eigen::Array<Scalar, Dimension, 1>;
+            using Plane = Eigen::Array<Scalar, Dimension, Eigen::Dynamic>;
+            using Vector = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto radius = _radius;
+            const auto paddedRows = rows + 2 * radius;
+
+            assert((!std::is_same<BorderHandling, BorderReflect>::value || (radius < rows && radius < cols)));
+
+            // spatial weights of all offsets within the radius
+            std::vector<Offset> offsets;
+            const auto spatialFactor = Scalar{-1} / (2 * _sigmaSpatial * _sigmaSpatial);
+            for(Index c = -radius; c <= radius; ++c)
+                for(Index r = -radius; r <= radius; ++r)
+                    if(r * r + c * c <= radius * radius)
+                        offsets.push_back({r, c, std::exp(spatialFactor * static_cast<Scalar>(r * r + c * c))});
+
+            // range weights as function of the exponent with linear interpolation
+            Vector lookup(LookupMax * LookupScale + 1);
+            for(Index i = 0; i < lookup.size(); ++i)
+                lookup(i) = std::exp(-static_cast<Scalar>(i) / static_cast<Scalar>(LookupScale));
+            const auto rangeFactor = static_cast<Scalar>(LookupScale) / (2 * _sigmaRange * _sigmaRange);
+            const auto lookupMax = static_cast<Scalar>(lookup.size() - 1);
+
+            // pad the image with the border handling
+            Plane padded(Dimension, paddedRows * (cols + 2 * radius));
+            parallel::forEach(0, cols + 2 * radius, [&](const Index c)
+            {
+                for(Index r = 0; r < paddedRows; ++r)
+                {
+                    const auto &pixel = handling(img, r - radius, c - radius);
+                    for(Index d = 0; d < Dimension; ++d)
+                        padded(d, c * paddedRows + r) = static_cast<Scalar>(pixel[d]);
+                }
+            });
+
+            Image<ColorSpace> result(rows, cols);
+            parallel::forEach(0, cols, [&](const Index c)
+            {
+                for(Index r = 0; r < rows; ++r)
+                {
+                    const auto center = (c + radius) * paddedRows + r + radius;
+                    const Values value = padded.col(center);
+
+                    Values sum = Values::Zero();
+                    Scalar weights = 0;
+                    for(const auto &offset : offsets)
+                    {
+                        const Values neighbour = padded.col(center + offset.col * paddedRows + offset.row);
+                        const auto exponent = (neighbour - value).square().sum() * rangeFactor;
+                        if(exponent >= lookupMax)
+                            continue;
+
+                        const auto idx = static_cast<Index>(exponent);
+                        const auto frac = exponent - static_cast<Scalar>(idx);
+                        const auto weight = offset.weight * (lookup(idx) + frac * (lookup(idx + 1) - lookup(idx)));
+
+                        sum += weight * neighbour;
+                        weights += weight;
+                    }
+
+                    sum /= weights;
+                    for(Index d = 0; d < Dimension; ++d)
+                        result(r, c)[d] = static_cast<ValueType>(sum(d));
+                }
+            });
+
+            return result;
+        }
+
+        template<typename Derived>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> applyGrid(const ImageBase<Derived> &img) const
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            constexpr Index Dimension = ColorSpace::Dimension;
+            // homogeneous values, the last entry holds the weight
+            using Values = Eigen::Array<Scalar, Dimension + 1, 1>;
+            using Grid = Eigen::Array<Scalar, Dimension + 1, Eigen::Dynamic>;
+            using Guide = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto spatialScale = Scalar{1} / _sigmaSpatial;
+            const auto rangeScale = Scalar{1} / _sigmaRange;
+
+            Guide guide(rows, cols);
+            parallel::forEach(0, cols, [&](const Index c)
+            {
+                for(Index r = 0; r < rows; ++r)
+                {
+                    Scalar sum = 0;
+                    for(Index d = 0; d < Dimension; ++d)
+                        sum += static_cast<Scalar>(img(r, c)[d]);
+                    guide(r, c) = sum / static_cast<Scalar>(Dimension);
+                }
+            });
+            const auto guideMin = guide.minCoeff();
+            const auto guideMax = guide.maxCoeff();
+
+            const auto gridRows = static_cast<Index>(static_cast<Scalar>(rows - 1) * spatialScale) + 1 + 2 * GridMargin;
+            const auto gridCols = static_cast<Index>(static_cast<Scalar>(cols - 1) * spatialScale) + 1 + 2 * GridMargin;
+            const auto gridDepth = static_cast<Index>((guideMax - guideMin) * rangeScale) + 1 + 2 * GridMargin;
+            const auto cell = [gridRows, gridDepth](const Index z, const Index r, const Index c)
+            {
+                return z + gridDepth * (r + gridRows * c);
+            };
+
+            const auto toGridRow = [spatialScale](const Index r)
+            {
+                return static_cast<Scalar>(r) * spatialScale + static_cast<Scalar>(GridMargin);
+            };
+            const auto toGridDepth = [rangeScale, guideMin](const Scalar value)
+            {
+                return (value - guideMin) * rangeScale + static_cast<Scalar>(GridMargin);
+            };
+
+            // accumulate each pixel in its nearest cell, all image columns,
+            // which fall into the same grid column, are handled by one task
+            std::vector<Index> firstColumn(gridCols + 1, cols);
+            for(Index c = cols - 1; c >= 0; --c)
+                firstColumn[static_cast<Index>(std::round(toGridRow(c)))] = c;
+            for(Index g = gridCols - 1; g >= 0; --g)
+                firstColumn[g] = std::min(firstColumn[g], firstColumn[g + 1]);
+
+            Grid grid = Grid::Zero(Dimension + 1, gridDepth * gridRows * gridCols);
+            parallel::forEach(0, gridCols, [&](const Index g)
+            {
+                for(Index c = firstColumn[g]; c < firstColumn[g + 1]; ++c)
+                {
+                    for(Index r = 0; r < rows; ++r)
+                    {
+                        const auto gr = static_cast<Index>(std::round(toGridRow(r)));
+                        const auto gz = static_cast<Index>(std::round(toGridDepth(guide(r, c))));
+                        auto values = grid.col(cell(gz, gr, g));
+                        for(Index d = 0; d < Dimension; ++d)
+                            values(d) += static_cast<Scalar>(img(r, c)[d]);
+                        values(Dimension) += 1;
+                    }
+                }
+            });
+
+            // blur along the depth, rows and columns of the grid
+            blurGrid(grid, gridDepth, 1, gridRows * gridCols, 1);
+            blurGrid(grid, gridRows, gridDepth, gridDepth * gridCols, gridDepth);
+            blurGrid(grid, gridCols, gridDepth * gridRows, gridDepth * gridRows, gridDepth * gridRows);
+
+            // sample the grid with trilinear interpolation
+            Image<ColorSpace> result(rows, cols);
+            parallel::forEach(0, cols, [&](const Index c)
+            {
+                const auto x = toGridRow(c);
+                const auto c0 = static_cast<Index>(x);
+                const auto fc = x - static_cast<Scalar>(c0);
+
+                for(Index r = 0; r < rows; ++r)
+                {
+                    const auto y = toGridRow(r);
+                    const auto r0 = static_cast<Index>(y);
+                    const auto fr = y - static_cast<Scalar>(r0);
+
+                    const auto z = toGridDepth(guide(r, c));
+                    const auto z0 = static_cast<Index>(z);
+                    const auto fz = z - static_cast<Scalar>(z0);
+
+                    const auto lerp = [&](const Index rr, const Index cc)
+                    {
+                        const Values lower = grid.col(cell(z0, rr, cc));
+                        const Values upper = grid.col(cell(z0 + 1, rr, cc));
+                        return Values(lower + fz * (upper - lower));
+                    };
+
+                    const Values left = lerp(r0, c0) + fr * (lerp(r0 + 1, c0) - lerp(r0, c0));
+                    const Values right = lerp(r0, c0 + 1) + fr * (lerp(r0 + 1, c0 + 1) - lerp(r0, c0 + 1));
+                    const Values value = left + fc * (right - left);
+
+                    for(Index d = 0; d < Dimension; ++d)
+                        result(r, c)[d] = static_cast<ValueType>(value(d) / value(Dimension));
+                }
+            });
+
+            return result;
+        }
+
+        /** Blurs all lines of the grid along one axis with the binomial
+          * kernel [1 4 6 4 1] / 16, which approximates a Gaussian with a
+          * standard deviation of one cell. The lines run in parallel.
+          * A line starts at (line / block) * blockStride + line % block.
+          * @param grid the grid, whose cells are stored in its columns
+          * @param length number of cells of each line
+          * @param stride distance between consecutive cells of a line
+          * @param lines number of lines
+          * @param block number of lines, which start at consecutive cells */
+        template<typename Grid>
+        static void blurGrid(Grid &grid, const Index length, const Index stride, const Index lines, const Index block)
+        {
+            constexpr Index chunkLines = 64;
+            const auto blockStride = block * length;
+            parallel::forChunks(lines, chunkLines, [&](const Index, const Index begin, const Index end)
+            {
+                Grid line(grid.rows(), length + 2 * GridMargin);
+                for(Index l = begin; l < end; ++l)
+                {
+                    const auto start = (l / block) * blockStride + l % block;
+
+                    line.setZero();
+                    for(Index i = 0; i < length; ++i)
+                        line.col(i + GridMargin) = grid.col(start + i * stride);
+
+                    for(Index i = 0; i < length; ++i)
+                        grid.col(start + i * stride) = (line.col(i) + line.col(i + 4)
+                            + 4 * (line.col(i + 1) + line.col(i + 3))
+                            + 6 * line.col(i + 2)) / 16;
+                }
+            });
+        }
+    };
+}
+
+#endif
@@ -11,7 +11,10 @@
 
 namespace nvision
 {
-    /** Filter functor, which applies Binominal blur to an image. */
+    /** Filter functor, which applies Binominal blur to an image.
+      * If the kernel scalar is int16, the kernel holds the unnormalized
+      * binomial coefficients and images with integral values are filtered
+      * in fixed point arithmetic. */
     template<typename _KernelScalar, Index _Dimension>
     class BinominalFilter
     {
@@ -19,8 +22,12 @@ namespace nvision
         using KernelScalar = _KernelScalar;
         static constexpr Index Dimension = _Dimension;
         using KernelMatrix = Eigen::Matrix<KernelScalar, Dimension, Dimension>;
+        /** Number of fractional bits of the kernel in fixed point arithmetic.
+          * The binomial coefficients of each dimension sum up to 2^(Dimension - 1). */
+        static constexpr Index Shift = 2 * (Dimension - 1);
 
-        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "Kernel scalar must be floating point");
+        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0 || std::is_same<KernelScalar, int16>::value, "Kernel scalar must be floating point or int16");
+        static_assert(!std::is_integral<KernelScalar>::value || Dimension <= 9, "Fixed point kernel must not exceed 16 bits");
         static_assert(Dimension % 2 == 1, "Kernel must have odd dimension");
 
         BinominalFilter()
@@ -41,7 +48,15 @@ namespace nvision
         auto operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
-            return image::filter<Dimension, Dimension>(img, _kernel, handling);
+            if constexpr (std::is_integral<KernelScalar>::value)
+            {
+                using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+                return image::filterFixedPoint<Dimension, Dimension, ColorSpace>(img, _kernel, Shift, handling);
+            }
+            else
+            {
+                return image::filter<Dimension, Dimension>(img, _kernel, handling);
+            }
         }
 
     private:
@@ -62,7 +77,9 @@ namespace nvision
 
             // normalize kernel such that sum of elements is one
             // if it is not normalized, the image becomes darker
-            vector /= vector.sum();
+            // fixed point kernels are normalized by the shift instead
+            if constexpr (!std::is_integral<KernelScalar>::value)
+                vector /= vector.sum();
             return KernelMatrix{vector * vector.transpose()};
         }
     };
@@ -7,7 +7,9 @@
 #ifndef NVISION_BOX_FILTER_H_
 #define NVISION_BOX_FILTER_H_
 
+#include <array>
 #include "nvision/src/core/image.h"
+#include "nvision/src/core/parallel.h"
 
 namespace nvision
 {
@@ -52,6 +54,183 @@ namespace nvision
         const KernelMatrix _kernel = KernelMatrix::Constant(KernelScalar{1} / (KernelScalar{Dimension} * KernelScalar{Dimension}));
     };
 
+    /** Filter functor, which applies an iterated box blur with a kernel size
+      * determined at runtime.
+      *
+      * The filter is separable and computes sliding window sums, first along
+      * the columns and then along the rows. Each step of the window adds one
+      * value and removes another one, such that the cost per pixel does not
+      * depend on the radius of the kernel.
+      *
+      * The vertical pass runs in parallel over columns, the horizontal pass
+      * adds up whole column segments, which Eigen vectorizes, and runs in
+      * parallel over bands of rows.
+      *
+      * Applying the filter multiple times approximates a Gaussian filter,
+      * the appropriate radius for a given sigma can be computed with
+      * radiusForSigma(). */
+    template<typename _KernelScalar>
+    class BoxFilter<_KernelScalar, Eigen::Dynamic>
+    {
+    public:
+        using KernelScalar = _KernelScalar;
+        using Plane = Eigen::Array<KernelScalar, Eigen::Dynamic, Eigen::Dynamic>;
+        using Vector = Eigen::Array<KernelScalar, Eigen::Dynamic, 1>;
+
+        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "Kernel scalar must be floating point");
+
+        BoxFilter() = default;
+
+        /** Constructs a box filter with the given parameters.
+          * @param radius radius of the kernel, the kernel has size 2 * radius + 1
+          * @param iterations number of times the filter is applied */
+        explicit BoxFilter(const Index radius, const Index iterations = 1)
+        {
+            setRadius(radius);
+            setIterations(iterations);
+        }
+
+        /** Sets the radius of the kernel. The kernel has size 2 * radius + 1. */
+        void setRadius(const Index radius)
+        {
+            assert(radius >= 0);
+            _radius = radius;
+        }
+
+        /** Sets the number of times the filter is applied to the image. */
+        void setIterations(const Index iterations)
+        {
+            assert(iterations > 0);
+            _iterations = iterations;
+        }
+
+        Index radius() const
+        {
+            return _radius;
+        }
+
+        Index iterations() const
+        {
+            return _iterations;
+        }
+
+        /** Returns the size of the kernel. */
+        Index size() const
+        {
+            return 2 * _radius + 1;
+        }
+
+        /** Computes the radius, such that the given number of iterations of
+          * the box filter approximates a Gaussian filter with the given sigma.
+          * The variance of n iterated box filters of width w is n * (w^2 - 1) / 12.
+          * @param sigma standard deviation of the Gaussian
+          * @param iterations number of iterations of the box filter
+          * @return radius of the box filter */
+        static Index radiusForSigma(const KernelScalar sigma, const Index iterations)
+        {
+            assert(iterations > 0);
+            const auto width = std::sqrt(KernelScalar{12} * sigma * sigma / static_cast<KernelScalar>(iterations) + KernelScalar{1});
+            return std::max<Index>(0, static_cast<Index>(std::round((width - KernelScalar{1}) / KernelScalar{2})));
+        }
+
+        /** Applies the box filter to the given image.
+          * For BorderReflect the radius must be smaller than the size of
+          * the image.
+          * @param img the image on which the box filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return filtered image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            assert((!std::is_same<BorderHandling, BorderReflect>::value || img.size() == 0 || (_radius < img.rows() && _radius < img.cols())));
+
+            auto result = apply(img, handling);
+            for(Index i = 1; i < _iterations; ++i)
+                result = apply(result, handling);
+
+            return result;
+        }
+
+    private:
+        Index _radius = 1;
+        Index _iterations = 1;
+
+        template<typename Derived, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> apply(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            constexpr Index Dimension = ColorSpace::Dimension;
+            using Channels = Eigen::Array<KernelScalar, Dimension, 1>;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto radius = _radius;
+            const auto size = 2 * radius + 1;
+
+            Image<ColorSpace> result(rows, cols);
+            if(img.size() == 0)
+                return result;
+
+            // vertical window sums, the planes contain additional columns
+            // on both sides, which already incorporate the border handling
+            std::array<Plane, Dimension> sums;
+            for(auto &plane : sums)
+                plane.resize(rows, cols + 2 * radius);
+
+            parallel::forEach(0, cols + 2 * radius, [&](const Index c)
+            {
+                const auto col = c - radius;
+                Channels sum = Channels::Zero();
+                for(Index r = -radius; r <= radius; ++r)
+                {
+                    const auto &pixel = handling(img, r, col);
+                    for(Index d = 0; d < Dimension; ++d)
+                        sum(d) += static_cast<KernelScalar>(pixel[d]);
+                }
+
+                for(Index r = 0; r < rows; ++r)
+                {
+                    for(Index d = 0; d < Dimension; ++d)
+                        sums[d](r, c) = sum(d);
+
+                    if(r + 1 < rows)
+                    {
+                        const auto &added = handling(img, r + radius + 1, col);
+                        const auto &removed = handling(img, r - radius, col);
+                        for(Index d = 0; d < Dimension; ++d)
+                            sum(d) += static_cast<KernelScalar>(added[d]) - static_cast<KernelScalar>(removed[d]);
+                    }
+                }
+            });
+
+            // horizontal window sums over segments of whole columns
+            const auto factor = KernelScalar{1} / static_cast<KernelScalar>(size * size);
+            constexpr Index bandRows = 256;
+            parallel::forChunks(rows, bandRows, [&](const Index, const Index begin, const Index end)
+            {
+                const auto len = end - begin;
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    const auto &plane = sums[d];
+                    Vector sum = plane.block(begin, 0, len, size).rowwise().sum();
+
+                    for(Index c = 0; c < cols; ++c)
+                    {
+                        for(Index r = 0; r < len; ++r)
+                            result(begin + r, c)[d] = roundCast<ValueType>(sum(r) * factor);
+
+                        if(c + 1 < cols)
+                            sum += plane.col(c + size).segment(begin, len) - plane.col(c).segment(begin, len);
+                    }
+                }
+            });
+
+            return result;
+        }
+    };
+
     template<typename KernelScalar>
     using BoxFilter3 = BoxFilter<KernelScalar, 3>;
     template<typename KernelScalar>
@@ -60,6 +239,8 @@ namespace nvision
     using BoxFilter7 = BoxFilter<KernelScalar, 7>;
     template<typename KernelScalar>
     using BoxFilter9 = BoxFilter<KernelScalar, 9>;
+    template<typename KernelScalar>
+    using BoxFilterX = BoxFilter<KernelScalar, Eigen::Dynamic>;
 }
 
 #endif
@@ -0,0 +1,321 @@
+/// @author Fabian Meyer
+/// @date 18 Oct 2026
+/// @file
+
+#ifndef NVISION_CANNY_EDGE_DETECTOR_H_
+#define NVISION_CANNY_EDGE_DETECTOR_H_
+
+#include <vector>
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/parallel.h"
+#include "nvision/src/filter/canny_edge_filter.h"
+
+namespace nvision
+{
+    /// @brief Detects edges in an image with the complete Canny pipeline in
+    /// a single call.
+    ///
+    /// The image is split into bands of rows, which are processed in
+    /// parallel. Each band smoothes the image with a separable Gaussian,
+    /// computes the Sobel gradients and applies non-maximum suppression and
+    /// the double threshold. The band reads as many additional halo rows as
+    /// the kernels require, such that no intermediate full-size image is
+    /// created. Afterwards the hysteresis follows the edges within each band
+    /// in parallel. Edges, which cross the seam between two bands, are
+    /// completed by a final flood fill, which is seeded with the edge pixels
+    /// on the seams. The result therefore does not depend on the band size
+    /// or the number of threads.
+    ///
+    /// Multi-channel images use the gradient of the channel with the largest
+    /// magnitude in each pixel. Borders are handled by reflection, thus the
+    /// image must be larger than the radius of the Gaussian.
+    /// @tparam _Scalar Scalar type that is used for internal computations
+    template<typename _Scalar>
+    class CannyEdgeDetector
+    {
+    public:
+        using Scalar = _Scalar;
+        /// @brief Edge pixels with x-coordinate (column) in the first and
+        /// y-coordinate (row) in the second row.
+        using EdgeList = Eigen::Matrix<Index, 2, Eigen::Dynamic>;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        CannyEdgeDetector() = default;
+
+        /// @brief Constructs a detector with the given parameters.
+        /// @param sigma standard deviation of the Gaussian; zero disables smoothing
+        /// @param low low threshold of the gradient magnitude
+        /// @param high high threshold of the gradient magnitude
+        CannyEdgeDetector(const Scalar sigma, const Scalar low, const Scalar high)
+        {
+            setSigma(sigma);
+            setThreshold(low, high);
+        }
+
+        /// @brief Sets the standard deviation of the Gaussian, which smoothes
+        /// the image. The kernel has a radius of ceil(3 * sigma).
+        void setSigma(const Scalar sigma)
+        {
+            assert(sigma >= 0);
+            _sigma = sigma;
+        }
+
+        void setThreshold(const Scalar low, const Scalar high)
+        {
+            _lowThreshold = low;
+            _highThreshold = high;
+        }
+
+        /// @brief Sets the number of rows of each band, which is processed
+        /// by a single thread.
+        void setBandRows(const Index rows)
+        {
+            assert(rows > 0);
+            _bandRows = rows;
+        }
+
+        Scalar sigma() const
+        {
+            return _sigma;
+        }
+
+        Scalar lowThreshold() const
+        {
+            return _lowThreshold;
+        }
+
+        Scalar highThreshold() const
+        {
+            return _highThreshold;
+        }
+
+        Index bandRows() const
+        {
+            return _bandRows;
+        }
+
+        /// @brief Detects the edges of the given image.
+        /// @param img input image
+        /// @return binary edge image, edges have the maximum value of the color space
+        template<typename Derived>
+        Image<Gray> operator()(const ImageBase<Derived> &img) const
+        {
+            const auto states = detect(img);
+
+            Image<Gray> result(img.rows(), img.cols());
+            parallel::forEach(0, img.cols(), [&](const Index c)
+            {
+                for(Index r = 0; r < img.rows(); ++r)
+                    result(r, c)[0] = states(r, c) == internal::CannyState::Strong ? Gray::maximum[0] : uint8{0};
+            });
+
+            return result;
+        }
+
+        /// @brief Detects the edges of the given image.
+        /// @param img input image
+        /// @param edges receives the coordinates of all edge pixels in column-major order
+        template<typename Derived>
+        void operator()(const ImageBase<Derived> &img, EdgeList &edges) const
+        {
+            const auto states = detect(img);
+
+            // count the edges of each chunk of columns, such that the
+            // chunks can be written in parallel
+            constexpr Index chunkCols = 64;
+            std::vector<Index> offsets(parallel::chunks(img.cols(), chunkCols) + 1, 0);
+            parallel::forChunks(img.cols(), chunkCols, [&](const Index chunk, const Index begin, const Index end)
+            {
+                offsets[chunk + 1] = (states.middleCols(begin, end - begin) == internal::CannyState::Strong).count();
+            });
+            for(size_t i = 1; i < offsets.size(); ++i)
+                offsets[i] += offsets[i - 1];
+
+            edges.resize(2, offsets.back());
+            parallel::forChunks(img.cols(), chunkCols, [&](const Index chunk, const Index begin, const Index end)
+            {
+                auto idx = offsets[chunk];
+                for(Index c = begin; c < end; ++c)
+                {
+                    for(Index r = 0; r < img.rows(); ++r)
+                    {
+                        if(states(r, c) == internal::CannyState::Strong)
+                        {
+                            edges(0, idx) = c;
+                            edges(1, idx) = r;
+                            ++idx;
+                        }
+                    }
+                }
+            });
+        }
+
+    private:
+        using Plane = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+        using Vector = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+
+        Scalar _sigma = 1;
+        Scalar _lowThreshold = static_cast<Scalar>(0.078f);
+        Scalar _highThreshold = static_cast<Scalar>(0.3992f);
+        Index _bandRows = 128;
+
+        /// @brief Reflects an index at the borders of the interval [0, size)
+        /// in the same way as BorderReflect.
+        static Index reflect(const Index idx, const Index size)
+        {
+            if(idx < 0)
+                return std::min(-idx, size - 1);
+            else if(idx >= size)
+                return std::max<Index>(2 * size - 2 - idx, 0);
+            else
+                return idx;
+        }
+
+        Vector kernel() const
+        {
+            const auto radius = static_cast<Index>(std::ceil(3 * _sigma));
+            Vector weights(2 * radius + 1);
+            for(Index i = -radius; i <= radius; ++i)
+                weights(i + radius) = _sigma > 0 ? std::exp(-static_cast<Scalar>(i * i) / (2 * _sigma * _sigma)) : Scalar{1};
+
+            return weights / weights.sum();
+        }
+
+        template<typename Derived>
+        internal::CannyStates detect(const ImageBase<Derived> &img) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto weights = kernel();
+            const auto radius = weights.size() / 2;
+            const auto lowThresholdSq = _lowThreshold * _lowThreshold;
+            const auto highThresholdSq = _highThreshold * _highThreshold;
+
+            internal::CannyStates states(rows, cols);
+            if(img.size() == 0)
+                return states;
+
+            assert(radius < rows && radius < cols);
+
+            parallel::forChunks(rows, _bandRows, [&](const Index, const Index begin, const Index end)
+            {
+                // the gradients require one and the smoothed image two halo
+                // rows on each side of the band
+                const auto smoothBegin = std::max<Index>(begin - 2, 0);
+                const auto smoothRows = std::min<Index>(end + 2, rows) - smoothBegin;
+                const auto gradientBegin = std::max<Index>(begin - 1, 0);
+                const auto gradientRows = std::min<Index>(end + 1, rows) - gradientBegin;
+
+                // separable Gaussian, first along the columns, then along the rows
+                std::array<Plane, Dimension> smooth;
+                Plane vertical(smoothRows, cols);
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    for(Index c = 0; c < cols; ++c)
+                    {
+                        for(Index r = 0; r < smoothRows; ++r)
+                        {
+                            Scalar sum = 0;
+                            for(Index k = 0; k < weights.size(); ++k)
+                                sum += weights(k) * static_cast<Scalar>(img(reflect(smoothBegin + r + k - radius, rows), c)[d]);
+                            vertical(r, c) = sum;
+                        }
+                    }
+
+                    smooth[d].setZero(smoothRows, cols);
+                    for(Index c = 0; c < cols; ++c)
+                        for(Index k = 0; k < weights.size(); ++k)
+                            smooth[d].col(c) += weights(k) * vertical.col(reflect(c + k - radius, cols));
+                }
+
+                // Sobel gradients of the channel with the largest magnitude
+                Plane gradientX(gradientRows, cols);
+                Plane gradientY(gradientRows, cols);
+                Plane magnitudes = Plane::Constant(gradientRows, cols, Scalar{-1});
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    const auto &values = smooth[d];
+                    for(Index c = 0; c < cols; ++c)
+                    {
+                        const auto cm = reflect(c - 1, cols);
+                        const auto cp = reflect(c + 1, cols);
+                        for(Index r = 0; r < gradientRows; ++r)
+                        {
+                            const auto row = gradientBegin + r;
+                            const auto rm = reflect(row - 1, rows) - smoothBegin;
+                            const auto rc = row - smoothBegin;
+                            const auto rp = reflect(row + 1, rows) - smoothBegin;
+
+                            const auto dx = (values(rm, cp) - values(rm, cm))
+                                + 2 * (values(rc, cp) - values(rc, cm))
+                                + (values(rp, cp) - values(rp, cm));
+                            const auto dy = (values(rp, cm) - values(rm, cm))
+                                + 2 * (values(rp, c) - values(rm, c))
+                                + (values(rp, cp) - values(rm, cp));
+                            const auto magnitudeSq = dx * dx + dy * dy;
+
+                            if(magnitudeSq > magnitudes(r, c))
+                            {
+                                gradientX(r, c) = dx;
+                                gradientY(r, c) = dy;
+                                magnitudes(r, c) = magnitudeSq;
+                            }
+                        }
+                    }
+                }
+
+                // non-maximum suppression and double threshold
+                for(Index c = 0; c < cols; ++c)
+                {
+                    for(Index row = begin; row < end; ++row)
+                    {
+                        const auto r = row - gradientBegin;
+                        const auto neighbour = [&, row, r, c](const Index drow, const Index dcol)
+                        {
+                            const auto row2 = row + drow;
+                            const auto col2 = c + dcol;
+                            return row2 >= 0 && row2 < rows && col2 >= 0 && col2 < cols ? magnitudes(r + drow, col2) : Scalar{0};
+                        };
+                        states(row, c) = internal::cannyClassify(gradientX(r, c), gradientY(r, c), magnitudes(r, c), neighbour, lowThresholdSq, highThresholdSq);
+                    }
+                }
+
+                // hysteresis within the band
+                std::vector<Index> stack;
+                for(Index c = 0; c < cols; ++c)
+                {
+                    for(Index row = begin; row < end; ++row)
+                    {
+                        if(states(row, c) == internal::CannyState::Strong)
+                            stack.push_back(c * rows + row);
+                    }
+                }
+                internal::cannyHysteresis(states, stack, begin, end);
+            });
+
+            // continue the edges across the seams of the bands
+            std::vector<Index> stack;
+            for(Index begin = _bandRows; begin < rows; begin += _bandRows)
+            {
+                for(Index c = 0; c < cols; ++c)
+                {
+                    for(Index row = begin - 1; row <= begin; ++row)
+                    {
+                        if(states(row, c) == internal::CannyState::Strong)
+                            stack.push_back(c * rows + row);
+                    }
+                }
+            }
+            internal::cannyHysteresis(states, stack, 0, rows);
+
+            return states;
+        }
+    };
+}
+
+#endif
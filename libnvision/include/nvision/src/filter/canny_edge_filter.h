@@ -5,11 +5,138 @@
 #ifndef NVISION_CANNY_EDGE_FILTER_H_
 #define NVISION_CANNY_EDGE_FILTER_H_
 
+#include <utility>
+#include <vector>
 #include "nvision/src/core/image.h"
+#include "nvision/src/filter/gradient_filter.h"
 
 namespace nvision
 {
+    namespace internal
+    {
+        /// @brief States of the pixels during the Canny edge detection.
+        struct CannyState
+        {
+            /// @brief Pixel was suppressed or is below the low threshold.
+            static constexpr uint8 None = 0;
+            /// @brief Local maximum between the low and the high threshold.
+            static constexpr uint8 Weak = 1;
+            /// @brief Local maximum above the high threshold or weak pixel connected to it.
+            static constexpr uint8 Strong = 2;
+        };
+
+        using CannyStates = Eigen::Array<uint8, Eigen::Dynamic, Eigen::Dynamic>;
+
+        /// @brief Quantizes the gradient direction into one of four neighbour
+        /// directions without trigonometric functions.
+        /// The direction is determined by comparing the gradient components
+        /// with the tangents of 22.5 and 67.5 degrees.
+        /// @param dx gradient in x-direction
+        /// @param dy gradient in y-direction
+        /// @return row and column offset of the neighbour along the gradient,
+        /// the opposite neighbour is located at the negated offset
+        template<typename Scalar>
+        inline std::pair<Index, Index> cannyDirection(const Scalar dx, const Scalar dy)
+        {
+            // tan(22.5 deg) and tan(67.5 deg)
+            constexpr auto tanLower = static_cast<Scalar>(0.41421356237);
+            constexpr auto tanUpper = static_cast<Scalar>(2.41421356237);
+
+            const auto ax = std::abs(dx);
+            const auto ay = std::abs(dy);
+
+            if(ay <= tanLower * ax)
+                return {0, 1};
+            else if(ay >= tanUpper * ax)
+                return {1, 0};
+            else if((dx < Scalar{0}) == (dy < Scalar{0}))
+                return {1, 1};
+            else
+                return {-1, 1};
+        }
+
+        /// @brief Applies non-maximum suppression and the double threshold to
+        /// a single pixel.
+        /// A pixel is a local maximum if its magnitude is larger than the
+        /// magnitude of the neighbour in gradient direction and not smaller
+        /// than the one of the opposite neighbour.
+        /// @param dx gradient in x-direction
+        /// @param dy gradient in y-direction
+        /// @param magnitudeSq squared gradient magnitude of the pixel
+        /// @param magnitudeAt functor, which returns the squared magnitude of
+        /// the neighbour at the given row and column offset
+        /// @param lowThresholdSq squared low threshold
+        /// @param highThresholdSq squared high threshold
+        /// @return state of the pixel
+        template<typename Scalar, typename Magnitude>
+        inline uint8 cannyClassify(const Scalar dx,
+                                   const Scalar dy,
+                                   const Scalar magnitudeSq,
+                                   const Magnitude &magnitudeAt,
+                                   const Scalar lowThresholdSq,
+                                   const Scalar highThresholdSq)
+        {
+            if(magnitudeSq < lowThresholdSq)
+                return CannyState::None;
+
+            const auto offset = cannyDirection(dx, dy);
+            const auto magnitudeSqA = magnitudeAt(offset.first, offset.second);
+            const auto magnitudeSqB = magnitudeAt(-offset.first, -offset.second);
+
+            if(magnitudeSq > magnitudeSqA && magnitudeSq >= magnitudeSqB)
+                return magnitudeSq >= highThresholdSq ? CannyState::Strong : CannyState::Weak;
+            else
+                return CannyState::None;
+        }
+
+        /// @brief Promotes all weak pixels within the rows [begin, end), which
+        /// are 8-connected to a strong pixel, to strong pixels.
+        /// The edges are followed with an explicit stack, which is seeded
+        /// with the given strong pixels, such that each pixel is visited at
+        /// most once.
+        /// @param states pixel states of a single channel
+        /// @param stack linear indices of strong pixels, which are used as seeds
+        /// @param begin first row, which may be promoted
+        /// @param end row after the last row, which may be promoted
+        inline void cannyHysteresis(CannyStates &states, std::vector<Index> &stack, const Index begin, const Index end)
+        {
+            const auto rows = states.rows();
+            const auto cols = states.cols();
+
+            while(!stack.empty())
+            {
+                const auto idx = stack.back();
+                stack.pop_back();
+
+                const auto row = idx % rows;
+                const auto col = idx / rows;
+                const auto rowBegin = std::max<Index>(row - 1, begin);
+                const auto rowEnd = std::min<Index>(row + 2, end);
+                const auto colBegin = std::max<Index>(col - 1, 0);
+                const auto colEnd = std::min<Index>(col + 2, cols);
+
+                for(Index c = colBegin; c < colEnd; ++c)
+                {
+                    for(Index r = rowBegin; r < rowEnd; ++r)
+                    {
+                        if(states(r, c) == CannyState::Weak)
+                        {
+                            states(r, c) = CannyState::Strong;
+                            stack.push_back(c * rows + r);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     /// @brief Edge detection filter using the Canny algorithm.
+    ///
+    /// The squared gradient magnitudes are computed once per channel. The
+    /// direction of the non-maximum suppression is quantized by comparing
+    /// the gradient components with fixed tangents. The hysteresis follows
+    /// the edges from all strong pixels with a flood fill, which runs in
+    /// linear time and does not depend on the scan order.
     /// @tparam _Scalar Scalar type that is used for internal computations
     /// @see https://en.wikipedia.org/wiki/Canny_edge_detector
     template<typename _Scalar>
@@ -42,165 +169,84 @@ namespace nvision
             using PixelType = typename ImageBase<Derived>::Scalar;
             using ColorSpace = typename PixelType::ColorSpace;
             using ValueType = typename ColorSpace::ValueType;
+            using Plane = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
 
             assert(gradientX.cols() == gradientY.cols());
             assert(gradientX.rows() == gradientY.rows());
 
-            auto edgeImage = Image<ColorSpace>{gradientX.rows(), gradientX.cols()};
+            const auto rows = gradientX.rows();
+            const auto cols = gradientX.cols();
+            const auto lowThresholdSq = _lowThreshold * _lowThreshold;
+            const auto highThresholdSq = _highThreshold * _highThreshold;
+
+            auto edgeImage = Image<ColorSpace>{rows, cols};
 
-            for(auto c = Index{0}; c < gradientX.cols(); ++c)
+            Plane magnitudes(rows, cols);
+            internal::CannyStates states(rows, cols);
+            std::vector<Index> stack;
+
+            for(auto d = Index{0}; d < ColorSpace::Dimension; ++d)
             {
-                for(auto r = Index{0}; r < gradientX.rows(); ++r)
+                for(auto c = Index{0}; c < cols; ++c)
                 {
-                    for(auto d = Index{0}; d < ColorSpace::Dimension;++d)
+                    for(auto r = Index{0}; r < rows; ++r)
                     {
-                        // apply non-maximum suppression
-                        const auto isEdge = computeNonMaximaSuppression(gradientX, gradientY, r, c, d);
-                        edgeImage(r, c)[d] = isEdge ? ValueType{1} : ValueType{0};
+                        const auto dx = static_cast<Scalar>(gradientX(r, c)[d]);
+                        const auto dy = static_cast<Scalar>(gradientY(r, c)[d]);
+                        magnitudes(r, c) = dx * dx + dy * dy;
                     }
                 }
-            }
 
-            for(auto c = Index{0}; c < gradientX.cols(); ++c)
-            {
-                for(auto r = Index{0}; r < gradientX.rows(); ++r)
+                const auto magnitudeAt = [&magnitudes, rows, cols](const Index row, const Index col)
                 {
-                    for(auto d = Index{0}; d < ColorSpace::Dimension;++d)
+                    return row >= 0 && row < rows && col >= 0 && col < cols ? magnitudes(row, col) : Scalar{0};
+                };
+
+                for(auto c = Index{0}; c < cols; ++c)
+                {
+                    for(auto r = Index{0}; r < rows; ++r)
                     {
-                        if(edgeImage(r, c)[d] == ValueType{0})
+                        const auto dx = static_cast<Scalar>(gradientX(r, c)[d]);
+                        const auto dy = static_cast<Scalar>(gradientY(r, c)[d]);
+                        const auto neighbour = [&magnitudeAt, r, c](const Index drow, const Index dcol)
                         {
-                            continue;
-                        }
-
-                        // apply non-maximum suppression and
-                        // perform hysteresis and follow edges
-                        const auto isEdge = computeHyteresis(gradientX, gradientY, edgeImage, r, c, d);
-                        edgeImage(r, c)[d] = isEdge ? ValueType{1} : ValueType{0};
+                            return magnitudeAt(r + drow, c + dcol);
+                        };
+                        states(r, c) = internal::cannyClassify(dx, dy, magnitudes(r, c), neighbour, lowThresholdSq, highThresholdSq);
                     }
                 }
-            }
 
-            return edgeImage;
-        }
+                stack.clear();
+                for(auto i = Index{0}; i < states.size(); ++i)
+                {
+                    if(states(i) == internal::CannyState::Strong)
+                        stack.push_back(i);
+                }
 
-    private:
-        Scalar _lowThreshold = static_cast<Scalar>(0.078f);
-        Scalar _highThreshold = static_cast<Scalar>(0.3992f);
+                internal::cannyHysteresis(states, stack, 0, rows);
 
-        template<typename Derived>
-        Scalar getMagnitudeSq(const ImageBase<Derived> &gradientX,
-                              const ImageBase<Derived> &gradientY,
-                              const Index row,
-                              const Index col,
-                              const Index depth) const
-        {
-            if(!image::inside(gradientX, row, col))
-            {
-                return Scalar{0};
-            }
-            else
-            {
-                const auto dx = static_cast<Scalar>(gradientX(row, col)[depth]);
-                const auto dy = static_cast<Scalar>(gradientY(row, col)[depth]);
-                return dx * dx + dy * dy;
+                for(auto c = Index{0}; c < cols; ++c)
+                {
+                    for(auto r = Index{0}; r < rows; ++r)
+                        edgeImage(r, c)[d] = states(r, c) == internal::CannyState::Strong ? ValueType{1} : ValueType{0};
+                }
             }
-        }
 
-        template<typename Derived>
-        bool computeNonMaximaSuppression(const ImageBase<Derived> &gradientX,
-                                         const ImageBase<Derived> &gradientY,
-                                         const Index row,
-                                         const Index col,
-                                         const Index depth) const
-        {
-            static constexpr auto neighbor_map = std::array<std::pair<Index, Index>, 4>{
-                std::make_pair(1, 0),
-                std::make_pair(1, 1),
-                std::make_pair(0, 1),
-                std::make_pair(-1, 1)
-            };
-            static constexpr auto pi_quarter = pi<Scalar>() / Scalar{4};
-            static constexpr auto pi_eighth = pi<Scalar>() / Scalar{8};
-
-            const auto dx = static_cast<Scalar>(gradientX(row, col)[depth]);
-            const auto dy = static_cast<Scalar>(gradientY(row, col)[depth]);
-            const auto angle = std::atan2(dy, dx) + pi<Scalar>() + pi_eighth;
-            const auto direction = static_cast<Index>(angle / pi_quarter) % neighbor_map.size();
-
-            const auto cA = neighbor_map[direction].first;
-            const auto rA = neighbor_map[direction].second;
-            const auto cB = -neighbor_map[direction].first;
-            const auto rB = -neighbor_map[direction].second;
-
-            const auto magnitudeSq = dx * dx + dy * dy;
-            const auto magnitudeSqA = getMagnitudeSq(gradientX, gradientY, rA, cA, depth);
-            const auto magnitudeSqB = getMagnitudeSq(gradientX, gradientY, rB, cB, depth);
-
-            // if both of the neighbors is stronger suppress this pixel
-            return magnitudeSq >= magnitudeSqA || magnitudeSq >= magnitudeSqB;
+            return edgeImage;
         }
 
-        template<typename Derived>
-        bool computeHyteresis(const ImageBase<Derived> &gradientX,
-                              const ImageBase<Derived> &gradientY,
-                              const ImageBase<Derived> &edgeImage,
-                              const Index row,
-                              const Index col,
-                              const Index depth) const
+        /// @brief Computes edges from the given gradients.
+        /// @param gradient image gradients in x- and y-direction
+        /// @return binary edge image where all non-zero entries are considered edges
+        template<typename ColorSpace>
+        auto operator()(const ImageGradient<ColorSpace> &gradient) const
         {
-            using PixelType = typename ImageBase<Derived>::Scalar;
-            using ColorSpace = typename PixelType::ColorSpace;
-            using ValueType = typename ColorSpace::ValueType;
-
-            const auto lowThresholdSq = _lowThreshold * _lowThreshold;
-            const auto highThresholdSq = _highThreshold * _highThreshold;
-
-            const auto dx = static_cast<Scalar>(gradientX(row, col)[depth]);
-            const auto dy = static_cast<Scalar>(gradientY(row, col)[depth]);
-            const auto magnitudeSq = dx * dx + dy * dy;
-
-            // if magnitude is below low threshold, suppress this pixel
-            if(magnitudeSq < lowThresholdSq)
-            {
-                return false;
-            }
-            // if any neighbor is strong then do not suppress this pixel
-            else if(magnitudeSq < highThresholdSq)
-            {
-                bool suppress = true;
-                for(auto dcol = Index{0}; dcol < Index{3}; ++dcol)
-                {
-                    const auto col2 = col + dcol - Index{1};
-                    for(Index drow = Index{0}; drow < Index{3}; ++drow)
-                    {
-                        const auto row2 = row + drow - Index{1};
-                        if(!image::inside(edgeImage, row2, col2) || edgeImage(row2, col2)[depth] == ValueType{0})
-                        {
-                            continue;
-                        }
-
-                        const auto neighborMagnitudeSq = getMagnitudeSq(gradientX, gradientY, row2, col2, depth);
-                        if(neighborMagnitudeSq >= highThresholdSq)
-                        {
-                            suppress = false;
-                            break;
-                        }
-                    }
-
-                    if(!suppress)
-                    {
-                        break;
-                    }
-                }
-
-                return !suppress;
-            }
-            // accept all strong pixels
-            else
-            {
-                return true;
-            }
+            return (*this)(gradient.x, gradient.y);
         }
+
+    private:
+        Scalar _lowThreshold = static_cast<Scalar>(0.078f);
+        Scalar _highThreshold = static_cast<Scalar>(0.3992f);
     };
 }
 
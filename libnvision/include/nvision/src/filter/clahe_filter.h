@@ -0,0 +1,202 @@
+/* clahe_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_CLAHE_FILTER_H_
+#define NVISION_CLAHE_FILTER_H_
+
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/image_histogram.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Filter functor, which applies contrast limited adaptive histogram
+      * equalization (CLAHE) to an 8-bit image.
+      *
+      * The image is divided into a grid of tiles. For each tile a histogram
+      * is computed and clipped at the clip limit, where the clipped counts
+      * are redistributed uniformly over all bins. The resulting lookup tables
+      * of the four nearest tiles are blended bilinearly for each pixel.
+      *
+      * Each channel is equalized independently.
+      * @see https://en.wikipedia.org/wiki/Adaptive_histogram_equalization */
+    template<typename _Scalar>
+    class CLAHEFilter
+    {
+    public:
+        using Scalar = _Scalar;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        CLAHEFilter() = default;
+
+        /** Constructs a CLAHE filter with the given parameters.
+          * @param clipLimit clip limit relative to the average bin count of a tile
+          * @param tilesX number of tiles in horizontal direction
+          * @param tilesY number of tiles in vertical direction */
+        CLAHEFilter(const Scalar clipLimit, const Index tilesX, const Index tilesY)
+        {
+            setClipLimit(clipLimit);
+            setTiles(tilesX, tilesY);
+        }
+
+        /** Sets the clip limit relative to the average bin count of a tile.
+          * Lower values limit the contrast amplification more strongly,
+          * a value of 1 disables the equalization. */
+        void setClipLimit(const Scalar clipLimit)
+        {
+            assert(clipLimit >= Scalar{1});
+            _clipLimit = clipLimit;
+        }
+
+        /** Sets the number of tiles in horizontal and vertical direction. */
+        void setTiles(const Index tilesX, const Index tilesY)
+        {
+            assert(tilesX > 0 && tilesY > 0);
+            _tilesX = tilesX;
+            _tilesY = tilesY;
+        }
+
+        Scalar clipLimit() const
+        {
+            return _clipLimit;
+        }
+
+        /** Applies CLAHE to the given image.
+          * @param img the image on which the filter should be applied.
+          * @return equalized image */
+        template<typename Derived>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(std::is_same<typename ColorSpace::ValueType, uint8>::value, "CLAHE requires 8-bit channels");
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            Image<ColorSpace> result(img.rows(), img.cols());
+            if(img.size() == 0)
+                return result;
+
+            const auto tilesX = std::min(_tilesX, img.cols());
+            const auto tilesY = std::min(_tilesY, img.rows());
+            const auto tileWidth = static_cast<Scalar>(img.cols()) / static_cast<Scalar>(tilesX);
+            const auto tileHeight = static_cast<Scalar>(img.rows()) / static_cast<Scalar>(tilesY);
+
+            // lookup tables of all tiles for all channels, tiles are stored in column-major order
+            std::vector<Eigen::Array<uint8, 256, Dimension>> luts(tilesX * tilesY);
+
+            parallel::forEach(0, tilesX * tilesY, [&](const Index tile)
+            {
+                const auto tx = tile / tilesY;
+                const auto ty = tile % tilesY;
+                const auto col = static_cast<Index>(static_cast<Scalar>(tx) * tileWidth);
+                const auto row = static_cast<Index>(static_cast<Scalar>(ty) * tileHeight);
+                const auto colEnd = tx + 1 == tilesX ? img.cols() : static_cast<Index>(static_cast<Scalar>(tx + 1) * tileWidth);
+                const auto rowEnd = ty + 1 == tilesY ? img.rows() : static_cast<Index>(static_cast<Scalar>(ty + 1) * tileHeight);
+
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    auto hist = image::internal::histogram8(img, d, row, col, rowEnd - row, colEnd - col);
+                    luts[tile].col(d) = computeTable(hist, (rowEnd - row) * (colEnd - col));
+                }
+            });
+
+            // blend the lookup tables of the four surrounding tile centers
+            parallel::forEach(0, img.cols(), [&](const Index c)
+            {
+                Index tx0, tx1;
+                Scalar wx;
+                computeNeighbors(c, tileWidth, tilesX, tx0, tx1, wx);
+
+                for(Index r = 0; r < img.rows(); ++r)
+                {
+                    Index ty0, ty1;
+                    Scalar wy;
+                    computeNeighbors(r, tileHeight, tilesY, ty0, ty1, wy);
+
+                    const auto &lut00 = luts[tx0 * tilesY + ty0];
+                    const auto &lut01 = luts[tx1 * tilesY + ty0];
+                    const auto &lut10 = luts[tx0 * tilesY + ty1];
+                    const auto &lut11 = luts[tx1 * tilesY + ty1];
+
+                    const auto &pixel = img(r, c);
+                    for(Index d = 0; d < Dimension; ++d)
+                    {
+                        const auto v = pixel[d];
+                        const auto top = (Scalar{1} - wx) * static_cast<Scalar>(lut00(v, d)) + wx * static_cast<Scalar>(lut01(v, d));
+                        const auto bottom = (Scalar{1} - wx) * static_cast<Scalar>(lut10(v, d)) + wx * static_cast<Scalar>(lut11(v, d));
+                        const auto value = (Scalar{1} - wy) * top + wy * bottom;
+                        result(r, c)[d] = static_cast<uint8>(value + static_cast<Scalar>(0.5));
+                    }
+                }
+            });
+
+            return result;
+        }
+
+    private:
+        Scalar _clipLimit = Scalar{2};
+        Index _tilesX = 8;
+        Index _tilesY = 8;
+
+        /** Clips the histogram, redistributes the excess and computes the
+          * lookup table from the cumulative distribution. */
+        Eigen::Array<uint8, 256, 1> computeTable(Eigen::Array<Index, 256, 1> &hist, const Index area) const
+        {
+            const auto limit = std::max<Index>(1, static_cast<Index>(_clipLimit * static_cast<Scalar>(area) / Scalar{256}));
+
+            Index excess = 0;
+            for(Index i = 0; i < 256; ++i)
+            {
+                if(hist(i) > limit)
+                {
+                    excess += hist(i) - limit;
+                    hist(i) = limit;
+                }
+            }
+
+            // redistribute the excess uniformly, the remainder is spread
+            // with a constant step over the whole range
+            hist += excess / 256;
+            const auto remainder = excess % 256;
+            if(remainder > 0)
+            {
+                const auto step = std::max<Index>(1, 256 / remainder);
+                for(Index i = 0, cnt = 0; i < 256 && cnt < remainder; i += step, ++cnt)
+                    ++hist(i);
+            }
+
+            Eigen::Array<uint8, 256, 1> lut;
+            const auto factor = Scalar{255} / static_cast<Scalar>(area);
+            Index cdf = 0;
+            for(Index i = 0; i < 256; ++i)
+            {
+                cdf += hist(i);
+                lut(i) = static_cast<uint8>(std::min(Scalar{255}, std::round(static_cast<Scalar>(cdf) * factor)));
+            }
+
+            return lut;
+        }
+
+        /** Determines the two nearest tile centers of a pixel coordinate and
+          * the interpolation weight of the second one. */
+        static void computeNeighbors(const Index idx,
+                                     const Scalar tileSize,
+                                     const Index tiles,
+                                     Index &tile0,
+                                     Index &tile1,
+                                     Scalar &weight)
+        {
+            const auto pos = (static_cast<Scalar>(idx) + static_cast<Scalar>(0.5)) / tileSize - static_cast<Scalar>(0.5);
+            const auto base = std::floor(pos);
+            tile0 = clamp<Index>(static_cast<Index>(base), 0, tiles - 1);
+            tile1 = std::min(tile0 + 1, tiles - 1);
+            weight = pos < Scalar{0} ? Scalar{0} : clamp<Scalar>(pos - base, 0, 1);
+        }
+    };
+}
+
+#endif
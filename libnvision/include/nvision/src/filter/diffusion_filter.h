@@ -7,11 +7,46 @@
 #ifndef NVISION_DIFFUSION_FILTER_H_
 #define NVISION_DIFFUSION_FILTER_H_
 
+#include <type_traits>
+#include <utility>
 #include "nvision/src/filter/central_differences_filter.h"
 #include "nvision/src/core/penalizer_functors.h"
+#include "nvision/src/core/parallel.h"
 
 namespace nvision
 {
+    /** Numerical schemes, which can be used by DiffusionFilter. */
+    struct DiffusionScheme
+    {
+        /** Explicit steps, which are only stable for small flow factors. */
+        struct Explicit {};
+        /** Semi-implicit additive operator splitting, which is stable for
+          * any flow factor. */
+        struct AOS {};
+    };
+
+    /** Filter functor, which applies nonlinear diffusion steps
+      *
+      *   u += flowFactor * div(g(|grad u|^2) * grad u)
+      *
+      * to an image. By default explicit steps are used.
+      *
+      * With central differences the update of a pixel only depends on a
+      * diamond of radius two around it. In this case the whole step is
+      * computed per pixel in a single fused kernel, which ping-pongs between
+      * two buffers and runs in parallel over tiles of rows. Optionally
+      * multiple iterations are applied to each tile while it resides in the
+      * cache (temporal tiling). Each tile then recomputes two additional rows
+      * per iteration on each side, such that the result does not depend on
+      * the tiling. Other gradient filters compute the step with one image
+      * per intermediate term.
+      *
+      * With DiffusionScheme::AOS each step solves one tridiagonal system
+      * per row and per column with the diffusivities of the previous step
+      * (Weickert et al.). The scheme reaches the same diffusion time with
+      * the same product of iterations and flow factor as the explicit
+      * scheme, but remains stable for large flow factors, such that far
+      * fewer iterations are required. */
     template<typename _KernelScalar,
         typename Penalizer=GaussianPenalizer<_KernelScalar>,
         typename GradientFilter=CentralDifferencesFilter<_KernelScalar>>
@@ -48,17 +83,139 @@ namespace nvision
             _penalizer = penalizer;
         }
 
+        /** Sets the number of rows of each tile, which is processed by a
+          * single thread in the fused kernel. */
+        void setTileRows(const Index rows)
+        {
+            assert(rows > 0);
+            _tileRows = rows;
+        }
+
+        /** Sets the number of iterations, which the fused kernel applies to
+          * a tile before moving on to the next one. The tile is extended by
+          * two rows per iteration on each side, which are computed
+          * redundantly. Defaults to one. */
+        void setTileIterations(const Index iterations)
+        {
+            assert(iterations > 0);
+            _tileIterations = iterations;
+        }
+
+        Index tileRows() const
+        {
+            return _tileRows;
+        }
+
+        Index tileIterations() const
+        {
+            return _tileIterations;
+        }
+
         /** Applies the diffusion filter to the given image and returns a expression of the computation.
           * @param img the image on which the box filter should be applied.
           * @param handling the border handling mode; defaults to BorderReflect
           * @return expression of the filter application */
         template<typename Derived, typename BorderHandling=BorderReflect>
         auto operator()(const ImageBase<Derived> &img, const BorderHandling &handling = {}) const
+        {
+            return operator()(img, DiffusionScheme::Explicit(), handling);
+        }
+
+        /** Applies the diffusion filter with explicit steps to the given image.
+          * @param img the image on which the diffusion filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return filtered image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        auto operator()(const ImageBase<Derived> &img,
+            const DiffusionScheme::Explicit,
+            const BorderHandling &handling = {}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
+
+            if constexpr(std::is_same<GradientFilter, CentralDifferencesFilter<KernelScalar>>::value)
+                return applyFused(img, handling);
+            else
+                return applyGeneric(img, handling);
+        }
+
+        /** Applies the diffusion filter with semi-implicit AOS steps to the
+          * given image. The border handling is used for the gradients, which
+          * determine the diffusivities. No flux crosses the image borders.
+          * @param img the image on which the diffusion filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return filtered image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        auto operator()(const ImageBase<Derived> &img,
+            const DiffusionScheme::AOS,
+            const BorderHandling &handling = {}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
             using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
             static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
 
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+
+            // the explicit step differentiates twice with unnormalized
+            // central differences, which spans four times the time step of
+            // the unit grid; both dimensions share the step (factor 2)
+            const auto step = 2 * 4 * _flowFac;
+
+            Image<ColorSpace> u = img;
+            Image<ColorSpace> vertical(rows, cols);
+            Image<ColorSpace> horizontal(rows, cols);
+            if(img.size() == 0)
+                return u;
+
+            for(Index i = 0; i < _iterations; ++i)
+            {
+                const auto gradient = _gradient(u, GradientMode::XY(), handling);
+                const Image<ColorSpace> g = (gradient.x * gradient.x + gradient.y * gradient.y).unaryExpr(_penalizer);
+
+                // systems along the columns are solved for a few columns at
+                // once, systems along the rows for a block of rows, such that
+                // independent systems are interleaved and the memory is
+                // traversed column by column
+                constexpr Index blockCols = 8;
+                parallel::forChunks(cols, blockCols, [&](const Index, const Index begin, const Index end)
+                {
+                    solveSystems(u, g, vertical, rows, end - begin, step, [begin](const Index idx, const Index lane)
+                    {
+                        return std::make_pair(idx, begin + lane);
+                    });
+                });
+
+                constexpr Index blockRows = 16;
+                parallel::forChunks(rows, blockRows, [&](const Index, const Index begin, const Index end)
+                {
+                    solveSystems(u, g, horizontal, cols, end - begin, step, [begin](const Index idx, const Index lane)
+                    {
+                        return std::make_pair(begin + lane, idx);
+                    });
+                });
+
+                u = (vertical + horizontal) * static_cast<KernelScalar>(0.5);
+            }
+
+            return u;
+        }
+
+    private:
+        GradientFilter _gradient = {};
+        Penalizer _penalizer = {};
+
+        Index _iterations = 10;
+        KernelScalar _flowFac = static_cast<KernelScalar>(0.05);
+        Index _tileRows = 32;
+        Index _tileIterations = 1;
+
+        template<typename Derived, typename BorderHandling>
+        auto applyGeneric(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+
             Image<ColorSpace> u = img;
             Image<ColorSpace> ux;
             Image<ColorSpace> uy;
@@ -69,12 +226,11 @@ namespace nvision
             Image<ColorSpace> guxx;
             Image<ColorSpace> guyy;
 
-            Image<ColorSpace> tmp;
             for(Index i = 0; i < _iterations; ++i)
             {
-                tmp = u;
-                ux = _gradient(tmp, GradientMode::X(), handling);
-                uy = _gradient(tmp, GradientMode::Y(), handling);
+                auto gradient = _gradient(u, GradientMode::XY(), handling);
+                ux = std::move(gradient.x);
+                uy = std::move(gradient.y);
 
                 g = (ux * ux + uy * uy).unaryExpr(_penalizer);
 
@@ -91,12 +247,195 @@ namespace nvision
             return u;
         }
 
-    private:
-        GradientFilter _gradient = {};
-        Penalizer _penalizer = {};
+        template<typename Derived, typename BorderHandling>
+        auto applyFused(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
 
-        Index _iterations = 10;
-        KernelScalar _flowFac = static_cast<KernelScalar>(0.05);
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+
+            Image<ColorSpace> u = img;
+            Image<ColorSpace> next(rows, cols);
+            if(img.size() == 0)
+                return u;
+
+            for(Index i = 0; i < _iterations; i += _tileIterations)
+            {
+                const auto iterations = std::min(_tileIterations, _iterations - i);
+                const auto halo = 2 * iterations;
+
+                parallel::forChunks(rows, _tileRows, [&](const Index, const Index begin, const Index end)
+                {
+                    // rows of the tile including the halo; only halos which
+                    // are cut from the image shrink with each iteration, the
+                    // image borders are handled as in the whole image
+                    const auto tileBegin = std::max<Index>(begin - halo, 0);
+                    const auto tileEnd = std::min<Index>(end + halo, rows);
+                    const auto tileRows = tileEnd - tileBegin;
+                    const auto shrinkTop = tileBegin > 0 ? Index{1} : Index{0};
+                    const auto shrinkBottom = tileEnd < rows ? Index{1} : Index{0};
+
+                    Image<ColorSpace> current = u.middleRows(tileBegin, tileRows);
+                    Image<ColorSpace> updated(tileRows, cols);
+                    Image<ColorSpace> fluxX(tileRows, cols);
+                    Image<ColorSpace> fluxY(tileRows, cols);
+
+                    Index validBegin = 0;
+                    Index validEnd = tileRows;
+                    for(Index k = 0; k < iterations; ++k)
+                    {
+                        const auto fluxBegin = validBegin + shrinkTop;
+                        const auto fluxEnd = validEnd - shrinkBottom;
+                        computeFlux(current, fluxX, fluxY, fluxBegin, fluxEnd, handling);
+
+                        validBegin = fluxBegin + shrinkTop;
+                        validEnd = fluxEnd - shrinkBottom;
+                        computeUpdate(current, fluxX, fluxY, updated, validBegin, validEnd, handling);
+
+                        std::swap(current, updated);
+                    }
+
+                    next.middleRows(begin, end - begin) = current.middleRows(begin - tileBegin, end - begin);
+                });
+
+                std::swap(u, next);
+            }
+
+            return u;
+        }
+
+        /** Solves the tridiagonal systems (I - step * A) v = u of the AOS
+          * scheme along multiple lines of the image with the Thomas
+          * algorithm. A is the one-dimensional diffusion operator with the
+          * diffusivities g and reflecting boundaries.
+          * @param length number of pixels of each line
+          * @param lanes number of lines, which are solved simultaneously
+          * @param position functor position(idx, lane), which returns the
+          *        row and column of a pixel of a line */
+        template<typename ColorSpace, typename Position>
+        static void solveSystems(const Image<ColorSpace> &u,
+            const Image<ColorSpace> &g,
+            Image<ColorSpace> &result,
+            const Index length,
+            const Index lanes,
+            const KernelScalar step,
+            const Position &position)
+        {
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            Eigen::Array<KernelScalar, Eigen::Dynamic, Eigen::Dynamic> upper(Dimension * lanes, length);
+            Eigen::Array<KernelScalar, Eigen::Dynamic, 1> weightPrev = Eigen::Array<KernelScalar, Eigen::Dynamic, 1>::Zero(Dimension * lanes);
+
+            // forward elimination
+            for(Index i = 0; i < length; ++i)
+            {
+                for(Index l = 0; l < lanes; ++l)
+                {
+                    const auto [row, col] = position(i, l);
+                    const auto [rowNext, colNext] = position(std::min(i + 1, length - 1), l);
+                    const auto [rowPrev, colPrev] = position(std::max<Index>(i - 1, 0), l);
+
+                    for(Index d = 0; d < Dimension; ++d)
+                    {
+                        const auto k = l * Dimension + d;
+                        const auto weight = i + 1 < length ? step * (g(row, col)[d] + g(rowNext, colNext)[d]) / 2 : KernelScalar{0};
+                        const auto prev = i > 0 ? static_cast<KernelScalar>(result(rowPrev, colPrev)[d]) : KernelScalar{0};
+                        const auto invDiag = 1 / (1 + weightPrev(k) + weight + (i > 0 ? weightPrev(k) * upper(k, i - 1) : KernelScalar{0}));
+                        upper(k, i) = -weight * invDiag;
+                        result(row, col)[d] = (u(row, col)[d] + weightPrev(k) * prev) * invDiag;
+                        weightPrev(k) = weight;
+                    }
+                }
+            }
+
+            // back substitution
+            for(Index i = length - 2; i >= 0; --i)
+            {
+                for(Index l = 0; l < lanes; ++l)
+                {
+                    const auto [row, col] = position(i, l);
+                    const auto [rowNext, colNext] = position(i + 1, l);
+                    for(Index d = 0; d < Dimension; ++d)
+                        result(row, col)[d] -= upper(l * Dimension + d, i) * result(rowNext, colNext)[d];
+                }
+            }
+        }
+
+        /** Returns the pixel at the given position or applies the border
+          * handling if it lies outside of the image. */
+        template<typename ColorSpace, typename BorderHandling>
+        static const Pixel<ColorSpace> &pixelAt(const Image<ColorSpace> &img,
+            const Index row,
+            const Index col,
+            const BorderHandling &handling)
+        {
+            if(row >= 0 && row < img.rows() && col >= 0 && col < img.cols())
+                return img(row, col);
+            else
+                return handling(img, row, col);
+        }
+
+        /** Computes the fluxes g * ux and g * uy of the rows [begin, end). */
+        template<typename ColorSpace, typename BorderHandling>
+        void computeFlux(const Image<ColorSpace> &u,
+            Image<ColorSpace> &fluxX,
+            Image<ColorSpace> &fluxY,
+            const Index begin,
+            const Index end,
+            const BorderHandling &handling) const
+        {
+            for(Index c = 0; c < u.cols(); ++c)
+            {
+                const auto inner = c > 0 && c + 1 < u.cols();
+                for(Index r = begin; r < end; ++r)
+                {
+                    Pixel<ColorSpace> ux;
+                    Pixel<ColorSpace> uy;
+                    if(inner && r > 0 && r + 1 < u.rows())
+                    {
+                        ux = u(r, c + 1) - u(r, c - 1);
+                        uy = u(r + 1, c) - u(r - 1, c);
+                    }
+                    else
+                    {
+                        ux = pixelAt(u, r, c + 1, handling) - pixelAt(u, r, c - 1, handling);
+                        uy = pixelAt(u, r + 1, c, handling) - pixelAt(u, r - 1, c, handling);
+                    }
+                    const Pixel<ColorSpace> g = _penalizer(ux * ux + uy * uy);
+
+                    fluxX(r, c) = g * ux;
+                    fluxY(r, c) = g * uy;
+                }
+            }
+        }
+
+        /** Computes the diffusion step of the rows [begin, end) from the
+          * divergence of the fluxes. */
+        template<typename ColorSpace, typename BorderHandling>
+        void computeUpdate(const Image<ColorSpace> &u,
+            const Image<ColorSpace> &fluxX,
+            const Image<ColorSpace> &fluxY,
+            Image<ColorSpace> &result,
+            const Index begin,
+            const Index end,
+            const BorderHandling &handling) const
+        {
+            for(Index c = 0; c < u.cols(); ++c)
+            {
+                const auto inner = c > 0 && c + 1 < u.cols();
+                for(Index r = begin; r < end; ++r)
+                {
+                    Pixel<ColorSpace> divergence;
+                    if(inner && r > 0 && r + 1 < u.rows())
+                        divergence = (fluxX(r, c + 1) - fluxX(r, c - 1)) + (fluxY(r + 1, c) - fluxY(r - 1, c));
+                    else
+                        divergence = (pixelAt(fluxX, r, c + 1, handling) - pixelAt(fluxX, r, c - 1, handling))
+                            + (pixelAt(fluxY, r + 1, c, handling) - pixelAt(fluxY, r - 1, c, handling));
+                    result(r, c) = u(r, c) + divergence * _flowFac;
+                }
+            }
+        }
     };
 }
 
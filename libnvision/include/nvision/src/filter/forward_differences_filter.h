@@ -19,7 +19,8 @@ namespace nvision
     public:
         using KernelScalar = _KernelScalar;
         static constexpr Index Dimension = 3;
-        using KernelMatrix = Eigen::Matrix<KernelScalar, Dimension, Dimension>;
+        using KernelX = SeparableKernel<KernelTaps<1>, KernelTaps<0, -1, 1>>;
+        using KernelY = SeparableKernel<KernelTaps<0, -1, 1>, KernelTaps<1>>;
 
         static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "Kernel scalar must be floating point");
 
@@ -33,7 +34,7 @@ namespace nvision
             const BorderHandling &handling = BorderHandling{}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
-            return image::filter<1, Dimension>(img, _kernelX, handling);
+            return image::filterSeparable<KernelX, KernelScalar>(img, handling);
         }
 
         /** Applies forward differences in vertical direction to the given image and returns a expression of the computation.
@@ -46,11 +47,37 @@ namespace nvision
             const BorderHandling &handling = BorderHandling{}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
-            return image::filter<Dimension, 1>(img, _kernelY, handling);
+            return image::filterSeparable<KernelY, KernelScalar>(img, handling);
+        }
+
+        /** Applies forward differences in horizontal and vertical direction to the given image in a single sweep.
+          * @param img the image on which the filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return gradients in both directions */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        auto operator()(const ImageBase<Derived> &img,
+            const GradientMode::XY,
+            const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            return internal::computeGradients<KernelX, KernelY, KernelScalar, 0>(img, handling);
+        }
+
+        /** Computes the gradients in horizontal and vertical direction in a
+          * single sweep and passes them to func(row, col, gradX, gradY) for
+          * each pixel, e.g. to accumulate the structure tensor directly.
+          * The gradients are passed as Eigen::Array<KernelScalar, Dimension, 1>.
+          * @param img the image on which the filter should be applied.
+          * @param func functor which receives the gradients of each pixel
+          * @param handling the border handling mode; defaults to BorderReflect */
+        template<typename Derived, typename Func, typename BorderHandling=BorderReflect>
+        void forEachGradient(const ImageBase<Derived> &img,
+            Func &&func,
+            const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            image::forEachGradient<KernelX, KernelY, KernelScalar>(img, handling, std::forward<Func>(func));
         }
-    private:
-        const Eigen::Matrix<KernelScalar, 1, 3> _kernelX{0, -1, 1};
-        const Eigen::Matrix<KernelScalar, 3, 1> _kernelY{0, -1, 1};
     };
 }
 
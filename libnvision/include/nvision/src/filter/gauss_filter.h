@@ -13,7 +13,10 @@ namespace nvision
 {
     /** Filter functor, which applies Gaussian blur to an image.
      *  A kernel size which is greater than ceil(6 * sigma) brings no advantage
-     *  in precision. */
+     *  in precision.
+     *  If the kernel scalar is int16, the kernel is quantized with 14
+     *  fractional bits and images with integral values are filtered in fixed
+     *  point arithmetic. */
     template<typename _KernelScalar, Index _Dimension>
     class GaussFilter
     {
@@ -21,21 +24,25 @@ namespace nvision
         using KernelScalar = _KernelScalar;
         static constexpr Index Dimension = _Dimension;
         using KernelMatrix = Eigen::Matrix<KernelScalar, Dimension, Dimension>;
+        /** Scalar type of sigma, which is floating point for fixed point kernels. */
+        using Scalar = std::conditional_t<std::is_integral<KernelScalar>::value, float32, KernelScalar>;
+        /** Number of fractional bits of the kernel in fixed point arithmetic. */
+        static constexpr Index Shift = 14;
 
-        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "Kernel scalar must be floating point");
+        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0 || std::is_same<KernelScalar, int16>::value, "Kernel scalar must be floating point or int16");
         static_assert(Dimension % 2 == 1, "Kernel must have odd dimension");
 
         GaussFilter()
-            : GaussFilter(KernelScalar{1})
+            : GaussFilter(Scalar{1})
         { }
 
-        GaussFilter(const KernelScalar sigma)
+        GaussFilter(const Scalar sigma)
             : _sigma(sigma)
         {
             computeKernel();
         }
 
-        KernelScalar sigma() const
+        Scalar sigma() const
         {
             return _sigma;
         }
@@ -53,25 +60,33 @@ namespace nvision
         auto operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
-            return image::filter<Dimension, Dimension>(img, _kernel, handling);
+            if constexpr (std::is_integral<KernelScalar>::value)
+            {
+                using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+                return image::filterFixedPoint<Dimension, Dimension, ColorSpace>(img, _kernel, Shift, handling);
+            }
+            else
+            {
+                return image::filter<Dimension, Dimension>(img, _kernel, handling);
+            }
         }
 
     private:
-        const KernelScalar _sigma = KernelScalar{1};
+        Scalar _sigma = Scalar{1};
         KernelMatrix _kernel = {};
 
         void computeKernel()
         {
             constexpr auto rowHalf = Dimension / 2;
-            Eigen::Matrix<KernelScalar, Dimension, 1> vector;
+            Eigen::Matrix<Scalar, Dimension, 1> vector;
 
             for(Index i = 0; i < rowHalf + 1; ++i)
             {
                 const auto idxA = rowHalf - i;
                 const auto idxB = rowHalf + i;
 
-                const auto numerator = static_cast<KernelScalar>(i) * static_cast<KernelScalar>(i);
-                const auto denominator = KernelScalar{2} * _sigma * _sigma;
+                const auto numerator = static_cast<Scalar>(i) * static_cast<Scalar>(i);
+                const auto denominator = Scalar{2} * _sigma * _sigma;
                 // omit gauss normalization factor
                 // the kernel is normalized after the loop
                 const auto value = std::exp(-numerator / denominator);
@@ -84,7 +99,20 @@ namespace nvision
             // normalize kernel such that sum of elements is one
             // if it is not normalized, the image becomes darker
             vector /= vector.sum();
-            _kernel = vector * vector.transpose();
+
+            if constexpr (std::is_integral<KernelScalar>::value)
+            {
+                // quantize the kernel and assign the rounding error to the
+                // center, such that the kernel sums up to exactly 2^Shift
+                constexpr auto scale = static_cast<Scalar>(Index{1} << Shift);
+                const Eigen::Matrix<Scalar, Dimension, Dimension> kernel = vector * vector.transpose() * scale;
+                _kernel = kernel.array().round().template cast<KernelScalar>().matrix();
+                _kernel(rowHalf, rowHalf) += static_cast<KernelScalar>((Index{1} << Shift) - _kernel.template cast<Index>().sum());
+            }
+            else
+            {
+                _kernel = vector * vector.transpose();
+            }
         }
     };
 
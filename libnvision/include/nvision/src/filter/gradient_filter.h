@@ -7,13 +7,149 @@
 #ifndef NVISION_GRADIENT_FILTER_H_
 #define NVISION_GRADIENT_FILTER_H_
 
+#include "nvision/src/core/image.h"
+
 namespace nvision
 {
     struct GradientMode
     {
         struct X {};
         struct Y {};
+        struct XY {};
+    };
+
+    /** Gradients of an image in horizontal and vertical direction, which
+      * are computed by a gradient filter with GradientMode::XY. */
+    template<typename _ColorSpace>
+    struct ImageGradient
+    {
+        using ColorSpace = _ColorSpace;
+
+        Image<ColorSpace> x;
+        Image<ColorSpace> y;
     };
+
+    namespace internal
+    {
+        /** Computes both gradients of a compile-time kernel pair in a single
+          * sweep. Integral kernel scalars select the fixed point path, which
+          * stores the gradients in the signed 16-bit color space. */
+        template<typename KernelX, typename KernelY, typename KernelScalar, Index Shift, typename Derived, typename BorderHandling>
+        auto computeGradients(const ImageBase<Derived> &img, const BorderHandling &handling)
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            constexpr bool fixedPoint = std::is_integral<KernelScalar>::value;
+            using OutputColorSpace = typename std::conditional_t<fixedPoint, GetSignedColorSpace<ColorSpace>, std::type_identity<ColorSpace>>::type;
+            using OutputValueType = typename OutputColorSpace::ValueType;
+            using Accumulator = std::conditional_t<fixedPoint, int32, KernelScalar>;
+
+            ImageGradient<OutputColorSpace> result;
+            result.x.resize(img.rows(), img.cols());
+            result.y.resize(img.rows(), img.cols());
+
+            image::forEachGradient<KernelX, KernelY, Accumulator>(img, handling,
+                [&result](const Index row, const Index col, const auto &gradX, const auto &gradY)
+            {
+                for(Index d = 0; d < OutputColorSpace::Dimension; ++d)
+                {
+                    if constexpr (fixedPoint)
+                    {
+                        result.x(row, col)[d] = image::internal::fixedPointValue<OutputValueType>(gradX(d), Shift);
+                        result.y(row, col)[d] = image::internal::fixedPointValue<OutputValueType>(gradY(d), Shift);
+                    }
+                    else
+                    {
+                        result.x(row, col)[d] = static_cast<OutputValueType>(gradX(d));
+                        result.y(row, col)[d] = static_cast<OutputValueType>(gradY(d));
+                    }
+                }
+            });
+
+            return result;
+        }
+    }
+
+    namespace image
+    {
+        /** Computes the products of the image gradients, which make up the
+          * structure tensor, in a single sweep of the gradient filter.
+          * The gradient filter must provide forEachGradient().
+          * The gradients are converted to the value type of the image before
+          * the products are computed.
+          * @param gradient gradient filter
+          * @param img input image
+          * @param productXX squared horizontal gradients
+          * @param productYY squared vertical gradients
+          * @param productXY products of horizontal and vertical gradients */
+        template<typename GradientFilter, typename Derived, typename ColorSpace>
+        inline void gradientProducts(const GradientFilter &gradient,
+                                     const ImageBase<Derived> &img,
+                                     Image<ColorSpace> &productXX,
+                                     Image<ColorSpace> &productYY,
+                                     Image<ColorSpace> &productXY)
+        {
+            using ValueType = typename ColorSpace::ValueType;
+
+            productXX.resize(img.rows(), img.cols());
+            productYY.resize(img.rows(), img.cols());
+            productXY.resize(img.rows(), img.cols());
+
+            gradient.forEachGradient(img, [&](const Index row, const Index col, const auto &gradX, const auto &gradY)
+            {
+                for(Index d = 0; d < ColorSpace::Dimension; ++d)
+                {
+                    const auto x = static_cast<ValueType>(gradX(d));
+                    const auto y = static_cast<ValueType>(gradY(d));
+                    productXX(row, col)[d] = static_cast<ValueType>(x * x);
+                    productYY(row, col)[d] = static_cast<ValueType>(y * y);
+                    productXY(row, col)[d] = static_cast<ValueType>(x * y);
+                }
+            });
+        }
+
+        /** Computes the gradient magnitude of each channel and returns a
+          * expression of the computation. Magnitudes of integral gradients
+          * are rounded and saturated.
+          * @param gradient gradients in horizontal and vertical direction
+          * @return expression of the gradient magnitude */
+        template<typename ColorSpace>
+        inline auto magnitude(const ImageGradient<ColorSpace> &gradient)
+        {
+            using ValueType = typename ColorSpace::ValueType;
+            using Scalar = std::conditional_t<std::is_integral<ValueType>::value, float32, ValueType>;
+
+            return gradient.x.binaryExpr(gradient.y, [](const Pixel<ColorSpace> &gradX, const Pixel<ColorSpace> &gradY)
+            {
+                Pixel<ColorSpace> result;
+                for(Index d = 0; d < ColorSpace::Dimension; ++d)
+                {
+                    const auto x = static_cast<Scalar>(gradX[d]);
+                    const auto y = static_cast<Scalar>(gradY[d]);
+                    result[d] = roundCast<ValueType>(std::sqrt(x * x + y * y));
+                }
+                return result;
+            });
+        }
+
+        /** Computes the gradient direction of each channel in radians in
+          * the interval [-pi, pi] and returns a expression of the computation.
+          * @param gradient gradients in horizontal and vertical direction
+          * @return expression of the gradient direction */
+        template<typename ColorSpace>
+        inline auto direction(const ImageGradient<ColorSpace> &gradient)
+        {
+            using ValueType = typename ColorSpace::ValueType;
+            static_assert(Eigen::NumTraits<ValueType>::IsInteger == 0, "gradient direction requires floating point values");
+
+            return gradient.x.binaryExpr(gradient.y, [](const Pixel<ColorSpace> &gradX, const Pixel<ColorSpace> &gradY)
+            {
+                Pixel<ColorSpace> result;
+                for(Index d = 0; d < ColorSpace::Dimension; ++d)
+                    result[d] = fastAtan2(gradY[d], gradX[d]);
+                return result;
+            });
+        }
+    }
 }
 
 #endif
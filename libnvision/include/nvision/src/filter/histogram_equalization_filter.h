@@ -0,0 +1,89 @@
+/* histogram_equalization_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_HISTOGRAM_EQUALIZATION_FILTER_H_
+#define NVISION_HISTOGRAM_EQUALIZATION_FILTER_H_
+
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/image_histogram.h"
+
+namespace nvision
+{
+    namespace internal
+    {
+        /** Computes the lookup table of a histogram equalization from the
+          * given histogram. Values are mapped according to the cumulative
+          * distribution, such that the lowest occurring value maps to 0. */
+        inline Eigen::Array<uint8, 256, 1> equalizationTable(const Eigen::Array<Index, 256, 1> &hist)
+        {
+            Eigen::Array<uint8, 256, 1> lut;
+
+            const auto total = hist.sum();
+            Index first = 0;
+            while(first < 256 && hist(first) == 0)
+                ++first;
+
+            // images with a single value cannot be equalized
+            if(first == 256 || hist(first) == total)
+            {
+                for(Index i = 0; i < 256; ++i)
+                    lut(i) = static_cast<uint8>(i);
+                return lut;
+            }
+
+            const auto cdfMin = hist(first);
+            const auto factor = float32{255} / static_cast<float32>(total - cdfMin);
+            Index cdf = 0;
+            for(Index i = 0; i < 256; ++i)
+            {
+                cdf += hist(i);
+                const auto value = std::round(static_cast<float32>(std::max<Index>(cdf - cdfMin, 0)) * factor);
+                lut(i) = static_cast<uint8>(value);
+            }
+
+            return lut;
+        }
+    }
+
+    /** Filter functor, which applies global histogram equalization to an
+      * 8-bit image.
+      * Each channel is equalized independently by mapping its values through
+      * the cumulative distribution of its histogram. */
+    class HistogramEqualizationFilter
+    {
+    public:
+        HistogramEqualizationFilter() = default;
+
+        /** Applies the histogram equalization to the given image and returns a expression of the computation.
+          * The histogram is computed immediately, the returned expression only
+          * performs the value lookup.
+          * @param img the image on which the equalization should be applied.
+          * @return expression of the equalization */
+        template<typename Derived>
+        auto operator()(const ImageBase<Derived> &img) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(std::is_same<typename ColorSpace::ValueType, uint8>::value, "histogram equalization requires 8-bit channels");
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            const auto hist = image::histogram(img);
+            Eigen::Array<uint8, 256, Dimension> lut;
+            for(Index d = 0; d < Dimension; ++d)
+                lut.col(d) = internal::equalizationTable(hist.col(d));
+
+            return img.unaryExpr([lut](const Pixel<ColorSpace> &pixel)
+            {
+                Pixel<ColorSpace> result;
+                for(Index d = 0; d < Dimension; ++d)
+                    result[d] = lut(pixel[d], d);
+                return result;
+            });
+        }
+    };
+}
+
+#endif
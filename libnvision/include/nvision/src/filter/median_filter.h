@@ -0,0 +1,325 @@
+/* median_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_MEDIAN_FILTER_H_
+#define NVISION_MEDIAN_FILTER_H_
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    namespace internal
+    {
+        using MedianPlane = Eigen::Array<uint8, Eigen::Dynamic, Eigen::Dynamic>;
+
+        /** Selection network, which moves the median of 9 values to index 4
+          * (Paeth). */
+        constexpr std::array<std::pair<int, int>, 19> MedianNetwork9 = {{
+            {1, 2}, {4, 5}, {7, 8}, {0, 1}, {3, 4}, {6, 7}, {1, 2}, {4, 5},
+            {7, 8}, {0, 3}, {5, 8}, {4, 7}, {3, 6}, {1, 4}, {2, 5}, {4, 7},
+            {4, 2}, {6, 4}, {4, 2}
+        }};
+
+        /** Selection network, which moves the median of 25 values to index 12
+          * (Devillard). */
+        constexpr std::array<std::pair<int, int>, 99> MedianNetwork25 = {{
+            {0, 1}, {3, 4}, {2, 4}, {2, 3}, {6, 7}, {5, 7}, {5, 6}, {9, 10},
+            {8, 10}, {8, 9}, {12, 13}, {11, 13}, {11, 12}, {15, 16}, {14, 16}, {14, 15},
+            {18, 19}, {17, 19}, {17, 18}, {21, 22}, {20, 22}, {20, 21}, {23, 24}, {2, 5},
+            {3, 6}, {0, 6}, {0, 3}, {4, 7}, {1, 7}, {1, 4}, {11, 14}, {8, 14},
+            {8, 11}, {12, 15}, {9, 15}, {9, 12}, {13, 16}, {10, 16}, {10, 13}, {20, 23},
+            {17, 23}, {17, 20}, {21, 24}, {18, 24}, {18, 21}, {19, 22}, {8, 17}, {9, 18},
+            {0, 18}, {0, 9}, {10, 19}, {1, 19}, {1, 10}, {11, 20}, {2, 20}, {2, 11},
+            {12, 21}, {3, 21}, {3, 12}, {13, 22}, {4, 22}, {4, 13}, {14, 23}, {5, 23},
+            {5, 14}, {15, 24}, {6, 24}, {6, 15}, {7, 16}, {7, 19}, {13, 21}, {15, 23},
+            {7, 13}, {7, 15}, {1, 9}, {3, 11}, {5, 17}, {11, 17}, {9, 17}, {4, 10},
+            {6, 12}, {7, 14}, {4, 6}, {4, 7}, {12, 14}, {10, 14}, {6, 7}, {10, 12},
+            {6, 10}, {6, 17}, {12, 17}, {7, 17}, {7, 10}, {12, 18}, {7, 12}, {10, 18},
+            {12, 20}, {10, 20}, {10, 12}
+        }};
+
+        /** Computes the median of all square windows of the given padded
+          * plane with a selection network.
+          * The windows of a block of consecutive rows are gathered into
+          * fixed-size lanes, such that every comparison of the network is
+          * applied to all lanes at once, which the compiler vectorizes.
+          * @param padded plane with a margin of Size / 2 on each side
+          * @param network selection network for Size * Size values
+          * @param func functor func(row, col, value), which receives the medians */
+        template<Index Size, std::size_t Count, typename Func>
+        inline void medianNetwork(const MedianPlane &padded,
+            const std::array<std::pair<int, int>, Count> &network,
+            Func &&func)
+        {
+            constexpr Index Lanes = 32;
+            const auto rows = padded.rows() - Size + 1;
+            const auto cols = padded.cols() - Size + 1;
+
+            std::array<std::array<uint8, Lanes>, Size * Size> window = {};
+            std::array<uint8, Lanes> minimum;
+            std::array<uint8, Lanes> maximum;
+            for(Index c = 0; c < cols; ++c)
+            {
+                for(Index block = 0; block < rows; block += Lanes)
+                {
+                    const auto len = std::min(Lanes, rows - block);
+                    for(Index j = 0; j < Size; ++j)
+                    {
+                        const uint8 *column = padded.col(c + j).data() + block;
+                        for(Index i = 0; i < Size; ++i)
+                            std::copy_n(column + i, len, window[j * Size + i].begin());
+                    }
+
+                    for(const auto &pair : network)
+                    {
+                        auto &lhs = window[pair.first];
+                        auto &rhs = window[pair.second];
+                        for(Index l = 0; l < Lanes; ++l)
+                        {
+                            minimum[l] = std::min(lhs[l], rhs[l]);
+                            maximum[l] = std::max(lhs[l], rhs[l]);
+                        }
+                        lhs = minimum;
+                        rhs = maximum;
+                    }
+
+                    const auto &median = window[Size * Size / 2];
+                    for(Index l = 0; l < len; ++l)
+                        func(block + l, c, median[l]);
+                }
+            }
+        }
+
+        /** Computes the median of all square windows of the given padded
+          * plane with sliding histograms (Perreau et al.).
+          * Each row of the plane keeps a histogram of the size values around
+          * the current column, which is updated with one insertion and one
+          * removal when moving to the next column. The histogram of the
+          * window is moved down the column by adding the histogram of the
+          * entering row and subtracting the one of the leaving row.
+          * Only the coarse histogram with 16 bins is updated in each step. It
+          * locates the coarse bin of the median, whose 16 fine bins are then
+          * brought up to date lazily. The window of the first row is updated
+          * along with the row histograms, such that the cost per pixel does
+          * not depend on the window size.
+          * @param padded plane with a margin of size / 2 on each side
+          * @param size width of the window
+          * @param func functor func(row, col, value), which receives the medians */
+        template<typename Func>
+        inline void medianHistogram(const MedianPlane &padded, const Index size, Func &&func)
+        {
+            using FineHistogram = Eigen::Array<uint16, 256, 1>;
+            using CoarseHistogram = Eigen::Array<uint16, 16, 1>;
+            using FineHistograms = Eigen::Array<uint16, 256, Eigen::Dynamic>;
+            using CoarseHistograms = Eigen::Array<uint16, 16, Eigen::Dynamic>;
+
+            const auto paddedRows = padded.rows();
+            const auto rows = paddedRows - size + 1;
+            const auto cols = padded.cols() - size + 1;
+            const auto target = size * size / 2;
+
+            FineHistograms fine = FineHistograms::Zero(256, paddedRows);
+            CoarseHistograms coarse = CoarseHistograms::Zero(16, paddedRows);
+            for(Index c = 0; c < size; ++c)
+            {
+                for(Index r = 0; r < paddedRows; ++r)
+                {
+                    const auto value = padded(r, c);
+                    ++fine(value, r);
+                    ++coarse(value >> 4, r);
+                }
+            }
+
+            // window of the first row of the current column
+            FineHistogram topFine = fine.leftCols(size).rowwise().sum();
+            CoarseHistogram topCoarse = coarse.leftCols(size).rowwise().sum();
+
+            FineHistogram windowFine;
+            CoarseHistogram windowCoarse;
+            // row for which each coarse bin of windowFine is up to date
+            Eigen::Array<Index, 16, 1> synced;
+            for(Index c = 0; c < cols; ++c)
+            {
+                if(c > 0)
+                {
+                    for(Index r = 0; r < paddedRows; ++r)
+                    {
+                        const auto removed = padded(r, c - 1);
+                        const auto added = padded(r, c + size - 1);
+                        --fine(removed, r);
+                        --coarse(removed >> 4, r);
+                        ++fine(added, r);
+                        ++coarse(added >> 4, r);
+
+                        if(r < size)
+                        {
+                            --topFine(removed);
+                            --topCoarse(removed >> 4);
+                            ++topFine(added);
+                            ++topCoarse(added >> 4);
+                        }
+                    }
+                }
+
+                windowFine = topFine;
+                windowCoarse = topCoarse;
+                synced.setZero();
+                for(Index r = 0; r < rows; ++r)
+                {
+                    if(r > 0)
+                        windowCoarse += coarse.col(r + size - 1) - coarse.col(r - 1);
+
+                    Index count = 0;
+                    Index bin = 0;
+                    while(count + windowCoarse(bin) <= target)
+                        count += windowCoarse(bin++);
+
+                    const auto offset = bin << 4;
+                    auto segment = windowFine.template segment<16>(offset);
+                    if(r - synced(bin) > size)
+                    {
+                        segment = fine.block(offset, r, 16, size).rowwise().sum();
+                    }
+                    else
+                    {
+                        for(Index k = synced(bin) + 1; k <= r; ++k)
+                            segment += fine.template block<16, 1>(offset, k + size - 1) - fine.template block<16, 1>(offset, k - 1);
+                    }
+                    synced(bin) = r;
+
+                    Index value = offset;
+                    while(count + windowFine(value) <= target)
+                        count += windowFine(value++);
+
+                    func(r, c, static_cast<uint8>(value));
+                }
+            }
+        }
+    }
+
+    /** Filter functor, which replaces each pixel by the median of its square
+      * neighbourhood. The median removes salt-and-pepper noise while
+      * preserving edges.
+      *
+      * The filter works on color spaces with 8-bit values, each channel is
+      * filtered independently. Kernels of size 3 and 5 use selection
+      * networks, larger kernels use sliding histograms with constant cost
+      * per pixel.
+      *
+      * The image is processed in parallel bands of rows, each band is padded
+      * with the border handling once before it is filtered. */
+    class MedianFilter
+    {
+    public:
+        MedianFilter() = default;
+
+        /** Constructs a median filter with the given radius.
+          * @param radius radius of the kernel, the kernel has size 2 * radius + 1 */
+        explicit MedianFilter(const Index radius)
+        {
+            setRadius(radius);
+        }
+
+        /** Sets the radius of the kernel. The kernel has size 2 * radius + 1.
+          * The radius must be smaller than 128. */
+        void setRadius(const Index radius)
+        {
+            assert(radius >= 0);
+            assert(radius < 128);
+            _radius = radius;
+        }
+
+        Index radius() const
+        {
+            return _radius;
+        }
+
+        /** Returns the size of the kernel. */
+        Index size() const
+        {
+            return 2 * _radius + 1;
+        }
+
+        /** Applies the median filter to the given image.
+          * For BorderReflect the radius must be smaller than the size of
+          * the image.
+          * @param img the image on which the median filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return filtered image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            static_assert(std::is_same<typename ColorSpace::ValueType, uint8>::value, "median filter requires 8-bit color space");
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto radius = _radius;
+            const auto size = 2 * radius + 1;
+
+            Image<ColorSpace> result(rows, cols);
+            if(img.size() == 0)
+                return result;
+            if(radius == 0)
+            {
+                result = img;
+                return result;
+            }
+
+            constexpr Index bandRows = 256;
+            parallel::forChunks(rows, bandRows, [&](const Index, const Index begin, const Index end)
+            {
+                const auto height = end - begin;
+
+                // pad the band with the border handling
+                std::array<internal::MedianPlane, Dimension> padded;
+                for(auto &plane : padded)
+                    plane.resize(height + 2 * radius, cols + 2 * radius);
+
+                for(Index c = 0; c < cols + 2 * radius; ++c)
+                {
+                    const auto col = c - radius;
+                    for(Index r = 0; r < height + 2 * radius; ++r)
+                    {
+                        const auto row = begin + r - radius;
+                        const auto &pixel = row >= 0 && row < rows && col >= 0 && col < cols ? img(row, col) : handling(img, row, col);
+                        for(Index d = 0; d < Dimension; ++d)
+                            padded[d](r, c) = pixel[d];
+                    }
+                }
+
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    const auto store = [&result, begin, d](const Index r, const Index c, const uint8 value)
+                    {
+                        result(begin + r, c)[d] = value;
+                    };
+
+                    switch(size)
+                    {
+                    case 3: internal::medianNetwork<3>(padded[d], internal::MedianNetwork9, store); break;
+                    case 5: internal::medianNetwork<5>(padded[d], internal::MedianNetwork25, store); break;
+                    default: internal::medianHistogram(padded[d], size, store); break;
+                    }
+                }
+            });
+
+            return result;
+        }
+
+    private:
+        Index _radius = 1;
+    };
+}
+
+#endif
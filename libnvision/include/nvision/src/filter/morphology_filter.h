@@ -0,0 +1,722 @@
+/* morphology_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_MORPHOLOGY_FILTER_H_
+#define NVISION_MORPHOLOGY_FILTER_H_
+
+#include <array>
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    struct MorphologyShape
+    {
+        /** All pixels of the rows x cols neighbourhood. */
+        struct Rectangle {};
+        /** The center row and the center column of the rows x cols neighbourhood. */
+        struct Cross {};
+    };
+
+    namespace internal
+    {
+        /** Minimum operation of the erosion. */
+        struct MorphologyMin
+        {
+            template<typename T>
+            static T scalar(const T lhs, const T rhs)
+            {
+                return rhs < lhs ? rhs : lhs;
+            }
+
+            template<typename Lhs, typename Rhs>
+            static auto array(const Lhs &lhs, const Rhs &rhs)
+            {
+                return lhs.min(rhs);
+            }
+
+            /** Combines bit-packed binary values. */
+            static uint64 bits(const uint64 lhs, const uint64 rhs)
+            {
+                return lhs & rhs;
+            }
+
+            /** Mask, which maps the bitwise operation onto a conjunction. */
+            static constexpr uint64 complement = 0;
+        };
+
+        /** Maximum operation of the dilation. */
+        struct MorphologyMax
+        {
+            template<typename T>
+            static T scalar(const T lhs, const T rhs)
+            {
+                return lhs < rhs ? rhs : lhs;
+            }
+
+            template<typename Lhs, typename Rhs>
+            static auto array(const Lhs &lhs, const Rhs &rhs)
+            {
+                return lhs.max(rhs);
+            }
+
+            /** Combines bit-packed binary values. */
+            static uint64 bits(const uint64 lhs, const uint64 rhs)
+            {
+                return lhs | rhs;
+            }
+
+            /** Mask, which maps the bitwise operation onto a conjunction. */
+            static constexpr uint64 complement = ~uint64{0};
+        };
+
+        /** Adapts the bitwise operation of a morphology operation to the
+          * scalar interface. */
+        template<typename Operation>
+        struct MorphologyBits
+        {
+            static uint64 scalar(const uint64 lhs, const uint64 rhs)
+            {
+                return Operation::bits(lhs, rhs);
+            }
+        };
+
+        /** Computes the minimum or maximum of all windows of the given size
+          * along a line with the algorithm of van Herk and Gil-Werman.
+          * The line is split into blocks of the window size. Each window
+          * spans at most two blocks and is combined from the suffix of the
+          * first and the prefix of the second block, which requires three
+          * operations per value for any window size.
+          * @param input line of length n + size - 1
+          * @param output line of length n; output(i) combines input(i) to input(i + size - 1)
+          * @param prefix buffer of the same length as the input
+          * @param suffix buffer of the same length as the input */
+        template<typename Operation, typename Input, typename Output, typename Buffer>
+        inline void vanHerkGilWerman(const Input &input, Output &output, const Index size, Buffer &prefix, Buffer &suffix)
+        {
+            const auto len = input.size();
+            for(Index i = 0; i < len; ++i)
+                prefix(i) = i % size == 0 ? input(i) : Operation::scalar(prefix(i - 1), input(i));
+            for(Index i = len - 1; i >= 0; --i)
+                suffix(i) = i % size == size - 1 || i == len - 1 ? input(i) : Operation::scalar(suffix(i + 1), input(i));
+            for(Index i = 0; i < output.size(); ++i)
+                output(i) = Operation::scalar(suffix(i), prefix(i + size - 1));
+        }
+
+        /** Applies the van Herk and Gil-Werman algorithm along the rows of
+          * the given planes, processing whole column segments at once.
+          * @param input planes with cols + size - 1 columns
+          * @param size window size
+          * @return planes with cols columns */
+        template<typename Operation, typename Plane, std::size_t Dimension>
+        inline std::array<Plane, Dimension> vanHerkGilWermanRows(const std::array<Plane, Dimension> &input, const Index size)
+        {
+            const auto rows = input[0].rows();
+            const auto len = input[0].cols();
+            const auto cols = len - size + 1;
+
+            std::array<Plane, Dimension> output;
+            for(auto &plane : output)
+                plane.resize(rows, cols);
+
+            constexpr Index bandRows = 256;
+            parallel::forChunks(rows, bandRows, [&](const Index, const Index begin, const Index end)
+            {
+                const auto height = end - begin;
+                Plane prefix(height, len);
+                Plane suffix(height, len);
+
+                for(std::size_t d = 0; d < Dimension; ++d)
+                {
+                    const auto block = input[d].middleRows(begin, height);
+                    for(Index i = 0; i < len; ++i)
+                    {
+                        if(i % size == 0)
+                            prefix.col(i) = block.col(i);
+                        else
+                            prefix.col(i) = Operation::array(prefix.col(i - 1), block.col(i));
+                    }
+                    for(Index i = len - 1; i >= 0; --i)
+                    {
+                        if(i % size == size - 1 || i == len - 1)
+                            suffix.col(i) = block.col(i);
+                        else
+                            suffix.col(i) = Operation::array(suffix.col(i + 1), block.col(i));
+                    }
+                    for(Index i = 0; i < cols; ++i)
+                        output[d].col(i).segment(begin, height) = Operation::array(suffix.col(i), prefix.col(i + size - 1));
+                }
+            });
+
+            return output;
+        }
+
+        /** Shifts a bit-packed column towards lower row indices, i.e. bit
+          * r of the result is bit r + shift of the input. */
+        template<typename Column>
+        inline Eigen::Array<uint64, Eigen::Dynamic, 1> shiftBits(const Column &column, const Index shift)
+        {
+            const auto words = column.size();
+            const auto wordShift = shift / 64;
+            const auto bitShift = shift % 64;
+
+            Eigen::Array<uint64, Eigen::Dynamic, 1> result(words);
+            for(Index i = 0; i < words; ++i)
+            {
+                const auto lower = i + wordShift < words ? column(i + wordShift) : uint64{0};
+                const auto upper = i + wordShift + 1 < words ? column(i + wordShift + 1) : uint64{0};
+                result(i) = bitShift == 0 ? lower : (lower >> bitShift) | (upper << (64 - bitShift));
+            }
+            return result;
+        }
+
+        /** Shifts a bit-packed column by one bit towards higher row indices,
+          * i.e. bit r of the result is bit r - 1 of the input. */
+        template<typename Column>
+        inline Eigen::Array<uint64, Eigen::Dynamic, 1> shiftBitUp(const Column &column)
+        {
+            Eigen::Array<uint64, Eigen::Dynamic, 1> result(column.size());
+            uint64 carry = 0;
+            for(Index i = 0; i < column.size(); ++i)
+            {
+                result(i) = (column(i) << 1) | carry;
+                carry = column(i) >> 63;
+            }
+            return result;
+        }
+
+        /** Reverses the order of the bits of a word. */
+        inline uint64 reverseBits(uint64 word)
+        {
+            word = ((word >> 1) & 0x5555555555555555ull) | ((word & 0x5555555555555555ull) << 1);
+            word = ((word >> 2) & 0x3333333333333333ull) | ((word & 0x3333333333333333ull) << 2);
+            word = ((word >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((word & 0x0F0F0F0F0F0F0F0Full) << 4);
+            word = ((word >> 8) & 0x00FF00FF00FF00FFull) | ((word & 0x00FF00FF00FF00FFull) << 8);
+            word = ((word >> 16) & 0x0000FFFF0000FFFFull) | ((word & 0x0000FFFF0000FFFFull) << 16);
+            return (word >> 32) | (word << 32);
+        }
+
+        /** Reverses the order of all bits of a bit-packed column. */
+        template<typename Column>
+        inline Eigen::Array<uint64, Eigen::Dynamic, 1> reverseBits(const Column &column)
+        {
+            const auto words = column.size();
+            Eigen::Array<uint64, Eigen::Dynamic, 1> result(words);
+            for(Index i = 0; i < words; ++i)
+                result(i) = reverseBits(column(words - 1 - i));
+            return result;
+        }
+
+        /** Blocks of the van Herk and Gil-Werman algorithm on a bit-packed
+          * column, given by masks of their first and their last bits. The
+          * reversed masks describe the same blocks on the reversed column. */
+        struct BitBlocks
+        {
+            Eigen::Array<uint64, Eigen::Dynamic, 1> starts;
+            Eigen::Array<uint64, Eigen::Dynamic, 1> ends;
+            Eigen::Array<uint64, Eigen::Dynamic, 1> reversedStarts;
+            Eigen::Array<uint64, Eigen::Dynamic, 1> reversedEnds;
+
+            BitBlocks(const Index words, const Index size)
+                : starts(Eigen::Array<uint64, Eigen::Dynamic, 1>::Zero(words)),
+                ends(Eigen::Array<uint64, Eigen::Dynamic, 1>::Zero(words))
+            {
+                const auto bits = 64 * words;
+                for(Index i = 0; i < bits; i += size)
+                {
+                    const auto last = std::min(i + size, bits) - 1;
+                    starts(i / 64) |= uint64{1} << (i % 64);
+                    ends(last / 64) |= uint64{1} << (last % 64);
+                }
+
+                reversedStarts = reverseBits(ends);
+                reversedEnds = reverseBits(starts);
+            }
+        };
+
+        /** Computes the conjunction of each bit with all preceding bits of
+          * its block, i.e. bit r of the result is set if all bits from the
+          * start of its block up to r are set.
+          * The run of set bits at the start of each block is found by
+          * adding one at the block start, whose carry propagates through
+          * the run. The last bit of each block is excluded from the addition,
+          * so the carry never leaves its block. This requires a constant
+          * number of operations per word for any block size. */
+        template<typename Column, typename Mask>
+        inline Eigen::Array<uint64, Eigen::Dynamic, 1> blockPrefixAnd(const Column &column, const Mask &starts, const Mask &ends)
+        {
+            const auto words = column.size();
+            Eigen::Array<uint64, Eigen::Dynamic, 1> runs(words);
+
+            uint64 carry = 0;
+            for(Index i = 0; i < words; ++i)
+            {
+                const auto open = column(i) & ~ends(i);
+                const auto seed = column(i) & starts(i);
+                const auto partial = open + seed;
+                const auto sum = partial + carry;
+                carry = (partial < open || sum < partial) ? uint64{1} : uint64{0};
+                runs(i) = (sum ^ open) & open;
+            }
+
+            // the last bit of a block is set if its predecessor belongs to
+            // the run or if the block consists of a single bit
+            const auto previous = shiftBitUp(runs);
+            for(Index i = 0; i < words; ++i)
+                runs(i) |= ends(i) & column(i) & (previous(i) | starts(i));
+            return runs;
+        }
+
+        /** Combines the bits of all windows of the given size along a
+          * bit-packed column with the algorithm of van Herk and Gil-Werman.
+          * Bit r of the result combines the bits r to r + size - 1 of the
+          * input. Disjunctions are mapped onto conjunctions by De Morgan's
+          * laws, the block suffixes are computed as block prefixes of the
+          * reversed column.
+          * @param column bit-packed column
+          * @param size window size
+          * @param blocks blocks of the given size on the column */
+        template<typename Operation, typename Column>
+        inline Eigen::Array<uint64, Eigen::Dynamic, 1> combineBits(const Column &column, const Index size, const BitBlocks &blocks)
+        {
+            if(size == 1)
+                return column;
+
+            const Eigen::Array<uint64, Eigen::Dynamic, 1> input = column.unaryExpr([](const uint64 word) { return word ^ Operation::complement; });
+            const auto prefix = blockPrefixAnd(input, blocks.starts, blocks.ends);
+            const auto suffix = reverseBits(blockPrefixAnd(reverseBits(input), blocks.reversedStarts, blocks.reversedEnds));
+
+            return suffix.binaryExpr(shiftBits(prefix, size - 1), [](const uint64 lhs, const uint64 rhs)
+            {
+                return (lhs & rhs) ^ Operation::complement;
+            });
+        }
+    }
+
+    /** Base class of morphology filters, which provides erosion and dilation
+      * with a rectangular or cross-shaped structuring element.
+      *
+      * Both shapes are separable into a vertical and a horizontal line. Each
+      * line is processed with the algorithm of van Herk and Gil-Werman, such
+      * that the cost per pixel does not depend on the size of the
+      * structuring element. The border handling is applied to a margin of
+      * half the element size around the image.
+      *
+      * In binary mode every non-zero value is foreground and the result is
+      * either zero or the maximum value of the color space. The image is then
+      * packed into bits, 64 rows per word, which are combined with bitwise
+      * operations. */
+    template<typename _Shape>
+    class MorphologyFilterBase
+    {
+    public:
+        using Shape = _Shape;
+
+        MorphologyFilterBase() = default;
+
+        /** Constructs a filter with a square structuring element.
+          * @param size size of the structuring element; must be odd */
+        explicit MorphologyFilterBase(const Index size)
+            : MorphologyFilterBase(size, size)
+        { }
+
+        /** Constructs a filter with a rectangular structuring element.
+          * @param rows number of rows of the structuring element; must be odd
+          * @param cols number of columns of the structuring element; must be odd */
+        MorphologyFilterBase(const Index rows, const Index cols)
+        {
+            setSize(rows, cols);
+        }
+
+        void setSize(const Index size)
+        {
+            setSize(size, size);
+        }
+
+        void setSize(const Index rows, const Index cols)
+        {
+            assert(rows > 0 && rows % 2 == 1);
+            assert(cols > 0 && cols % 2 == 1);
+            _rows = rows;
+            _cols = cols;
+        }
+
+        /** Determines if the image is treated as binary image, which is
+          * processed bit-packed. */
+        void setBinary(const bool binary)
+        {
+            _binary = binary;
+        }
+
+        Index rows() const
+        {
+            return _rows;
+        }
+
+        Index cols() const
+        {
+            return _cols;
+        }
+
+        bool binary() const
+        {
+            return _binary;
+        }
+
+    protected:
+        template<typename Derived, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> erode(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            return apply<internal::MorphologyMin>(img, handling);
+        }
+
+        template<typename Derived, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> dilate(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            return apply<internal::MorphologyMax>(img, handling);
+        }
+
+        /** Applies func to each value of the given images. In binary mode
+          * the values of lhs are binarized before. */
+        template<typename Derived, typename ColorSpace, typename Func>
+        Image<ColorSpace> combine(const ImageBase<Derived> &lhs, const Image<ColorSpace> &rhs, Func &&func) const
+        {
+            using ValueType = typename ColorSpace::ValueType;
+            Image<ColorSpace> result(lhs.rows(), lhs.cols());
+            for(Index i = 0; i < result.size(); ++i)
+            {
+                for(Index d = 0; d < ColorSpace::Dimension; ++d)
+                {
+                    auto value = lhs(i)[d];
+                    if(_binary)
+                        value = value != ValueType{0} ? ColorSpace::maximum[d] : ValueType{0};
+                    result(i)[d] = static_cast<ValueType>(func(value, rhs(i)[d]));
+                }
+            }
+            return result;
+        }
+
+    private:
+        Index _rows = 3;
+        Index _cols = 3;
+        bool _binary = false;
+
+        template<typename Operation, typename Derived, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> apply(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+
+            if(img.size() == 0)
+                return Image<typename ImageBase<Derived>::Scalar::ColorSpace>(img.rows(), img.cols());
+
+            if(_binary)
+                return applyBinary<Operation>(img, handling);
+
+            if constexpr (std::is_same<Shape, MorphologyShape::Rectangle>::value)
+            {
+                const auto planes = internal::vanHerkGilWermanRows<Operation>(applyVertical<Operation>(img, _rows, _cols / 2, handling), _cols);
+                return toImage<Operation>(img, planes, planes);
+            }
+            else
+            {
+                static_assert(std::is_same<Shape, MorphologyShape::Cross>::value, "shape must be a morphology shape");
+                const auto vertical = applyVertical<Operation>(img, _rows, 0, handling);
+                const auto horizontal = internal::vanHerkGilWermanRows<Operation>(applyVertical<Operation>(img, 1, _cols / 2, handling), _cols);
+                return toImage<Operation>(img, vertical, horizontal);
+            }
+        }
+
+        /** Combines the windows of the given size along the columns of the
+          * image and of margin additional columns on both sides, which
+          * incorporate the border handling. The columns run in parallel. */
+        template<typename Operation, typename Derived, typename BorderHandling>
+        static auto applyVertical(const ImageBase<Derived> &img, const Index size, const Index margin, const BorderHandling &handling)
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            using Plane = Eigen::Array<ValueType, Eigen::Dynamic, Eigen::Dynamic>;
+            using Line = Eigen::Array<ValueType, Eigen::Dynamic, 1>;
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            const auto rows = img.rows();
+            const auto half = size / 2;
+
+            std::array<Plane, Dimension> planes;
+            for(auto &plane : planes)
+                plane.resize(rows, img.cols() + 2 * margin);
+
+            parallel::forEach(0, img.cols() + 2 * margin, [&](const Index c)
+            {
+                Line input(rows + size - 1);
+                Line output(rows);
+                Line prefix(input.size());
+                Line suffix(input.size());
+
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    for(Index r = 0; r < input.size(); ++r)
+                        input(r) = handling(img, r - half, c - margin)[d];
+
+                    internal::vanHerkGilWerman<Operation>(input, output, size, prefix, suffix);
+                    planes[d].col(c) = output;
+                }
+            });
+
+            return planes;
+        }
+
+        template<typename Operation, typename Derived, typename Planes>
+        static Image<typename ImageBase<Derived>::Scalar::ColorSpace> toImage(const ImageBase<Derived> &img, const Planes &lhs, const Planes &rhs)
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+
+            Image<ColorSpace> result(img.rows(), img.cols());
+            parallel::forEach(0, img.cols(), [&](const Index c)
+            {
+                for(Index r = 0; r < img.rows(); ++r)
+                    for(Index d = 0; d < ColorSpace::Dimension; ++d)
+                        result(r, c)[d] = Operation::scalar(lhs[d](r, c), rhs[d](r, c));
+            });
+
+            return result;
+        }
+
+        /** Erodes or dilates the image bit-packed. Each column of the image
+          * including the margins of the border handling is packed into
+          * 64-bit words. The vertical windows are combined within the words
+          * of each column, the horizontal windows by combining the words of
+          * neighbouring columns. Both passes use the van Herk and Gil-Werman
+          * algorithm. */
+        template<typename Operation, typename Derived, typename BorderHandling>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> applyBinary(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            using Bits = Eigen::Array<uint64, Eigen::Dynamic, Eigen::Dynamic>;
+            constexpr Index Dimension = ColorSpace::Dimension;
+            constexpr bool cross = std::is_same<Shape, MorphologyShape::Cross>::value;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto rowMargin = _rows / 2;
+            const auto colMargin = _cols / 2;
+            const auto paddedRows = rows + 2 * rowMargin;
+            const auto paddedCols = cols + 2 * colMargin;
+            const auto words = parallel::chunks(paddedRows, 64);
+            const internal::BitBlocks blocks(words, _rows);
+
+            Image<ColorSpace> result(rows, cols);
+            for(Index d = 0; d < Dimension; ++d)
+            {
+                Bits packed = Bits::Zero(words, paddedCols);
+                parallel::forEach(0, paddedCols, [&](const Index c)
+                {
+                    for(Index r = 0; r < paddedRows; ++r)
+                    {
+                        if(handling(img, r - rowMargin, c - colMargin)[d] != ValueType{0})
+                            packed(r / 64, c) |= uint64{1} << (r % 64);
+                    }
+                });
+
+                // bit r of column c holds the vertical window starting at padded row r
+                Bits vertical(words, cross ? cols : paddedCols);
+                parallel::forEach(0, vertical.cols(), [&](const Index c)
+                {
+                    vertical.col(c) = internal::combineBits<Operation>(packed.col(cross ? c + colMargin : c), _rows, blocks);
+                });
+
+                Bits combined(words, cols);
+                if constexpr (cross)
+                {
+                    // align the center row of the horizontal windows with
+                    // the start of the vertical windows
+                    Bits horizontal(words, paddedCols);
+                    for(Index c = 0; c < paddedCols; ++c)
+                        horizontal.col(c) = internal::shiftBits(packed.col(c), rowMargin);
+                    horizontal = combineColumns<Operation>(horizontal);
+                    combined = vertical.binaryExpr(horizontal, [](const uint64 lhs, const uint64 rhs) { return Operation::bits(lhs, rhs); });
+                }
+                else
+                {
+                    combined = combineColumns<Operation>(vertical);
+                }
+
+                parallel::forEach(0, cols, [&](const Index c)
+                {
+                    for(Index r = 0; r < rows; ++r)
+                    {
+                        const auto bit = (combined(r / 64, c) >> (r % 64)) & uint64{1};
+                        result(r, c)[d] = bit != 0 ? ColorSpace::maximum[d] : ValueType{0};
+                    }
+                });
+            }
+
+            return result;
+        }
+
+        /** Combines the horizontal windows of bit-packed columns. */
+        template<typename Operation, typename Bits>
+        Bits combineColumns(const Bits &bits) const
+        {
+            Bits result(bits.rows(), bits.cols() - _cols + 1);
+            Eigen::Array<uint64, Eigen::Dynamic, 1> input(bits.cols());
+            Eigen::Array<uint64, Eigen::Dynamic, 1> output(result.cols());
+            Eigen::Array<uint64, Eigen::Dynamic, 1> prefix(bits.cols());
+            Eigen::Array<uint64, Eigen::Dynamic, 1> suffix(bits.cols());
+
+            for(Index w = 0; w < bits.rows(); ++w)
+            {
+                input = bits.row(w).transpose();
+                internal::vanHerkGilWerman<internal::MorphologyBits<Operation>>(input, output, _cols, prefix, suffix);
+                result.row(w) = output.transpose();
+            }
+
+            return result;
+        }
+    };
+
+    /** Filter functor, which erodes an image, i.e. computes the minimum of
+      * the neighbourhood of each pixel. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class ErosionFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Applies the erosion to the given image.
+          * @param img the image on which the erosion should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return eroded image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            return this->erode(img, handling);
+        }
+    };
+
+    /** Filter functor, which dilates an image, i.e. computes the maximum of
+      * the neighbourhood of each pixel. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class DilationFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Applies the dilation to the given image.
+          * @param img the image on which the dilation should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return dilated image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            return this->dilate(img, handling);
+        }
+    };
+
+    /** Filter functor, which applies a morphological opening to an image,
+      * i.e. a dilation of the erosion. It removes bright structures, which
+      * are smaller than the structuring element. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class OpeningFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Applies the opening to the given image.
+          * @param img the image on which the opening should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return opened image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            return this->dilate(this->erode(img, handling), handling);
+        }
+    };
+
+    /** Filter functor, which applies a morphological closing to an image,
+      * i.e. an erosion of the dilation. It fills dark structures, which
+      * are smaller than the structuring element. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class ClosingFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Applies the closing to the given image.
+          * @param img the image on which the closing should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return closed image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            return this->erode(this->dilate(img, handling), handling);
+        }
+    };
+
+    /** Filter functor, which computes the morphological gradient of an
+      * image, i.e. the difference of its dilation and its erosion. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class MorphologicalGradientFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Computes the morphological gradient of the given image.
+          * @param img the image of which the gradient should be computed.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return morphological gradient */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            const auto eroded = this->erode(img, handling);
+            return this->combine(this->dilate(img, handling), eroded, [](const auto lhs, const auto rhs) { return lhs - rhs; });
+        }
+    };
+
+    /** Filter functor, which computes the white top-hat transform of an
+      * image, i.e. the difference of the image and its opening. It extracts
+      * bright structures, which are smaller than the structuring element. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class TopHatFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Computes the top-hat transform of the given image.
+          * @param img the image of which the top-hat transform should be computed.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return top-hat transform */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            const auto opened = this->dilate(this->erode(img, handling), handling);
+            return this->combine(img, opened, [](const auto lhs, const auto rhs) { return lhs - rhs; });
+        }
+    };
+
+    /** Filter functor, which computes the black top-hat transform of an
+      * image, i.e. the difference of its closing and the image. It extracts
+      * dark structures, which are smaller than the structuring element. */
+    template<typename _Shape=MorphologyShape::Rectangle>
+    class BlackHatFilter : public MorphologyFilterBase<_Shape>
+    {
+    public:
+        using MorphologyFilterBase<_Shape>::MorphologyFilterBase;
+
+        /** Computes the black top-hat transform of the given image.
+          * @param img the image of which the black top-hat transform should be computed.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return black top-hat transform */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            const auto closed = this->erode(this->dilate(img, handling), handling);
+            return this->combine(img, closed, [](const auto lhs, const auto rhs) { return rhs - lhs; });
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,195 @@
+/* recursive_gauss_filter.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_RECURSIVE_GAUSS_FILTER_H_
+#define NVISION_RECURSIVE_GAUSS_FILTER_H_
+
+#include <array>
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Filter functor, which applies Gaussian blur to an image with a
+      * recursive (IIR) approximation of the Gaussian kernel.
+      *
+      * The filter uses the third order recursion of Young and van Vliet,
+      * which is applied forward and backward along the columns and then
+      * along the rows. The number of operations per pixel is constant for
+      * any sigma, which makes the filter preferable over GaussFilter for
+      * sigmas greater than about 2.
+      *
+      * The border handling is applied to a margin of ceil(3 * sigma) pixels
+      * on each side of the image, which is used to settle the recursion.
+      * For BorderReflect the margin must be smaller than the size of the
+      * image.
+      *
+      * The vertical pass runs in parallel over columns, the horizontal pass
+      * processes segments of whole columns, which Eigen vectorizes, and runs
+      * in parallel over bands of rows.
+      * @see I. T. Young and L. J. van Vliet, Recursive implementation of the
+      *      Gaussian filter, Signal Processing 44, 1995 */
+    template<typename _KernelScalar>
+    class RecursiveGaussFilter
+    {
+    public:
+        using KernelScalar = _KernelScalar;
+        using Plane = Eigen::Array<KernelScalar, Eigen::Dynamic, Eigen::Dynamic>;
+        using Vector = Eigen::Array<KernelScalar, Eigen::Dynamic, 1>;
+
+        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "Kernel scalar must be floating point");
+
+        RecursiveGaussFilter()
+            : RecursiveGaussFilter(KernelScalar{1})
+        { }
+
+        RecursiveGaussFilter(const KernelScalar sigma)
+        {
+            setSigma(sigma);
+        }
+
+        /** Sets the standard deviation of the Gaussian.
+          * The approximation is valid for sigmas of at least 0.5. */
+        void setSigma(const KernelScalar sigma)
+        {
+            assert(sigma >= static_cast<KernelScalar>(0.5));
+            _sigma = sigma;
+            computeCoefficients();
+        }
+
+        KernelScalar sigma() const
+        {
+            return _sigma;
+        }
+
+        /** Returns the number of pixels, which are added by the border
+          * handling on each side of the image. */
+        Index margin() const
+        {
+            return static_cast<Index>(std::ceil(KernelScalar{3} * _sigma));
+        }
+
+        /** Applies the recursive gauss filter to the given image.
+          * @param img the image on which the gauss filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return filtered image */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        Image<typename ImageBase<Derived>::Scalar::ColorSpace> operator()(const ImageBase<Derived> &img, const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+            using ValueType = typename ColorSpace::ValueType;
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const auto margin = this->margin();
+
+            Image<ColorSpace> result(rows, cols);
+            if(img.size() == 0)
+                return result;
+
+            assert((!std::is_same<BorderHandling, BorderReflect>::value || (margin < rows && margin < cols)));
+
+            // vertical pass, the planes contain additional columns on both
+            // sides, which already incorporate the border handling
+            std::array<Plane, Dimension> planes;
+            for(auto &plane : planes)
+                plane.resize(rows, cols + 2 * margin);
+
+            parallel::forEach(0, cols + 2 * margin, [&](const Index c)
+            {
+                const auto col = c - margin;
+                Eigen::Array<KernelScalar, Eigen::Dynamic, Dimension> line(rows + 2 * margin, Dimension);
+                for(Index r = 0; r < line.rows(); ++r)
+                {
+                    const auto &pixel = handling(img, r - margin, col);
+                    for(Index d = 0; d < Dimension; ++d)
+                        line(r, d) = static_cast<KernelScalar>(pixel[d]);
+                }
+
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    filterLine(line.col(d));
+                    planes[d].col(c) = line.col(d).segment(margin, rows);
+                }
+            });
+
+            // horizontal pass over segments of whole columns
+            constexpr Index bandRows = 256;
+            parallel::forChunks(rows, bandRows, [&](const Index, const Index begin, const Index end)
+            {
+                const auto len = end - begin;
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    auto block = planes[d].middleRows(begin, len);
+                    filterColumns(block);
+
+                    for(Index c = 0; c < cols; ++c)
+                        for(Index r = 0; r < len; ++r)
+                            result(begin + r, c)[d] = roundCast<ValueType>(block(r, c + margin));
+                }
+            });
+
+            return result;
+        }
+
+    private:
+        KernelScalar _sigma = KernelScalar{1};
+        KernelScalar _b = KernelScalar{0};
+        std::array<KernelScalar, 3> _a = {};
+
+        void computeCoefficients()
+        {
+            const auto q = _sigma >= static_cast<KernelScalar>(2.5)
+                ? static_cast<KernelScalar>(0.98711) * _sigma - static_cast<KernelScalar>(0.96330)
+                : static_cast<KernelScalar>(3.97156) - static_cast<KernelScalar>(4.14554) * std::sqrt(KernelScalar{1} - static_cast<KernelScalar>(0.26891) * _sigma);
+            const auto q2 = q * q;
+            const auto q3 = q2 * q;
+
+            const auto b0 = static_cast<KernelScalar>(1.57825) + static_cast<KernelScalar>(2.44413) * q
+                          + static_cast<KernelScalar>(1.4281) * q2 + static_cast<KernelScalar>(0.422205) * q3;
+            const auto b1 = static_cast<KernelScalar>(2.44413) * q + static_cast<KernelScalar>(2.85619) * q2
+                          + static_cast<KernelScalar>(1.26661) * q3;
+            const auto b2 = -(static_cast<KernelScalar>(1.4281) * q2 + static_cast<KernelScalar>(1.26661) * q3);
+            const auto b3 = static_cast<KernelScalar>(0.422205) * q3;
+
+            _a = {b1 / b0, b2 / b0, b3 / b0};
+            _b = KernelScalar{1} - _a[0] - _a[1] - _a[2];
+        }
+
+        /** Applies the forward and backward recursion in place to a
+          * contiguous line of values. The recursion is initialized with the
+          * steady state of the first and last value respectively. */
+        template<typename Line>
+        void filterLine(Line &&line) const
+        {
+            const auto len = line.size();
+            for(Index i = 1; i < len; ++i)
+                line(i) = _b * line(i) + _a[0] * line(i - 1) + _a[1] * line(std::max<Index>(i - 2, 0))
+                        + _a[2] * line(std::max<Index>(i - 3, 0));
+            for(Index i = len - 2; i >= 0; --i)
+                line(i) = _b * line(i) + _a[0] * line(i + 1) + _a[1] * line(std::min<Index>(i + 2, len - 1))
+                        + _a[2] * line(std::min<Index>(i + 3, len - 1));
+        }
+
+        /** Applies the forward and backward recursion in place along the
+          * rows of the given block, processing whole columns at once. */
+        template<typename Block>
+        void filterColumns(Block &block) const
+        {
+            const auto len = block.cols();
+            for(Index i = 1; i < len; ++i)
+                block.col(i) = _b * block.col(i) + _a[0] * block.col(i - 1) + _a[1] * block.col(std::max<Index>(i - 2, 0))
+                             + _a[2] * block.col(std::max<Index>(i - 3, 0));
+            for(Index i = len - 2; i >= 0; --i)
+                block.col(i) = _b * block.col(i) + _a[0] * block.col(i + 1) + _a[1] * block.col(std::min<Index>(i + 2, len - 1))
+                             + _a[2] * block.col(std::min<Index>(i + 3, len - 1));
+        }
+    };
+}
+
+#endif
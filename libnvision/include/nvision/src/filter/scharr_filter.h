@@ -13,27 +13,27 @@
 namespace nvision
 {
     /** Filter functor, which computes Scharr gradients of an image.
-     *  The Scharr operator computes the first derivative of the image. */
+     *  The Scharr operator computes the first derivative of the image.
+     *  If the kernel scalar is int16, the gradients of 8-bit images are
+     *  computed in fixed point arithmetic and stored as signed 16-bit values,
+     *  e.g. Gray16s for Gray images. The fixed point gradients are divided by
+     *  two, such that they fit into 16 bits. */
     template<typename _KernelScalar>
     class ScharrFilter
     {
     public:
         using KernelScalar = _KernelScalar;
         static constexpr Index Dimension = 3;
-        using KernelMatrix = Eigen::Matrix<KernelScalar, Dimension, Dimension>;
+        using KernelX = SeparableKernel<KernelTaps<47, 162, 47>, KernelTaps<-1, 0, 1>>;
+        using KernelY = SeparableKernel<KernelTaps<-1, 0, 1>, KernelTaps<47, 162, 47>>;
+        using Accumulator = std::conditional_t<std::is_integral<KernelScalar>::value, int32, KernelScalar>;
+        /** Number of bits by which the fixed point results are shifted right. */
+        static constexpr Index Shift = 1;
 
-        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0, "Kernel scalar must be floating point");
+        static_assert(Eigen::NumTraits<KernelScalar>::IsInteger == 0 || std::is_same<KernelScalar, int16>::value, "Kernel scalar must be floating point or int16");
         static_assert(Dimension % 2 == 1, "Kernel must have odd dimension");
 
-        ScharrFilter()
-        {
-            _kernelX << -47, 0, 47,
-                        -162, 0, 162,
-                        -47, 0, 47;
-            _kernelY << -47, -162, -47,
-                         0,  0,  0,
-                         47,  162,  47;
-        }
+        ScharrFilter() = default;
 
         /** Applies scharr filter in horizontal direction to the given image and returns a expression of the computation.
           * @param img the image on which the box filter should be applied.
@@ -45,7 +45,7 @@ namespace nvision
             const BorderHandling &handling = BorderHandling{}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
-            return image::filter<Dimension, Dimension>(img, _kernelX, handling);
+            return apply<KernelX>(img, handling);
         }
 
         /** Applies scharr filter in vertical direction to the given image and returns a expression of the computation.
@@ -58,11 +58,53 @@ namespace nvision
             const BorderHandling &handling = BorderHandling{}) const
         {
             static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
-            return image::filter<Dimension, Dimension>(img, _kernelY, handling);
+            return apply<KernelY>(img, handling);
+        }
+
+        /** Applies scharr filter in horizontal and vertical direction to the given image in a single sweep.
+          * @param img the image on which the filter should be applied.
+          * @param handling the border handling mode; defaults to BorderReflect
+          * @return gradients in both directions */
+        template<typename Derived, typename BorderHandling=BorderReflect>
+        auto operator()(const ImageBase<Derived> &img,
+            const GradientMode::XY,
+            const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            return internal::computeGradients<KernelX, KernelY, KernelScalar, Shift>(img, handling);
+        }
+
+        /** Computes the gradients in horizontal and vertical direction in a
+          * single sweep and passes them to func(row, col, gradX, gradY) for
+          * each pixel, e.g. to accumulate the structure tensor directly.
+          * The gradients are passed as Eigen::Array<Accumulator, Dimension, 1>
+          * without the fixed point shift.
+          * @param img the image on which the filter should be applied.
+          * @param func functor which receives the gradients of each pixel
+          * @param handling the border handling mode; defaults to BorderReflect */
+        template<typename Derived, typename Func, typename BorderHandling=BorderReflect>
+        void forEachGradient(const ImageBase<Derived> &img,
+            Func &&func,
+            const BorderHandling &handling = BorderHandling{}) const
+        {
+            static_assert(IsImage<ImageBase<Derived>>::value, "image must be image type");
+            image::forEachGradient<KernelX, KernelY, Accumulator>(img, handling, std::forward<Func>(func));
         }
     private:
-        KernelMatrix _kernelX = {};
-        KernelMatrix _kernelY = {};
+        template<typename Kernel, typename Derived, typename BorderHandling>
+        auto apply(const ImageBase<Derived> &img, const BorderHandling &handling) const
+        {
+            if constexpr (std::is_integral<KernelScalar>::value)
+            {
+                using ColorSpace = typename ImageBase<Derived>::Scalar::ColorSpace;
+                using OutputColorSpace = typename GetSignedColorSpace<ColorSpace>::type;
+                return image::filterSeparableFixedPoint<Kernel, OutputColorSpace>(img, Shift, handling);
+            }
+            else
+            {
+                return image::filterSeparable<Kernel, KernelScalar>(img, handling);
+            }
+        }
     };
 }
 
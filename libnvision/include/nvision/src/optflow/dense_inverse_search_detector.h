@@ -0,0 +1,434 @@
+/* dense_inverse_search_detector.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_DENSE_INVERSE_SEARCH_DETECTOR_H_
+#define NVISION_DENSE_INVERSE_SEARCH_DETECTOR_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "nvision/src/optflow/robust_flow_detector.h"
+
+namespace nvision
+{
+    /** Optical flow detector, which uses Dense Inverse Search (DIS) by
+      * Kroeger et al.
+      *
+      * The flow is computed coarse to fine over an image pyramid. On each
+      * level a regular grid of overlapping square patches is placed on the
+      * first image. The displacement of each patch is initialized with the
+      * flow of the coarser level and refined by an inverse compositional
+      * Lucas-Kanade search on the mean normalized intensities, thus the
+      * Hessian of each patch is computed only once. Patches, which move by
+      * more than their size, keep their initial displacement. Afterwards the
+      * patch displacements are densified: each pixel averages the
+      * displacements of all patches covering it, weighted by the inverse
+      * photometric error of the displacement at the pixel. Finally the dense
+      * flow can be refined variationally by a few iterations of a
+      * RobustFlowDetector.
+      *
+      * Levels finer than the finest search level only upsample the flow,
+      * which trades accuracy for speed. Patches are processed in parallel.
+      *
+      * The images must use floating point values. The resulting flow maps
+      * each pixel of the first image to its position in the second image. */
+    template<typename _Scalar>
+    class DenseInverseSearchDetector
+    {
+    public:
+        using Scalar = _Scalar;
+        using Refinement = RobustFlowDetector<Scalar>;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        DenseInverseSearchDetector() = default;
+
+        /** Sets the size of the square patches.
+          * @param size number of pixels on each side of a patch */
+        void setPatchSize(const Index size)
+        {
+            assert(size > 1);
+            _patchSize = size;
+        }
+
+        /** Sets the distance between two neighbouring patches of the grid.
+          * @param stride distance in pixels, which must not exceed the patch size */
+        void setPatchStride(const Index stride)
+        {
+            assert(stride > 0);
+            _patchStride = stride;
+        }
+
+        /** Sets the maximum number of inverse search iterations per patch. */
+        void setIterations(const Index iterations)
+        {
+            _iterations = iterations;
+        }
+
+        /** Sets the image pyramid, which is used for the coarse to fine
+          * estimation.
+          * Levels with less than 16 pixels on a side are skipped.
+          * @param levels number of pyramid levels, 1 disables the pyramid
+          * @param factor scale factor between two consecutive levels */
+        void setPyramid(const Index levels, const Scalar factor)
+        {
+            assert(levels > 0);
+            assert(factor > 0 && factor < 1);
+            _levels = levels;
+            _factor = factor;
+        }
+
+        /** Sets the finest pyramid level on which patches are searched.
+          * @param level finest search level, 0 is the original image */
+        void setFinestLevel(const Index level)
+        {
+            assert(level >= 0);
+            _finestLevel = level;
+        }
+
+        /** Sets the detector, which refines the densified flow of each level.
+          * Only its warps, iterations and functional parameters are used. */
+        void setRefinement(const Refinement &refinement)
+        {
+            _refinement = refinement;
+        }
+
+        void setRefinementEnabled(const bool enabled)
+        {
+            _refinementEnabled = enabled;
+        }
+
+        Index patchSize() const
+        {
+            return _patchSize;
+        }
+
+        Index patchStride() const
+        {
+            return _patchStride;
+        }
+
+        Index iterations() const
+        {
+            return _iterations;
+        }
+
+        Index finestLevel() const
+        {
+            return _finestLevel;
+        }
+
+        bool refinementEnabled() const
+        {
+            return _refinementEnabled;
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            FlowField<Scalar> &flowField) const
+        {
+            PlanarFlowField<Scalar> flow;
+            operator()(imgA, imgB, flow);
+            flowField = flow.toFlowField();
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            PlanarFlowField<Scalar> &flowField) const
+        {
+            static_assert(IsImage<ImageBase<DerivedA>>::value, "image A must be image type");
+            static_assert(IsImage<ImageBase<DerivedB>>::value, "image B must be image type");
+            static_assert(std::is_same<
+                typename ImageBase<DerivedA>::Scalar::ColorSpace,
+                typename ImageBase<DerivedB>::Scalar::ColorSpace>::value,
+                "images must use same color space");
+
+            using ColorSpace = typename ImageBase<DerivedA>::Scalar::ColorSpace;
+            static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
+            assert(imgA.rows() == imgB.rows());
+            assert(imgA.cols() == imgB.cols());
+            assert(_patchStride <= _patchSize);
+
+            // levels are identified by their size relative to the image
+            const auto maxSearchRows = static_cast<Scalar>(imgA.rows()) * std::pow(_factor, static_cast<Scalar>(_finestLevel));
+
+            internal::estimateFlowCoarseToFine(imgA, imgB, _levels, _factor, flowField.u(), flowField.v(),
+                [&](const auto &levelA, const auto &levelB, auto &levelU, auto &levelV)
+            {
+                if(static_cast<Scalar>(levelA.rows()) > maxSearchRows + static_cast<Scalar>(0.5)
+                    || levelA.rows() < _patchSize || levelA.cols() < _patchSize)
+                    return;
+
+                const auto intensityA = intensity(levelA);
+                const auto intensityB = intensity(levelB);
+
+                Plane patchU;
+                Plane patchV;
+                searchPatches(intensityA, intensityB, levelU, levelV, patchU, patchV);
+                densify(intensityA, intensityB, patchU, patchV, levelU, levelV);
+
+                if(_refinementEnabled)
+                {
+                    PlanarFlowField<Scalar> levelFlow(std::move(levelU), std::move(levelV));
+                    _refinement.refine(levelA, levelB, levelFlow);
+                    levelU = std::move(levelFlow.u());
+                    levelV = std::move(levelFlow.v());
+                }
+            });
+        }
+
+    private:
+        using Plane = FlowPlane<Scalar>;
+
+        Index _patchSize = 8;
+        Index _patchStride = 4;
+        Index _iterations = 12;
+        Index _levels = 5;
+        Scalar _factor = static_cast<Scalar>(0.5);
+        Index _finestLevel = 0;
+        bool _refinementEnabled = true;
+        Refinement _refinement = makeRefinement();
+
+        static Refinement makeRefinement()
+        {
+            Refinement refinement(1, static_cast<Scalar>(0.02), Scalar{0});
+            refinement.setInnerIterations(5);
+            refinement.setWarps(1);
+            return refinement;
+        }
+
+        /** Returns the mean intensity of all channels of an image. */
+        template<typename ColorSpace>
+        static Plane intensity(const Image<ColorSpace> &img)
+        {
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            Plane result(img.rows(), img.cols());
+            parallel::forEach(0, img.cols(), [&](const Index c)
+            {
+                for(Index r = 0; r < img.rows(); ++r)
+                {
+                    Scalar sum = 0;
+                    for(Index d = 0; d < Dimension; ++d)
+                        sum += static_cast<Scalar>(img(r, c)[d]);
+                    result(r, c) = sum / static_cast<Scalar>(Dimension);
+                }
+            });
+
+            return result;
+        }
+
+        /** Returns the top left positions of the patches along one
+          * dimension. The last patch is aligned with the border. */
+        std::vector<Index> patchPositions(const Index size) const
+        {
+            std::vector<Index> positions;
+            for(Index pos = 0; pos + _patchSize < size; pos += _patchStride)
+                positions.push_back(pos);
+            positions.push_back(size - _patchSize);
+            return positions;
+        }
+
+        /** Interpolates the plane bilinearly, coordinates outside of the
+          * plane are clamped. */
+        static Scalar sample(const Plane &plane, const Scalar row, const Scalar col)
+        {
+            const auto r = clamp<Scalar>(row, 0, static_cast<Scalar>(plane.rows() - 1));
+            const auto c = clamp<Scalar>(col, 0, static_cast<Scalar>(plane.cols() - 1));
+            const auto r1 = static_cast<Index>(r);
+            const auto c1 = static_cast<Index>(c);
+            const auto r2 = std::min(r1 + 1, plane.rows() - 1);
+            const auto c2 = std::min(c1 + 1, plane.cols() - 1);
+            const auto wr = r - static_cast<Scalar>(r1);
+            const auto wc = c - static_cast<Scalar>(c1);
+            return (1 - wr) * ((1 - wc) * plane(r1, c1) + wc * plane(r1, c2))
+                + wr * ((1 - wc) * plane(r2, c1) + wc * plane(r2, c2));
+        }
+
+        /** Computes the displacement of each patch by inverse compositional
+          * search, starting at the given dense flow. */
+        void searchPatches(const Plane &imgA,
+            const Plane &imgB,
+            const Plane &u,
+            const Plane &v,
+            Plane &patchU,
+            Plane &patchV) const
+        {
+            const auto rowPositions = patchPositions(imgA.rows());
+            const auto colPositions = patchPositions(imgA.cols());
+            const auto patchRows = static_cast<Index>(rowPositions.size());
+            const auto patchCols = static_cast<Index>(colPositions.size());
+            const auto pixels = static_cast<Scalar>(_patchSize * _patchSize);
+            const auto rows = imgA.rows();
+            const auto cols = imgA.cols();
+
+            patchU.resize(patchRows, patchCols);
+            patchV.resize(patchRows, patchCols);
+
+            parallel::forEach(0, patchCols, [&](const Index j)
+            {
+                Plane templ(_patchSize, _patchSize);
+                Plane gradX(_patchSize, _patchSize);
+                Plane gradY(_patchSize, _patchSize);
+                Plane warped(_patchSize, _patchSize);
+
+                const auto col = colPositions[j];
+                for(Index i = 0; i < patchRows; ++i)
+                {
+                    const auto row = rowPositions[i];
+                    const auto center = _patchSize / 2;
+                    const auto initU = u(row + center, col + center);
+                    const auto initV = v(row + center, col + center);
+                    patchU(i, j) = initU;
+                    patchV(i, j) = initV;
+
+                    // mean normalized template and its gradients
+                    templ = imgA.block(row, col, _patchSize, _patchSize);
+                    templ -= templ.mean();
+                    for(Index c = 0; c < _patchSize; ++c)
+                    {
+                        const auto cm = std::max<Index>(col + c - 1, 0);
+                        const auto cp = std::min<Index>(col + c + 1, cols - 1);
+                        for(Index r = 0; r < _patchSize; ++r)
+                        {
+                            const auto rm = std::max<Index>(row + r - 1, 0);
+                            const auto rp = std::min<Index>(row + r + 1, rows - 1);
+                            gradX(r, c) = (imgA(row + r, cp) - imgA(row + r, cm)) / static_cast<Scalar>(cp - cm);
+                            gradY(r, c) = (imgA(rp, col + c) - imgA(rm, col + c)) / static_cast<Scalar>(rp - rm);
+                        }
+                    }
+
+                    const auto h11 = (gradX * gradX).sum();
+                    const auto h12 = (gradX * gradY).sum();
+                    const auto h22 = (gradY * gradY).sum();
+                    const auto det = h11 * h22 - h12 * h12;
+                    if(!(det > std::numeric_limits<Scalar>::epsilon() * pixels * pixels))
+                        continue;
+
+                    auto du = initU;
+                    auto dv = initV;
+                    for(Index it = 0; it < _iterations; ++it)
+                    {
+                        // all pixels of the patch share the interpolation weights
+                        const auto x = static_cast<Scalar>(col) + du;
+                        const auto y = static_cast<Scalar>(row) + dv;
+                        const auto x0 = std::floor(x);
+                        const auto y0 = std::floor(y);
+                        const auto wc = x - x0;
+                        const auto wr = y - y0;
+                        const auto c0 = static_cast<Index>(x0);
+                        const auto r0 = static_cast<Index>(y0);
+                        const bool inside = r0 >= 0 && r0 + _patchSize < rows && c0 >= 0 && c0 + _patchSize < cols;
+                        if(inside)
+                        {
+                            const auto block = [&](const Index dr, const Index dc)
+                            {
+                                return imgB.block(r0 + dr, c0 + dc, _patchSize, _patchSize);
+                            };
+                            warped = (1 - wr) * ((1 - wc) * block(0, 0) + wc * block(0, 1))
+                                + wr * ((1 - wc) * block(1, 0) + wc * block(1, 1));
+                        }
+                        else
+                        {
+                            for(Index c = 0; c < _patchSize; ++c)
+                                for(Index r = 0; r < _patchSize; ++r)
+                                    warped(r, c) = sample(imgB, y + static_cast<Scalar>(r), x + static_cast<Scalar>(c));
+                        }
+
+                        warped -= warped.mean();
+                        warped -= templ;
+                        const auto b1 = (gradX * warped).sum();
+                        const auto b2 = (gradY * warped).sum();
+
+                        const auto stepU = (h22 * b1 - h12 * b2) / det;
+                        const auto stepV = (h11 * b2 - h12 * b1) / det;
+                        du -= stepU;
+                        dv -= stepV;
+
+                        if(stepU * stepU + stepV * stepV < static_cast<Scalar>(1e-4))
+                            break;
+                    }
+
+                    // reject patches, which diverged
+                    const auto distU = du - initU;
+                    const auto distV = dv - initV;
+                    if(distU * distU + distV * distV <= static_cast<Scalar>(_patchSize * _patchSize))
+                    {
+                        patchU(i, j) = du;
+                        patchV(i, j) = dv;
+                    }
+                }
+            });
+        }
+
+        /** Computes the dense flow from the patch displacements. Each pixel
+          * averages the displacements of all patches, which cover it,
+          * weighted by the inverse photometric error. */
+        void densify(const Plane &imgA,
+            const Plane &imgB,
+            const Plane &patchU,
+            const Plane &patchV,
+            Plane &u,
+            Plane &v) const
+        {
+            constexpr auto minError = static_cast<Scalar>(0.01);
+
+            const auto rowPositions = patchPositions(imgA.rows());
+            const auto colPositions = patchPositions(imgA.cols());
+            const auto rows = imgA.rows();
+            const auto cols = imgA.cols();
+
+            // range of the patches, which cover each row or column
+            const auto coverage = [this](const std::vector<Index> &positions, const Index size)
+            {
+                std::vector<std::pair<Index, Index>> result(size, {0, 0});
+                Index first = 0;
+                Index last = 0;
+                for(Index idx = 0; idx < size; ++idx)
+                {
+                    while(positions[first] + _patchSize <= idx)
+                        ++first;
+                    while(last < static_cast<Index>(positions.size()) && positions[last] <= idx)
+                        ++last;
+                    result[idx] = {first, last};
+                }
+                return result;
+            };
+            const auto rowCoverage = coverage(rowPositions, rows);
+            const auto colCoverage = coverage(colPositions, cols);
+
+            parallel::forEach(0, cols, [&](const Index c)
+            {
+                for(Index r = 0; r < rows; ++r)
+                {
+                    Scalar weightSum = 0;
+                    Scalar sumU = 0;
+                    Scalar sumV = 0;
+                    for(Index j = colCoverage[c].first; j < colCoverage[c].second; ++j)
+                    {
+                        for(Index i = rowCoverage[r].first; i < rowCoverage[r].second; ++i)
+                        {
+                            const auto du = patchU(i, j);
+                            const auto dv = patchV(i, j);
+                            const auto error = std::abs(sample(imgB, static_cast<Scalar>(r) + dv, static_cast<Scalar>(c) + du) - imgA(r, c));
+                            const auto weight = 1 / std::max(error, minError);
+                            weightSum += weight;
+                            sumU += weight * du;
+                            sumV += weight * dv;
+                        }
+                    }
+
+                    u(r, c) = sumU / weightSum;
+                    v(r, c) = sumV / weightSum;
+                }
+            });
+        }
+    };
+}
+
+#endif
@@ -7,7 +7,10 @@
 #ifndef NVISION_FLOW_FIELD_H_
 #define NVISION_FLOW_FIELD_H_
 
+#include <cassert>
+#include <utility>
 #include <Eigen/Core>
+#include "nvision/src/core/types.h"
 
 namespace nvision
 {
@@ -16,6 +19,193 @@ namespace nvision
 
     template<typename Scalar>
     using FlowField = Eigen::Array<FlowVector<Scalar>, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /** Single component of a flow in planar layout, i.e. the horizontal or
+      * the vertical flow of all pixels. */
+    template<typename Scalar>
+    using FlowPlane = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+    /** Strided view of a single component of an interleaved flow field. */
+    template<typename Scalar>
+    using FlowPlaneMap = Eigen::Map<FlowPlane<Scalar>, Eigen::Unaligned, Eigen::Stride<Eigen::Dynamic, 2>>;
+
+    /** Read-only strided view of a single component of an interleaved flow field. */
+    template<typename Scalar>
+    using ConstFlowPlaneMap = Eigen::Map<const FlowPlane<Scalar>, Eigen::Unaligned, Eigen::Stride<Eigen::Dynamic, 2>>;
+
+    /** Returns a view of the horizontal flow of an interleaved flow field
+      * without copying it. */
+    template<typename Scalar>
+    inline FlowPlaneMap<Scalar> flowU(FlowField<Scalar> &flow)
+    {
+        static_assert(sizeof(FlowVector<Scalar>) == 2 * sizeof(Scalar), "flow vectors must be packed");
+        return FlowPlaneMap<Scalar>(flow.data()->data(), flow.rows(), flow.cols(), Eigen::Stride<Eigen::Dynamic, 2>(2 * flow.rows(), 2));
+    }
+
+    template<typename Scalar>
+    inline ConstFlowPlaneMap<Scalar> flowU(const FlowField<Scalar> &flow)
+    {
+        static_assert(sizeof(FlowVector<Scalar>) == 2 * sizeof(Scalar), "flow vectors must be packed");
+        return ConstFlowPlaneMap<Scalar>(flow.data()->data(), flow.rows(), flow.cols(), Eigen::Stride<Eigen::Dynamic, 2>(2 * flow.rows(), 2));
+    }
+
+    /** Returns a view of the vertical flow of an interleaved flow field
+      * without copying it. */
+    template<typename Scalar>
+    inline FlowPlaneMap<Scalar> flowV(FlowField<Scalar> &flow)
+    {
+        static_assert(sizeof(FlowVector<Scalar>) == 2 * sizeof(Scalar), "flow vectors must be packed");
+        return FlowPlaneMap<Scalar>(flow.data()->data() + 1, flow.rows(), flow.cols(), Eigen::Stride<Eigen::Dynamic, 2>(2 * flow.rows(), 2));
+    }
+
+    template<typename Scalar>
+    inline ConstFlowPlaneMap<Scalar> flowV(const FlowField<Scalar> &flow)
+    {
+        static_assert(sizeof(FlowVector<Scalar>) == 2 * sizeof(Scalar), "flow vectors must be packed");
+        return ConstFlowPlaneMap<Scalar>(flow.data()->data() + 1, flow.rows(), flow.cols(), Eigen::Stride<Eigen::Dynamic, 2>(2 * flow.rows(), 2));
+    }
+
+    /** Flow field in planar layout, which stores the horizontal and the
+      * vertical flow in two separate contiguous planes. Whole-field
+      * operations on the planes are vectorized by Eigen. */
+    template<typename _Scalar>
+    class PlanarFlowField
+    {
+    public:
+        using Scalar = _Scalar;
+        using Plane = FlowPlane<Scalar>;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        PlanarFlowField() = default;
+
+        PlanarFlowField(const Index rows, const Index cols)
+            : _u(rows, cols), _v(rows, cols)
+        { }
+
+        PlanarFlowField(const Plane &u, const Plane &v)
+            : _u(u), _v(v)
+        {
+            assert(u.rows() == v.rows());
+            assert(u.cols() == v.cols());
+        }
+
+        /** Takes over the given planes without copying them. */
+        PlanarFlowField(Plane &&u, Plane &&v)
+            : _u(std::move(u)), _v(std::move(v))
+        {
+            assert(_u.rows() == _v.rows());
+            assert(_u.cols() == _v.cols());
+        }
+
+        /** Converts an interleaved flow field into planar layout. */
+        explicit PlanarFlowField(const FlowField<Scalar> &flow)
+            : _u(flowU(flow)), _v(flowV(flow))
+        { }
+
+        Index rows() const
+        {
+            return _u.rows();
+        }
+
+        Index cols() const
+        {
+            return _u.cols();
+        }
+
+        Index size() const
+        {
+            return _u.size();
+        }
+
+        void resize(const Index rows, const Index cols)
+        {
+            _u.resize(rows, cols);
+            _v.resize(rows, cols);
+        }
+
+        void setZero()
+        {
+            _u.setZero();
+            _v.setZero();
+        }
+
+        void setZero(const Index rows, const Index cols)
+        {
+            _u.setZero(rows, cols);
+            _v.setZero(rows, cols);
+        }
+
+        /** Returns the horizontal flow. */
+        Plane &u()
+        {
+            return _u;
+        }
+
+        const Plane &u() const
+        {
+            return _u;
+        }
+
+        /** Returns the vertical flow. */
+        Plane &v()
+        {
+            return _v;
+        }
+
+        const Plane &v() const
+        {
+            return _v;
+        }
+
+        FlowVector<Scalar> operator()(const Index row, const Index col) const
+        {
+            return FlowVector<Scalar>(_u(row, col), _v(row, col));
+        }
+
+        FlowVector<Scalar> operator()(const Index idx) const
+        {
+            return FlowVector<Scalar>(_u(idx), _v(idx));
+        }
+
+        /** Returns a read-only expression, which presents the flow as
+          * interleaved flow field without copying it. The expression is
+          * evaluated lazily and must not outlive this object. */
+        auto view() const
+        {
+            return FlowField<Scalar>::NullaryExpr(rows(), cols(), ViewFunctor{_u, _v});
+        }
+
+        /** Converts the flow into an interleaved flow field. */
+        FlowField<Scalar> toFlowField() const
+        {
+            FlowField<Scalar> result(rows(), cols());
+            flowU(result) = _u;
+            flowV(result) = _v;
+            return result;
+        }
+
+        /** Returns the length of the flow vectors. */
+        Plane magnitude() const
+        {
+            return (_u.square() + _v.square()).sqrt();
+        }
+
+    private:
+        Plane _u = {};
+        Plane _v = {};
+
+        struct ViewFunctor
+        {
+            const Plane &u;
+            const Plane &v;
+
+            FlowVector<Scalar> operator()(const Index row, const Index col) const
+            {
+                return FlowVector<Scalar>(u(row, col), v(row, col));
+            }
+        };
+    };
 }
 
 #endif
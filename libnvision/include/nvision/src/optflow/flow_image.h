@@ -8,23 +8,145 @@
 #define NVISION_FLOW_IMAGE_H_
 
 #include "nvision/src/core/pixel.h"
+#include "nvision/src/core/image.h"
 #include "nvision/src/optflow/flow_field.h"
 
 namespace nvision
 {
-    template<typename ColorSpace, typename Scalar>
-    auto imflow(const FlowField<Scalar> &flow)
+    /** Functor which colorizes flow fields with a precomputed color wheel.
+      * The hue of a pixel encodes the direction of its flow vector and the
+      * saturation encodes its magnitude relative to the largest flow vector.
+      *
+      * The colors are stored in a lookup table, which is indexed by quantized
+      * angle and magnitude, such that no color space conversion has to be
+      * computed per pixel. */
+    template<typename _Scalar, typename _ColorSpace>
+    class FlowColorWheel
     {
-        const auto norms =flow.unaryExpr([](const auto &vec) { return vec.squaredNorm(); });
-        const Scalar maxMagnitude =  std::sqrt(norms.maxCoeff());
-        return flow.unaryExpr([maxMagnitude](const FlowVector<Scalar>& vec)
+    public:
+        using Scalar = _Scalar;
+        using ColorSpace = _ColorSpace;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+        static_assert(IsColorSpace<ColorSpace>::value, "color wheel must use a color space");
+
+        FlowColorWheel()
+            : FlowColorWheel(360, 64)
+        { }
+
+        /** Constructs a color wheel with the given quantization.
+          * @param angleBins number of quantization steps of the flow direction
+          * @param magnitudeBins number of quantization steps of the flow magnitude
+          * @param value constant HSV value of all colors */
+        FlowColorWheel(const Index angleBins, const Index magnitudeBins, const float32 value = 0.9f)
+            : _angleBins(angleBins), _magnitudeBins(magnitudeBins)
+        {
+            assert(angleBins > 0);
+            assert(magnitudeBins > 1);
+            computeLookupTable(value);
+        }
+
+        /** Returns the color lookup table. Each row corresponds to a magnitude
+          * and each column to an angle bin. */
+        const Image<ColorSpace> &lookupTable() const
+        {
+            return _lut;
+        }
+
+        /** Computes the colored image of the given flow field.
+          * @param flow flow field which should be colorized
+          * @return colored flow image */
+        Image<ColorSpace> operator()(const FlowField<Scalar> &flow) const
+        {
+            return colorize(flowU(flow), flowV(flow));
+        }
+
+        /** Computes the colored image of the given planar flow field.
+          * @param flow flow field which should be colorized
+          * @return colored flow image */
+        Image<ColorSpace> operator()(const PlanarFlowField<Scalar> &flow) const
+        {
+            return colorize(flow.u(), flow.v());
+        }
+
+    private:
+        Index _angleBins;
+        Index _magnitudeBins;
+        Image<ColorSpace> _lut = {};
+
+        template<typename DerivedU, typename DerivedV>
+        Image<ColorSpace> colorize(const Eigen::ArrayBase<DerivedU> &u, const Eigen::ArrayBase<DerivedV> &v) const
+        {
+            using Array = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+            Array magnitudes = (u.square() + v.square()).sqrt();
+            const auto maxMagnitude = magnitudes.size() > 0 ? magnitudes.maxCoeff() : Scalar{0};
+
+            // map magnitudes directly to the bins of the lookup table
+            const auto magnitudeFac = maxMagnitude > Scalar{0}
+                ? static_cast<Scalar>(_magnitudeBins - 1) / maxMagnitude
+                : Scalar{0};
+            magnitudes = magnitudes * magnitudeFac + static_cast<Scalar>(0.5);
+
+            const auto angleFac = static_cast<Scalar>(_angleBins) / (2 * pi<Scalar>());
+
+            Image<ColorSpace> result(u.rows(), u.cols());
+            for(Index c = 0; c < result.cols(); ++c)
+            {
+                for(Index r = 0; r < result.rows(); ++r)
+                {
+                    // the angle is in [-pi, pi], shift it to [0, 2pi] before quantizing
+                    auto angle = fastAtan2(v(r, c), u(r, c));
+                    if(angle < Scalar{0})
+                        angle += 2 * pi<Scalar>();
+
+                    const auto angleIdx = static_cast<Index>(angle * angleFac + static_cast<Scalar>(0.5)) % _angleBins;
+                    const auto magnitudeIdx = std::min(static_cast<Index>(magnitudes(r, c)), _magnitudeBins - 1);
+                    result(r, c) = _lut(magnitudeIdx, angleIdx);
+                }
+            }
+
+            return result;
+        }
+
+        void computeLookupTable(const float32 value)
         {
-            const auto magnitude = vec.norm() / maxMagnitude;
-            const auto angle = nvision::angle::normalize(std::atan2(vec.y(), vec.x())) / (2 * nvision::pi<Scalar>());
+            Image<HSV> hsv(_magnitudeBins, _angleBins);
+            for(Index c = 0; c < hsv.cols(); ++c)
+            {
+                const auto hue = static_cast<float32>(c) / static_cast<float32>(_angleBins);
+                for(Index r = 0; r < hsv.rows(); ++r)
+                {
+                    const auto saturation = static_cast<float32>(r) / static_cast<float32>(_magnitudeBins - 1);
+                    hsv(r, c) = Pixel<HSV>(hue, saturation, value);
+                }
+            }
 
-            Pixel<HSV> pixel(angle, magnitude, 0.9f);
-            return pixel.template convert<ColorSpace>();
-        });
+            const Image<RGBf> rgb = image::hsvToRGB(hsv);
+            _lut = image::convert<ColorSpace>(rgb);
+        }
+    };
+
+    /** Computes a colored image of the given flow field with the default
+      * color wheel.
+      * @param flow flow field which should be colorized
+      * @return colored flow image */
+    template<typename ColorSpace, typename Scalar>
+    Image<ColorSpace> imflow(const FlowField<Scalar> &flow)
+    {
+        static const FlowColorWheel<Scalar, ColorSpace> colorWheel;
+        return colorWheel(flow);
+    }
+
+    /** Computes a colored image of the given planar flow field with the
+      * default color wheel.
+      * @param flow flow field which should be colorized
+      * @return colored flow image */
+    template<typename ColorSpace, typename Scalar>
+    Image<ColorSpace> imflow(const PlanarFlowField<Scalar> &flow)
+    {
+        static const FlowColorWheel<Scalar, ColorSpace> colorWheel;
+        return colorWheel(flow);
     }
 }
 
@@ -7,11 +7,20 @@
 #ifndef NVISION_HORN_SCHUNCK_DETECTOR_H_
 #define NVISION_HORN_SCHUNCK_DETECTOR_H_
 
-#include "nvision/filter/box_filter.h"
-#include "nvision/filter/sobel_filter.h"
+#include "nvision/src/filter/sobel_filter.h"
+#include "nvision/src/optflow/variational_flow_solver.h"
 
 namespace nvision
 {
+    /** Solvers for the linear systems of HornSchunckDetector. */
+    enum class HornSchunckSolver
+    {
+        /** Red-black successive over-relaxation. */
+        SOR,
+        /** Full multigrid with V-cycles. */
+        Multigrid
+    };
+
     /** Optical flow detector, which uses the Horn-Schunk method.
       * It basically solves the global energy functional
       *
@@ -21,25 +30,30 @@ namespace nvision
       *
       * Ix * (Ix * u + Iy * v + It) - alpha^2 lap(u) = 0
       * Iy * (Ix * u + Iy * v + It) - alpha^2 lap(v) = 0
-      */
-    template<typename Scalar,
-        typename GradientFilter=SobelFilter<Scalar>,
-        typename BorderHandling=BorderReflect>
+      *
+      * The flow is computed coarse to fine over an image pyramid. On each
+      * level the second image is warped towards the first one with the
+      * current flow and the equations are solved for the flow increment.
+      * The linear systems are solved either with red-black SOR or with full
+      * multigrid, which converges in a few cycles independent of the image
+      * size. Multi-channel images use the mean data term of all channels.
+      *
+      * The images must use floating point values. The resulting flow maps
+      * each pixel of the first image to its position in the second image. */
+    template<typename _Scalar,
+        typename _GradientFilter=SobelFilter<_Scalar>>
     class HornSchunckDetector
     {
-    private:
-        Index iterations_;
-        Scalar alpha_;
-        GradientFilter gradientFilter_;
-        BorderHandling handling_;
     public:
-        HornSchunckDetector()
-            : HornSchunckDetector(10, 1)
-        { }
+        using Scalar = _Scalar;
+        using GradientFilter = _GradientFilter;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        HornSchunckDetector() = default;
 
         HornSchunckDetector(const Index iterations, const Scalar alpha)
-            : iterations_(iterations), alpha_(alpha), gradientFilter_(),
-            handling_()
+            : _iterations(iterations), _alpha(alpha)
         { }
 
         /** Sets the regularization constant for the Horn-Schunck method.
@@ -47,75 +61,205 @@ namespace nvision
           * @param alpha regularization constant */
         void setRegularizationConstant(const Scalar alpha)
         {
-            alpha_ = alpha;
+            _alpha = alpha;
         }
 
         /** Set the number of iterations to the solve the equation system.
+          * These are SOR sweeps or multigrid V-cycles on the finest level per
+          * warp. Multigrid runs at least one V-cycle.
           * @param iterations number of iterations for the solver */
         void setIterations(const Index iterations)
         {
-            iterations_ = iterations;
+            assert(iterations >= 0);
+            _iterations = iterations;
         }
 
         void setGradientFilter(const GradientFilter &filter)
         {
-            gradientFilter_ = filter;
+            _gradient = filter;
+        }
+
+        void setSolver(const HornSchunckSolver solver)
+        {
+            _solver = solver;
+        }
+
+        /** Sets the relaxation factor of the SOR solver.
+          * @param omega relaxation factor in (0, 2) */
+        void setRelaxation(const Scalar omega)
+        {
+            assert(omega > 0 && omega < 2);
+            _omega = omega;
+        }
+
+        /** Sets the image pyramid, which is used for the coarse to fine
+          * estimation.
+          * Levels with less than 16 pixels on a side are skipped.
+          * @param levels number of pyramid levels, 1 disables the pyramid
+          * @param factor scale factor between two consecutive levels */
+        void setPyramid(const Index levels, const Scalar factor)
+        {
+            assert(levels > 0);
+            assert(factor > 0 && factor < 1);
+            _levels = levels;
+            _factor = factor;
+        }
+
+        /** Sets the number of warps per pyramid level. */
+        void setWarps(const Index warps)
+        {
+            assert(warps > 0);
+            _warps = warps;
+        }
+
+        Scalar regularizationConstant() const
+        {
+            return _alpha;
+        }
+
+        Index iterations() const
+        {
+            return _iterations;
         }
 
-        template<typename ScalarA>
-        void operator()(const Eigen::Tensor<ScalarA, 3> &imgA,
-            const Eigen::Tensor<ScalarA, 3> &imgB,
-            Eigen::Tensor<Scalar, 3> &flowImg) const
+        HornSchunckSolver solver() const
         {
-            assert(imgA.dimension(2) == 1);
-            assert(imgA.dimension(0) == imgB.dimension(0));
-            assert(imgA.dimension(1) == imgB.dimension(1));
-            assert(imgA.dimension(2) == imgB.dimension(2));
-
-            Index height = imgA.dimension(0);
-            Index width = imgA.dimension(1);
-
-            Eigen::Tensor<Scalar, 3> gradX;
-            Eigen::Tensor<Scalar, 3> gradY;
-            Eigen::Tensor<Scalar, 3> gradT;
-
-            gradientFilter_(imgA, gradX, gradY);
-            gradT = imgB.template cast<Scalar>() - imgA.template cast<Scalar>();
-
-            Eigen::Tensor<Scalar, 3> flowU(height, width, 1);
-            Eigen::Tensor<Scalar, 3> flowV(height, width, 1);
-            Eigen::Tensor<Scalar, 3> flowUM(height, width, 1);
-            Eigen::Tensor<Scalar, 3> flowVM(height, width, 1);
-            Eigen::Tensor<Scalar, 3> dataTerm;
-
-            Eigen::Tensor<Scalar, 3> stepSizes = static_cast<Scalar>(1) / (gradX * gradX + gradY * gradY + alpha_ * alpha_);
-
-            flowU.setZero();
-            flowV.setZero();
-
-            Eigen::Matrix<Scalar, 3, 3> kernelmat;
-            kernelmat << 0, 1, 0,
-                         1, 0, 1,
-                         0, 1, 0;
-            kernelmat /= static_cast<Scalar>(4);
-            for(Index i = 0; i < iterations_; ++i)
+            return _solver;
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            FlowField<Scalar> &flowField) const
+        {
+            PlanarFlowField<Scalar> flow;
+            operator()(imgA, imgB, flow);
+            flowField = flow.toFlowField();
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            PlanarFlowField<Scalar> &flowField) const
+        {
+            static_assert(IsImage<ImageBase<DerivedA>>::value, "image A must be image type");
+            static_assert(IsImage<ImageBase<DerivedB>>::value, "image B must be image type");
+            static_assert(std::is_same<
+                typename ImageBase<DerivedA>::Scalar::ColorSpace,
+                typename ImageBase<DerivedB>::Scalar::ColorSpace>::value,
+                "images must use same color space");
+
+            using ColorSpace = typename ImageBase<DerivedA>::Scalar::ColorSpace;
+            static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
+            assert(imgA.rows() == imgB.rows());
+            assert(imgA.cols() == imgB.cols());
+
+            internal::estimateFlowCoarseToFine(imgA, imgB, _levels, _factor, flowField.u(), flowField.v(),
+                [this](const auto &levelA, const auto &levelB, auto &levelU, auto &levelV)
             {
-                kernel::apply(flowU, flowUM, kernelmat, handling_);
-                kernel::apply(flowV, flowVM, kernelmat, handling_);
-                dataTerm = gradX * flowUM + gradY * flowVM + gradT;
-                flowU = flowUM - stepSizes * dataTerm * gradX;
-                flowV = flowVM - stepSizes * dataTerm * gradY;
+                for(Index warp = 0; warp < _warps; ++warp)
+                    refineFlow(levelA, levelB, levelU, levelV);
+            });
+        }
+
+    private:
+        GradientFilter _gradient = {};
+        HornSchunckSolver _solver = HornSchunckSolver::Multigrid;
+        Index _iterations = 5;
+        Scalar _alpha = static_cast<Scalar>(0.1);
+        Scalar _omega = static_cast<Scalar>(1.9);
+        Index _levels = 4;
+        Scalar _factor = static_cast<Scalar>(0.5);
+        Index _warps = 2;
+
+        /** Warps the second image with the current flow, solves for the
+          * flow increment and adds it to the flow. */
+        template<typename ColorSpace>
+        void refineFlow(const Image<ColorSpace> &imgA,
+            const Image<ColorSpace> &imgB,
+            FlowPlane<Scalar> &u,
+            FlowPlane<Scalar> &v) const
+        {
+            using Plane = FlowPlane<Scalar>;
+
+            internal::FlowSystem<Scalar> system;
+            system.resize(imgA.rows(), imgA.cols());
+            system.setConstantWeights(_alpha * _alpha / 4);
+            computeMotionTensor(imgA, imgB, u, v, system);
+
+            // the data term is linearized around the current flow, thus
+            // J [u v] = J [u0 v0] - [j13 j23]
+            system.b1 += system.j11 * u + system.j12 * v;
+            system.b2 += system.j12 * u + system.j22 * v;
+
+            if(_solver == HornSchunckSolver::SOR)
+            {
+                internal::solveFlowSOR(system, u, v, _iterations, _omega);
             }
+            else
+            {
+                // solve for the correction of the current flow
+                Plane residualU;
+                Plane residualV;
+                internal::computeFlowResidual(system, u, v, residualU, residualV);
+                system.b1 = std::move(residualU);
+                system.b2 = std::move(residualV);
+
+                auto hierarchy = internal::makeFlowHierarchy(system);
+                Plane du = Plane::Zero(u.rows(), u.cols());
+                Plane dv = Plane::Zero(v.rows(), v.cols());
+                internal::solveFlowMultigrid(hierarchy, du, dv, std::max<Index>(_iterations, 1));
+                u += du;
+                v += dv;
+            }
+        }
 
-            flowImg.resize(height, width, 2);
-            for(Index c = 0; c < width; ++c)
+        /** Computes the motion tensor of the linearized data term between
+          * the first image and the second image warped by the current flow.
+          * The gradients are computed on the mean of both images. Pixels,
+          * which are warped outside of the second image, have no data term.
+          * The right hand side receives -[j13 j23]. */
+        template<typename ColorSpace>
+        void computeMotionTensor(const Image<ColorSpace> &imgA,
+            const Image<ColorSpace> &imgB,
+            const FlowPlane<Scalar> &u,
+            const FlowPlane<Scalar> &v,
+            internal::FlowSystem<Scalar> &system) const
+        {
+            constexpr Index Dimension = ColorSpace::Dimension;
+
+            Image<ColorSpace> warped;
+            Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> inside;
+            internal::warpFlowImage(imgB, u, v, warped, inside);
+
+            const Image<ColorSpace> mean = (imgA + warped) * static_cast<Scalar>(0.5);
+            const auto gradientScale = Scalar{1} / static_cast<Scalar>(internal::derivativeScale<typename GradientFilter::KernelX>());
+            const auto channelScale = Scalar{1} / static_cast<Scalar>(Dimension);
+
+            _gradient.forEachGradient(mean, [&](const Index row, const Index col, const auto &gradX, const auto &gradY)
             {
-                for(Index r = 0; r < height; ++r)
+                Scalar j11 = 0, j12 = 0, j22 = 0, j13 = 0, j23 = 0;
+                if(inside(row, col))
                 {
-                    flowImg(r, c, 0) = flowU(r, c, 0);
-                    flowImg(r, c, 1) = flowV(r, c, 0);
+                    for(Index d = 0; d < Dimension; ++d)
+                    {
+                        const auto x = static_cast<Scalar>(gradX(d)) * gradientScale;
+                        const auto y = static_cast<Scalar>(gradY(d)) * gradientScale;
+                        const auto t = static_cast<Scalar>(warped(row, col)[d]) - static_cast<Scalar>(imgA(row, col)[d]);
+                        j11 += x * x;
+                        j12 += x * y;
+                        j22 += y * y;
+                        j13 += x * t;
+                        j23 += y * t;
+                    }
                 }
-            }
+
+                system.j11(row, col) = j11 * channelScale;
+                system.j12(row, col) = j12 * channelScale;
+                system.j22(row, col) = j22 * channelScale;
+                system.b1(row, col) = -j13 * channelScale;
+                system.b2(row, col) = -j23 * channelScale;
+            });
         }
     };
 }
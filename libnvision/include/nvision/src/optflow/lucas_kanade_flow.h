@@ -7,16 +7,58 @@
 #ifndef NVISION_LUCAS_KANADE_FLOW_H_
 #define NVISION_LUCAS_KANADE_FLOW_H_
 
-#include <Eigen/Dense>
+#include <array>
+#include <type_traits>
 #include "nvision/src/core/math.h"
+#include "nvision/src/core/parallel.h"
 #include "nvision/src/optflow/flow_field.h"
+#include "nvision/src/optflow/variational_flow_solver.h"
 #include "nvision/src/filter/gauss_filter.h"
 #include "nvision/src/filter/sobel_filter.h"
 
 namespace nvision
 {
+    namespace internal
+    {
+        /** Determines if a filter exposes its weights through kernel() as a
+          * dense square kernel with Dimension rows and columns. */
+        template<typename Filter, typename = void>
+        struct HasSquareKernel
+        {
+            static constexpr bool value = false;
+        };
 
-    /** Implements calculation of optical flow according to the Lucas Kanade method. */
+        template<typename Filter>
+        struct HasSquareKernel<Filter, std::void_t<decltype(Filter::Dimension), decltype(std::declval<const Filter &>().kernel())>>
+        {
+            using Kernel = std::decay_t<decltype(std::declval<const Filter &>().kernel())>;
+            static constexpr bool value = Kernel::RowsAtCompileTime == Filter::Dimension
+                && Kernel::ColsAtCompileTime == Filter::Dimension;
+        };
+    }
+
+    /** Implements calculation of optical flow according to the Lucas Kanade method.
+      * The flow of each pixel solves the 2x2 system
+      *
+      * Sum(w * [Ix^2 IxIy; IxIy Iy^2]) [u v] = -Sum(w * [IxIt IyIt])
+      *
+      * where the weights w are given by the kernel of the smooth filter.
+      * Multi-channel images use the mean structure tensor of all channels.
+      * The gradient products are computed in a single sweep, afterwards the
+      * window sums and the closed form solution of all pixels are computed
+      * column by column in one fused, vectorized pass.
+      *
+      * The smooth filter only provides the window weights: it must expose
+      * them as dense square kernel of size Dimension through kernel(), e.g.
+      * GaussFilter, BoxFilter or BinominalFilter. The weights are normalized
+      * to sum to one and the window is reflected at the image border. The
+      * operator() of the smooth filter is not used, thus filters with a
+      * different border handling or without a dense kernel are not
+      * supported.
+      *
+      * Pixels, whose structure tensor has a smaller eigenvalue than the
+      * given threshold, are ill-conditioned and receive zero flow. The
+      * threshold refers to gradients in value units per pixel. */
     template<typename _Scalar,
              typename _SmoothFilter = GaussFilter<_Scalar, 3>,
              typename _GradientFilter = SobelFilter<_Scalar>>
@@ -27,6 +69,9 @@ namespace nvision
         using SmoothFilter = _SmoothFilter;
         using GradientFilter = _GradientFilter;
 
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+        static_assert(internal::HasSquareKernel<SmoothFilter>::value, "Smooth filter must provide a square kernel of size Dimension through kernel()");
+
         LucasKanadeFlow() = default;
 
         void setSmoothFilter(const SmoothFilter &filter)
@@ -39,10 +84,33 @@ namespace nvision
             _gradient = filter;
         }
 
+        /** Sets the minimum eigenvalue of the structure tensor, which a pixel
+          * requires to receive a flow vector.
+          * @param threshold minimum eigenvalue */
+        void setMinEigenvalue(const Scalar threshold)
+        {
+            _minEigenvalue = threshold;
+        }
+
+        Scalar minEigenvalue() const
+        {
+            return _minEigenvalue;
+        }
+
         template<typename DerivedA, typename DerivedB>
         void operator()(const ImageBase<DerivedA> &imgA,
                         const ImageBase<DerivedB> &imgB,
                         FlowField<Scalar> &flowField) const
+        {
+            PlanarFlowField<Scalar> flow;
+            operator()(imgA, imgB, flow);
+            flowField = flow.toFlowField();
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+                        const ImageBase<DerivedB> &imgB,
+                        PlanarFlowField<Scalar> &flowField) const
         {
             static_assert(IsImage<ImageBase<DerivedA>>::value, "image A must be image type");
             static_assert(IsImage<ImageBase<DerivedB>>::value, "image B must be image type");
@@ -52,64 +120,105 @@ namespace nvision
                 "images must use same color space");
 
             using ColorSpace = typename ImageBase<DerivedA>::Scalar::ColorSpace;
+            using Vector = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+            constexpr Index Dimension = ColorSpace::Dimension;
+            constexpr Index WindowSize = SmoothFilter::Dimension;
+            constexpr Index radius = WindowSize / 2;
+
             assert(imgA.rows() == imgB.rows());
             assert(imgA.cols() == imgB.cols());
+            const auto rows = imgA.rows();
+            const auto cols = imgA.cols();
+            flowField.resize(rows, cols);
+            auto &u = flowField.u();
+            auto &v = flowField.v();
+            if(imgA.size() == 0)
+                return;
+
+            assert(rows > radius && cols > radius);
+
+            // gradient products xx, xy, yy, xt, yt of the mean structure
+            // tensor, padded by the window radius
+            std::array<FlowPlane<Scalar>, 5> products;
+            for(auto &product : products)
+                product.resize(rows + 2 * radius, cols + 2 * radius);
+
+            const auto gradientScale = Scalar{1} / static_cast<Scalar>(internal::derivativeScale<typename GradientFilter::KernelX>());
+            const auto channelScale = Scalar{1} / static_cast<Scalar>(Dimension);
+            _gradient.forEachGradient(imgA, [&](const Index row, const Index col, const auto &gradX, const auto &gradY)
+            {
+                Scalar xx = 0, xy = 0, yy = 0, xt = 0, yt = 0;
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    const auto x = static_cast<Scalar>(gradX(d)) * gradientScale;
+                    const auto y = static_cast<Scalar>(gradY(d)) * gradientScale;
+                    const auto t = static_cast<Scalar>(imgB(row, col)[d]) - static_cast<Scalar>(imgA(row, col)[d]);
+                    xx += x * x;
+                    xy += x * y;
+                    yy += y * y;
+                    xt += x * t;
+                    yt += y * t;
+                }
 
-            using Matrix2 = Eigen::Matrix<Scalar, 2, 2>;
-            using Vector2 = Eigen::Matrix<Scalar, 2, 1>;
-
-            Image<ColorSpace> gradX = _gradient(imgA, GradientMode::X());
-            Image<ColorSpace> gradY = _gradient(imgA, GradientMode::Y());
-            Image<ColorSpace> gradT = imgB - imgA;
-
-            Image<ColorSpace> tmp = gradX * gradX;
-            Image<ColorSpace> gradXX = _smooth(tmp);
-
-            tmp = gradY * gradY;
-            Image<ColorSpace> gradYY = _smooth(tmp);
-
-            tmp = gradX * gradY;
-            Image<ColorSpace> gradXY = _smooth(tmp);
-
-            tmp = gradX * gradT;
-            Image<ColorSpace> gradXT = _smooth(tmp);
+                products[0](row + radius, col + radius) = xx * channelScale;
+                products[1](row + radius, col + radius) = xy * channelScale;
+                products[2](row + radius, col + radius) = yy * channelScale;
+                products[3](row + radius, col + radius) = xt * channelScale;
+                products[4](row + radius, col + radius) = yt * channelScale;
+            });
 
-            tmp = gradY * gradT;
-            Image<ColorSpace> gradYT = _smooth(tmp);
+            // reflect the borders in the same way as BorderReflect
+            for(auto &product : products)
+            {
+                for(Index i = 0; i < radius; ++i)
+                {
+                    product.row(radius - 1 - i) = product.row(radius + 1 + i);
+                    product.row(radius + rows + i) = product.row(radius + rows - 2 - i);
+                }
+                for(Index i = 0; i < radius; ++i)
+                {
+                    product.col(radius - 1 - i) = product.col(radius + 1 + i);
+                    product.col(radius + cols + i) = product.col(radius + cols - 2 - i);
+                }
+            }
 
-            flowField.resize(imgA.rows(), imgA.cols());
+            const Eigen::Matrix<Scalar, WindowSize, WindowSize> weights = _smooth.kernel().template cast<Scalar>();
+            const auto weightSum = weights.sum();
 
-            for(Index c = 0; c < imgA.cols(); ++c)
+            parallel::forEach(0, cols, [&](const Index c)
             {
-                for(Index r = 0; r < imgA.rows(); ++r)
+                std::array<Vector, 5> sums;
+                for(auto &sum : sums)
+                    sum.setZero(rows);
+
+                for(Index j = 0; j < WindowSize; ++j)
                 {
-                    flowField(r, c).setZero();
-                    const auto &xx = gradXX(r, c);
-                    const auto &xy = gradXY(r, c);
-                    const auto &yy = gradYY(r, c);
-                    const auto &xt = gradXT(r, c);
-                    const auto &yt = gradYT(r, c);
-
-                    for(Index d = 0; d < ColorSpace::Dimension; ++d)
+                    for(Index i = 0; i < WindowSize; ++i)
                     {
-                        Matrix2 A;
-                        A << xx[d], xy[d],
-                             xy[d], yy[d];
-                        Vector2 b;
-                        b << -xt[d], -yt[d];
-
-                        flowField(r, c) += A.inverse() * b;
+                        const auto weight = weights(i, j) / weightSum;
+                        for(size_t k = 0; k < sums.size(); ++k)
+                            sums[k] += weight * products[k].col(c + j).segment(i, rows);
                     }
-
-                    flowField(r, c) /= static_cast<Scalar>(ColorSpace::Dimension);
-                    if(flowField(r, c).hasNaN())
-                        flowField(r, c).setZero();
                 }
-            }
+
+                const auto &xx = sums[0];
+                const auto &xy = sums[1];
+                const auto &yy = sums[2];
+                const auto &xt = sums[3];
+                const auto &yt = sums[4];
+
+                // closed form solution with the adjugate of the tensor
+                const Vector det = xx * yy - xy * xy;
+                const Eigen::Array<bool, Eigen::Dynamic, 1> valid = nvision::minEigenvalue<Vector>(xx, xy, yy) >= _minEigenvalue && det > Scalar{0};
+                const Vector invDet = valid.select(Scalar{1} / det, Scalar{0});
+                u.col(c) = (xy * yt - yy * xt) * invDet;
+                v.col(c) = (xy * xt - xx * yt) * invDet;
+            });
         }
     private:
         SmoothFilter _smooth = {};
         GradientFilter _gradient = {};
+        Scalar _minEigenvalue = static_cast<Scalar>(1e-6);
     };
 }
 
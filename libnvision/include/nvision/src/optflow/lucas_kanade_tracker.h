@@ -0,0 +1,364 @@
+/* lucas_kanade_tracker.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_LUCAS_KANADE_TRACKER_H_
+#define NVISION_LUCAS_KANADE_TRACKER_H_
+
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/image_pyramid.h"
+#include "nvision/src/core/math.h"
+#include "nvision/src/core/parallel.h"
+
+namespace nvision
+{
+    /** Sparse pyramidal Lucas-Kanade tracker (KLT), which tracks single
+      * points, e.g. keypoints of a feature detector, from one image to
+      * another.
+      *
+      * Each point is tracked coarse to fine over image pyramids of both
+      * images. On each level a square window around the point in the first
+      * image serves as template. The tracker uses the inverse compositional
+      * formulation: the template and its gradients are sampled once per
+      * level, thus the 2x2 Hessian is constant and each iteration only
+      * samples the window in the second image. All windows are sampled
+      * with subpixel accuracy by bilinear interpolation. Points are tracked
+      * in parallel.
+      *
+      * A point is lost if it leaves the second image, if the minimum
+      * eigenvalue of its Hessian on the finest level is below the
+      * threshold or if tracking it back from the second to the first image
+      * does not return to its origin. */
+    template<typename _Scalar>
+    class LucasKanadeTracker
+    {
+    public:
+        using Scalar = _Scalar;
+        /** Points with x-coordinate (column) in the first and y-coordinate
+          * (row) in the second row. */
+        using FeatureMatrix = Eigen::Matrix<Scalar, 2, Eigen::Dynamic>;
+        /** Tracking status of each point, true if the point was tracked. */
+        using StatusVector = Eigen::Array<bool, Eigen::Dynamic, 1>;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        LucasKanadeTracker() = default;
+
+        /** Sets the radius of the square tracking window.
+          * @param radius window radius, the window has 2 * radius + 1 pixels on each side */
+        void setWindowRadius(const Index radius)
+        {
+            assert(radius > 0);
+            _radius = radius;
+        }
+
+        /** Sets the image pyramids, which are used for the coarse to fine
+          * tracking.
+          * @param levels number of pyramid levels, 1 disables the pyramid
+          * @param factor scale factor between two consecutive levels */
+        void setPyramid(const Index levels, const Scalar factor)
+        {
+            assert(levels > 0);
+            assert(factor > 0 && factor < 1);
+            _levels = levels;
+            _factor = factor;
+        }
+
+        /** Sets the maximum number of iterations per pyramid level. */
+        void setMaxIterations(const Index iterations)
+        {
+            _iterations = iterations;
+        }
+
+        /** Sets the minimum length of an update step in pixels. Iterations
+          * stop once the step becomes shorter. */
+        void setEpsilon(const Scalar eps)
+        {
+            _eps = eps;
+        }
+
+        /** Sets the minimum eigenvalue of the Hessian, which is normalized by
+          * the number of pixels and channels in the window. The threshold
+          * refers to gradients in value units per pixel. */
+        void setMinEigenvalue(const Scalar threshold)
+        {
+            _minEigenvalue = threshold;
+        }
+
+        /** Sets the maximum distance in pixels between a point and the
+          * result of tracking it forward and backward again.
+          * @param threshold maximum distance, zero or less disables the check */
+        void setForwardBackwardThreshold(const Scalar threshold)
+        {
+            _forwardBackwardThreshold = threshold;
+        }
+
+        Index windowRadius() const
+        {
+            return _radius;
+        }
+
+        Index maxIterations() const
+        {
+            return _iterations;
+        }
+
+        Scalar minEigenvalue() const
+        {
+            return _minEigenvalue;
+        }
+
+        Scalar forwardBackwardThreshold() const
+        {
+            return _forwardBackwardThreshold;
+        }
+
+        /** Tracks the given points from the first to the second image.
+          * @param imgA first image
+          * @param imgB second image
+          * @param pointsA 2xN matrix of points in the first image
+          * @param pointsB receives the 2xN tracked points in the second image
+          * @param status receives the tracking status of each point */
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            const FeatureMatrix &pointsA,
+            FeatureMatrix &pointsB,
+            StatusVector &status) const
+        {
+            static_assert(IsImage<ImageBase<DerivedA>>::value, "image A must be image type");
+            static_assert(IsImage<ImageBase<DerivedB>>::value, "image B must be image type");
+            static_assert(std::is_same<
+                typename ImageBase<DerivedA>::Scalar::ColorSpace,
+                typename ImageBase<DerivedB>::Scalar::ColorSpace>::value,
+                "images must use same color space");
+
+            using ColorSpace = typename ImageBase<DerivedA>::Scalar::ColorSpace;
+            const ImagePyramid<Scalar, ColorSpace> pyramidA(imgA, _levels, _factor);
+            const ImagePyramid<Scalar, ColorSpace> pyramidB(imgB, _levels, _factor);
+            operator()(pyramidA, pyramidB, pointsA, pointsB, status);
+        }
+
+        /** Tracks the given points from the first to the second image with
+          * precomputed image pyramids, e.g. to reuse the pyramid of an image
+          * for consecutive frames. The pyramid settings of the tracker are
+          * ignored.
+          * @param pyramidA pyramid of the first image
+          * @param pyramidB pyramid of the second image
+          * @param pointsA 2xN matrix of points in the first image
+          * @param pointsB receives the 2xN tracked points in the second image
+          * @param status receives the tracking status of each point */
+        template<typename ColorSpace>
+        void operator()(const ImagePyramid<Scalar, ColorSpace> &pyramidA,
+            const ImagePyramid<Scalar, ColorSpace> &pyramidB,
+            const FeatureMatrix &pointsA,
+            FeatureMatrix &pointsB,
+            StatusVector &status) const
+        {
+            assert(pyramidA.size() == pyramidB.size());
+            assert(pyramidA.size() > 0);
+
+            pointsB.resize(2, pointsA.cols());
+            status.resize(pointsA.cols());
+
+            parallel::forEach(0, pointsA.cols(), [&](const Index i)
+            {
+                Vector2 point = pointsA.col(i);
+                bool tracked = track(pyramidA, pyramidB, pointsA.col(i), point);
+
+                if(tracked && _forwardBackwardThreshold > 0)
+                {
+                    Vector2 back = point;
+                    tracked = track(pyramidB, pyramidA, point, back)
+                        && (back - pointsA.col(i)).squaredNorm() <= _forwardBackwardThreshold * _forwardBackwardThreshold;
+                }
+
+                pointsB.col(i) = point;
+                status(i) = tracked;
+            });
+        }
+
+    private:
+        using Vector2 = Eigen::Matrix<Scalar, 2, 1>;
+        /** Samples of a window with one row per pixel and one column per channel. */
+        using Patch = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+        Index _radius = 7;
+        Index _levels = 3;
+        Scalar _factor = static_cast<Scalar>(0.5);
+        Index _iterations = 20;
+        Scalar _eps = static_cast<Scalar>(0.01);
+        Scalar _minEigenvalue = static_cast<Scalar>(1e-5);
+        Scalar _forwardBackwardThreshold = Scalar{1};
+
+        /** Samples a square window with the given radius around (x, y) by
+          * bilinear interpolation. All pixels of the window share the same
+          * interpolation weights. Coordinates outside of the image are
+          * clamped. */
+        template<typename ColorSpace>
+        static void samplePatch(const Image<ColorSpace> &img,
+            const Scalar x,
+            const Scalar y,
+            const Index radius,
+            Patch &patch)
+        {
+            constexpr Index Dimension = ColorSpace::Dimension;
+            const auto side = 2 * radius + 1;
+            patch.resize(side * side, Dimension);
+
+            const auto x0 = static_cast<Index>(std::floor(x));
+            const auto y0 = static_cast<Index>(std::floor(y));
+            const auto fx = x - static_cast<Scalar>(x0);
+            const auto fy = y - static_cast<Scalar>(y0);
+            const auto w00 = (1 - fx) * (1 - fy);
+            const auto w01 = fx * (1 - fy);
+            const auto w10 = (1 - fx) * fy;
+            const auto w11 = fx * fy;
+
+            const auto rows = img.rows();
+            const auto cols = img.cols();
+            const bool inside = y0 - radius >= 0 && y0 + radius + 1 < rows
+                && x0 - radius >= 0 && x0 + radius + 1 < cols;
+
+            Index idx = 0;
+            for(Index j = -radius; j <= radius; ++j)
+            {
+                auto c0 = x0 + j;
+                auto c1 = c0 + 1;
+                if(!inside)
+                {
+                    c0 = clamp<Index>(c0, 0, cols - 1);
+                    c1 = clamp<Index>(c1, 0, cols - 1);
+                }
+
+                for(Index i = -radius; i <= radius; ++i, ++idx)
+                {
+                    auto r0 = y0 + i;
+                    auto r1 = r0 + 1;
+                    if(!inside)
+                    {
+                        r0 = clamp<Index>(r0, 0, rows - 1);
+                        r1 = clamp<Index>(r1, 0, rows - 1);
+                    }
+
+                    const auto &p00 = img(r0, c0);
+                    const auto &p01 = img(r0, c1);
+                    const auto &p10 = img(r1, c0);
+                    const auto &p11 = img(r1, c1);
+                    for(Index d = 0; d < Dimension; ++d)
+                    {
+                        patch(idx, d) = w00 * static_cast<Scalar>(p00[d]) + w01 * static_cast<Scalar>(p01[d])
+                            + w10 * static_cast<Scalar>(p10[d]) + w11 * static_cast<Scalar>(p11[d]);
+                    }
+                }
+            }
+        }
+
+        /** Tracks a single point from the first to the second pyramid.
+          * @param pyramidA pyramid of the first image
+          * @param pyramidB pyramid of the second image
+          * @param point point in the first image
+          * @param result receives the tracked point in the second image
+          * @return true if the point was tracked successfully */
+        template<typename ColorSpace>
+        bool track(const ImagePyramid<Scalar, ColorSpace> &pyramidA,
+            const ImagePyramid<Scalar, ColorSpace> &pyramidB,
+            const Vector2 &point,
+            Vector2 &result) const
+        {
+            constexpr Index Dimension = ColorSpace::Dimension;
+            const auto side = 2 * _radius + 1;
+            const auto extendedSide = side + 2;
+            const auto pixels = static_cast<Scalar>(side * side * Dimension);
+
+            Patch extended;
+            Patch gradX(side * side, Dimension);
+            Patch gradY(side * side, Dimension);
+            Patch templ(side * side, Dimension);
+            Patch warped;
+
+            // displacement on the current level
+            Vector2 displacement = Vector2::Zero();
+            const auto &levels = pyramidA.levels();
+            for(Index level = pyramidA.size() - 1; level >= 0; --level)
+            {
+                const auto &imgA = pyramidA.images()[level];
+                const auto &imgB = pyramidB.images()[level];
+                const Vector2 scale(levels[level].scaleX, levels[level].scaleY);
+                if(level + 1 < pyramidA.size())
+                    displacement = displacement.cwiseProduct(scale).cwiseQuotient(Vector2(levels[level + 1].scaleX, levels[level + 1].scaleY));
+
+                const Vector2 position = point.cwiseProduct(scale);
+
+                // template and its central differences gradients, which
+                // are sampled from a window with one additional pixel on
+                // each side
+                samplePatch(imgA, position(0), position(1), _radius + 1, extended);
+                Scalar h11 = 0, h12 = 0, h22 = 0;
+                for(Index d = 0; d < Dimension; ++d)
+                {
+                    for(Index j = 0; j < side; ++j)
+                    {
+                        for(Index i = 0; i < side; ++i)
+                        {
+                            const auto idx = j * side + i;
+                            const auto ext = (j + 1) * extendedSide + i + 1;
+                            const auto x = (extended(ext + extendedSide, d) - extended(ext - extendedSide, d)) / 2;
+                            const auto y = (extended(ext + 1, d) - extended(ext - 1, d)) / 2;
+                            templ(idx, d) = extended(ext, d);
+                            gradX(idx, d) = x;
+                            gradY(idx, d) = y;
+                            h11 += x * x;
+                            h12 += x * y;
+                            h22 += y * y;
+                        }
+                    }
+                }
+
+                // windows without texture in two directions cannot be
+                // tracked reliably, coarse levels just keep the estimate
+                if(nvision::minEigenvalue(h11, h12, h22) / pixels < _minEigenvalue)
+                {
+                    if(level == 0)
+                        return false;
+                    continue;
+                }
+
+                const auto det = h11 * h22 - h12 * h12;
+                const auto i11 = h22 / det;
+                const auto i12 = -h12 / det;
+                const auto i22 = h11 / det;
+
+                for(Index it = 0; it < _iterations; ++it)
+                {
+                    const Vector2 target = position + displacement;
+                    if(target(0) < 0 || target(0) > static_cast<Scalar>(imgB.cols() - 1)
+                        || target(1) < 0 || target(1) > static_cast<Scalar>(imgB.rows() - 1))
+                        return false;
+
+                    samplePatch(imgB, target(0), target(1), _radius, warped);
+                    const Patch error = warped - templ;
+                    const auto b1 = (gradX * error).sum();
+                    const auto b2 = (gradY * error).sum();
+
+                    // inverse compositional update of the translation
+                    const Vector2 step(i11 * b1 + i12 * b2, i12 * b1 + i22 * b2);
+                    displacement -= step;
+
+                    if(step.squaredNorm() < _eps * _eps)
+                        break;
+                }
+            }
+
+            result = point + displacement.cwiseQuotient(Vector2(levels[0].scaleX, levels[0].scaleY));
+            const auto &imgB = pyramidB.images()[0];
+            const Vector2 target = result.cwiseProduct(Vector2(levels[0].scaleX, levels[0].scaleY));
+            return target(0) >= 0 && target(0) <= static_cast<Scalar>(imgB.cols() - 1)
+                && target(1) >= 0 && target(1) <= static_cast<Scalar>(imgB.rows() - 1);
+        }
+    };
+}
+
+#endif
@@ -7,164 +7,411 @@
 #ifndef NVISION_ROBUST_FLOW_DETECTOR_H_
 #define NVISION_ROBUST_FLOW_DETECTOR_H_
 
-#include "nvision/filter/box_filter.h"
-#include "nvision/filter/central_differences_filter.h"
-#include "nvision/filter/forward_differences_filter.h"
-#include "nvision/filter/sobel_filter.h"
-#include "nvision/core/penalizer_functors.h"
+#include "nvision/src/core/penalizer_functors.h"
+#include "nvision/src/filter/central_differences_filter.h"
+#include "nvision/src/optflow/variational_flow_solver.h"
 
 namespace nvision
 {
-    template<typename Scalar,
-        typename Penalizer=TotalVariationPenalizer<Scalar>,
-        typename GradientFilter=CentralDifferencesFilter<Scalar>,
-        typename BorderHandling=BorderReflect>
+    /** Optical flow detector, which minimizes the robust energy functional
+      *
+      * Integral( Psi((Ix * u + Iy * v + It)^2)
+      *     + gamma Psi((Ixx * u + Ixy * v + Ixt)^2 + (Ixy * u + Iyy * v + Iyt)^2)
+      *     + alpha Psi(ux^2 + uy^2 + vx^2 + vy^2) )
+      *
+      * The first term assumes constant brightness, the second one constant
+      * gradients and the last one a piecewise smooth flow. The penalizer
+      * functor returns the derivative Psi' of the robust function, e.g. the
+      * TotalVariationPenalizer results in a TV-L1 type functional.
+      *
+      * The flow is computed coarse to fine over an image pyramid. On each
+      * level the second image is warped towards the first one with the
+      * current flow and the data terms are linearized around it. The
+      * remaining nonlinearity is resolved by a lagged diffusivity fixed point
+      * iteration: each outer iteration evaluates the penalizer weights of all
+      * three terms at the current flow in a single fused pass, which also
+      * assembles the linear system, and a few red-black SOR sweeps solve it.
+      * Multi-channel images use the mean data terms of all channels.
+      *
+      * The images must use floating point values. The resulting flow maps
+      * each pixel of the first image to its position in the second image. */
+    template<typename _Scalar,
+        typename _Penalizer=TotalVariationPenalizer<_Scalar>,
+        typename _GradientFilter=CentralDifferencesFilter<_Scalar>,
+        typename _BorderHandling=BorderReflect>
     class RobustFlowDetector
     {
-    private:
-        Index maxIt_;
-        Scalar alpha_;
-        Scalar gamma_;
-        GradientFilter gradientFilter_;
-        Penalizer penalizer_;
-        BorderHandling handling_;
     public:
-        RobustFlowDetector()
-            : RobustFlowDetector(10, 1, 1)
-        { }
+        using Scalar = _Scalar;
+        using Penalizer = _Penalizer;
+        using GradientFilter = _GradientFilter;
+        using BorderHandling = _BorderHandling;
+
+        static_assert(Eigen::NumTraits<Scalar>::IsInteger == 0, "Scalar must be floating point");
+
+        RobustFlowDetector() = default;
 
         RobustFlowDetector(const Index iterations, const Scalar alpha, const Scalar gamma)
-            : maxIt_(iterations), alpha_(alpha), gamma_(gamma),
-            gradientFilter_(), penalizer_(), handling_()
+            : _iterations(iterations), _alpha(alpha), _gamma(gamma)
         { }
 
+        /** Sets the number of outer fixed point iterations per warp, which
+          * update the penalizer weights.
+          * @param iterations number of outer iterations */
         void setMaxIterations(const Index iterations)
         {
-            maxIt_ = iterations;
+            _iterations = iterations;
+        }
+
+        /** Sets the number of SOR sweeps per outer iteration.
+          * @param iterations number of inner iterations */
+        void setInnerIterations(const Index iterations)
+        {
+            _innerIterations = iterations;
         }
 
+        /** Sets the weight of the smoothness term.
+          * Higher values make the result smoother.
+          * @param alpha smoothness constant */
         void setSmoothingConstant(const Scalar alpha)
         {
-            alpha_ = alpha;
+            _alpha = alpha;
         }
 
+        /** Sets the weight of the gradient constancy term.
+          * @param gamma gradient constant, zero disables the term */
         void setGradientConstant(const Scalar gamma)
         {
-            gamma_ = gamma;
+            _gamma = gamma;
         }
 
         void setGradientFilter(const GradientFilter &filter)
         {
-            gradientFilter_ = filter;
+            _gradient = filter;
         }
 
         void setPenalizer(const Penalizer &penalizer)
         {
-            penalizer_ = penalizer;
-        }
-
-        template<typename ScalarA>
-        void operator()(const Eigen::Tensor<ScalarA, 3> &imgA,
-            const Eigen::Tensor<ScalarA, 3> &imgB,
-            Eigen::Tensor<Scalar, 3> &flowImg) const
-        {
-            assert(imgA.dimension(2) == 1);
-            assert(imgA.dimension(0) == imgB.dimension(0));
-            assert(imgA.dimension(1) == imgB.dimension(1));
-            assert(imgA.dimension(2) == imgB.dimension(2));
-
-            Index height = imgA.dimension(0);
-            Index width = imgA.dimension(1);
-
-            Eigen::Tensor<Scalar, 3> Ix;
-            Eigen::Tensor<Scalar, 3> Iy;
-            Eigen::Tensor<Scalar, 3> IxB;
-            Eigen::Tensor<Scalar, 3> IyB;
-            Eigen::Tensor<Scalar, 3> Ixx;
-            Eigen::Tensor<Scalar, 3> Iyy;
-            Eigen::Tensor<Scalar, 3> Ixy;
-            Eigen::Tensor<Scalar, 3> It;
-            Eigen::Tensor<Scalar, 3> Ixt;
-            Eigen::Tensor<Scalar, 3> Iyt;
-
-            Eigen::Tensor<Scalar, 3> u(height, width, 1);
-            Eigen::Tensor<Scalar, 3> v(height, width, 1);
-            Eigen::Tensor<Scalar, 3> uavg;
-            Eigen::Tensor<Scalar, 3> vavg;
-            Eigen::Tensor<Scalar, 3> uprev;
-            Eigen::Tensor<Scalar, 3> vprev;
-
-            Eigen::Tensor<Scalar, 3> ux;
-            Eigen::Tensor<Scalar, 3> uy;
-            Eigen::Tensor<Scalar, 3> vx;
-            Eigen::Tensor<Scalar, 3> vy;
-
-            Eigen::Tensor<Scalar, 3> a;
-            Eigen::Tensor<Scalar, 3> b;
-            Eigen::Tensor<Scalar, 3> c;
-
-            Eigen::Tensor<Scalar, 3> dataTerm;
-            Eigen::Tensor<Scalar, 3> gradTermX;
-            Eigen::Tensor<Scalar, 3> gradTermY;
-
-            gradientFilter_(imgA, Ix, Iy);
-            gradientFilter_(imgB, IxB, IyB);
-            gradientFilter_(Ix, Ixx, Ixy);
-            gradientFilter_(Iy, Ixy, Iyy);
-
-            It = imgB.template cast<Scalar>() - imgA.template cast<Scalar>();
-            Ixt = IxB - Ix;
-            Iyt = IyB - Iy;
-
-            u.setZero();
-            v.setZero();
-
-            Eigen::Matrix<Scalar, 3, 3> kernelmat;
-            kernelmat << 0, 1, 0,
-                      1, 0, 1,
-                      0, 1, 0;
-            kernelmat /= 4;
-
-            for(Index i = 0; i < maxIt_; ++i)
+            _penalizer = penalizer;
+        }
+
+        void setBorderHandling(const BorderHandling &handling)
+        {
+            _handling = handling;
+        }
+
+        /** Sets the relaxation factor of the SOR solver.
+          * @param omega relaxation factor in (0, 2) */
+        void setRelaxation(const Scalar omega)
+        {
+            assert(omega > 0 && omega < 2);
+            _omega = omega;
+        }
+
+        /** Sets the image pyramid, which is used for the coarse to fine
+          * estimation.
+          * Levels with less than 16 pixels on a side are skipped.
+          * @param levels number of pyramid levels, 1 disables the pyramid
+          * @param factor scale factor between two consecutive levels */
+        void setPyramid(const Index levels, const Scalar factor)
+        {
+            assert(levels > 0);
+            assert(factor > 0 && factor < 1);
+            _levels = levels;
+            _factor = factor;
+        }
+
+        /** Sets the number of warps per pyramid level. */
+        void setWarps(const Index warps)
+        {
+            assert(warps > 0);
+            _warps = warps;
+        }
+
+        Index maxIterations() const
+        {
+            return _iterations;
+        }
+
+        Index innerIterations() const
+        {
+            return _innerIterations;
+        }
+
+        Scalar smoothingConstant() const
+        {
+            return _alpha;
+        }
+
+        Scalar gradientConstant() const
+        {
+            return _gamma;
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            FlowField<Scalar> &flowField) const
+        {
+            PlanarFlowField<Scalar> flow;
+            operator()(imgA, imgB, flow);
+            flowField = flow.toFlowField();
+        }
+
+        template<typename DerivedA, typename DerivedB>
+        void operator()(const ImageBase<DerivedA> &imgA,
+            const ImageBase<DerivedB> &imgB,
+            PlanarFlowField<Scalar> &flowField) const
+        {
+            static_assert(IsImage<ImageBase<DerivedA>>::value, "image A must be image type");
+            static_assert(IsImage<ImageBase<DerivedB>>::value, "image B must be image type");
+            static_assert(std::is_same<
+                typename ImageBase<DerivedA>::Scalar::ColorSpace,
+                typename ImageBase<DerivedB>::Scalar::ColorSpace>::value,
+                "images must use same color space");
+
+            using ColorSpace = typename ImageBase<DerivedA>::Scalar::ColorSpace;
+            static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
+            assert(imgA.rows() == imgB.rows());
+            assert(imgA.cols() == imgB.cols());
+
+            internal::estimateFlowCoarseToFine(imgA, imgB, _levels, _factor, flowField.u(), flowField.v(),
+                [this](const auto &levelA, const auto &levelB, auto &levelU, auto &levelV)
             {
-                gradientFilter_(u, ux, uy);
-                gradientFilter_(v, vx, vy);
+                for(Index warp = 0; warp < _warps; ++warp)
+                    refineFlow(levelA, levelB, levelU, levelV);
+            });
+        }
 
-                dataTerm = Ix * u + Iy * v + It;
-                a = (dataTerm * dataTerm).unaryExpr(penalizer_);
+        /** Refines the given flow on a single scale, e.g. the result of
+          * another flow method. Runs the configured number of warps, the
+          * pyramid settings are ignored.
+          * @param imgA first image
+          * @param imgB second image
+          * @param flowField initial flow, receives the refined flow */
+        template<typename ColorSpace>
+        void refine(const Image<ColorSpace> &imgA,
+            const Image<ColorSpace> &imgB,
+            PlanarFlowField<Scalar> &flowField) const
+        {
+            static_assert(Eigen::NumTraits<typename ColorSpace::ValueType>::IsInteger == 0, "Image must use floating point value");
+            assert(imgA.rows() == imgB.rows() && imgA.cols() == imgB.cols());
+            assert(flowField.rows() == imgA.rows() && flowField.cols() == imgA.cols());
+
+            for(Index warp = 0; warp < _warps; ++warp)
+                refineFlow(imgA, imgB, flowField.u(), flowField.v());
+        }
+
+    private:
+        using Plane = FlowPlane<Scalar>;
+
+        /** Symmetric 3x3 tensor of a linearized data term, such that the
+          * squared residual of a flow increment (du, dv) is
+          * [du dv 1] T [du dv 1]^T. */
+        struct DataTensor
+        {
+            Plane j11;
+            Plane j12;
+            Plane j22;
+            Plane j13;
+            Plane j23;
+            Plane j33;
+
+            void resize(const Index rows, const Index cols)
+            {
+                j11.resize(rows, cols);
+                j12.resize(rows, cols);
+                j22.resize(rows, cols);
+                j13.resize(rows, cols);
+                j23.resize(rows, cols);
+                j33.resize(rows, cols);
+            }
 
-                b = (ux * ux + uy * uy + vx * vx + vy * vy).unaryExpr(penalizer_);
+            Scalar residual(const Index r, const Index c, const Scalar du, const Scalar dv) const
+            {
+                return j11(r, c) * du * du + 2 * j12(r, c) * du * dv + j22(r, c) * dv * dv
+                    + 2 * (j13(r, c) * du + j23(r, c) * dv) + j33(r, c);
+            }
+        };
+
+        GradientFilter _gradient = {};
+        Penalizer _penalizer = {};
+        BorderHandling _handling = {};
+        Index _iterations = 5;
+        Index _innerIterations = 10;
+        Scalar _alpha = static_cast<Scalar>(0.02);
+        Scalar _gamma = static_cast<Scalar>(0);
+        Scalar _omega = static_cast<Scalar>(1.8);
+        Index _levels = 4;
+        Scalar _factor = static_cast<Scalar>(0.5);
+        Index _warps = 2;
+
+        /** Warps the second image with the current flow and solves the
+          * linearized functional with lagged diffusivities. */
+        template<typename ColorSpace>
+        void refineFlow(const Image<ColorSpace> &imgA,
+            const Image<ColorSpace> &imgB,
+            Plane &u,
+            Plane &v) const
+        {
+            const auto rows = imgA.rows();
+            const auto cols = imgA.cols();
+
+            DataTensor brightness;
+            DataTensor gradient;
+            computeDataTensors(imgA, imgB, u, v, brightness, gradient);
+
+            const Plane u0 = u;
+            const Plane v0 = v;
+            Plane diffusivity(rows, cols);
+            internal::FlowSystem<Scalar> system;
+            system.resize(rows, cols);
+
+            for(Index i = 0; i < _iterations; ++i)
+            {
+                // penalizer weights and linear system in a single pass
+                parallel::forEach(0, cols, [&](const Index c)
+                {
+                    const auto cm = std::max<Index>(c - 1, 0);
+                    const auto cp = std::min<Index>(c + 1, cols - 1);
+                    const auto scaleX = Scalar{1} / static_cast<Scalar>(std::max<Index>(cp - cm, 1));
 
-                gradTermX = Ixx * u + Ixy * v + Ixt;
-                gradTermY = Ixy * u + Iyy * v + Iyt;
-                c = (gradTermX * gradTermX + gradTermY * gradTermY).unaryExpr(penalizer_);
+                    for(Index r = 0; r < rows; ++r)
+                    {
+                        const auto rm = std::max<Index>(r - 1, 0);
+                        const auto rp = std::min<Index>(r + 1, rows - 1);
+                        const auto scaleY = Scalar{1} / static_cast<Scalar>(std::max<Index>(rp - rm, 1));
 
-                kernel::apply(u, uavg, kernelmat, handling_);
-                kernel::apply(v, vavg, kernelmat, handling_);
+                        const auto ux = (u(r, cp) - u(r, cm)) * scaleX;
+                        const auto uy = (u(rp, c) - u(rm, c)) * scaleY;
+                        const auto vx = (v(r, cp) - v(r, cm)) * scaleX;
+                        const auto vy = (v(rp, c) - v(rm, c)) * scaleY;
+                        diffusivity(r, c) = _penalizer(ux * ux + uy * uy + vx * vx + vy * vy);
 
-                uprev = u;
-                vprev = v;
+                        const auto du = u(r, c) - u0(r, c);
+                        const auto dv = v(r, c) - v0(r, c);
+                        const auto weightA = _penalizer(brightness.residual(r, c, du, dv));
+                        const auto weightC = _gamma > 0 ? _gamma * _penalizer(gradient.residual(r, c, du, dv)) : Scalar{0};
 
-                u = (a * Ix * It + gamma_ * c * (Ixt * Ixx + Iyt * Ixy)
-                    + alpha_ * b * uavg
-                    - v * (a * Iy * Ix + gamma_ * c * Ixy * (Ixx + Iyy)))
-                    / (a * Ix * Ix + 4 * alpha_ * b + gamma_ * c * (Ixx * Ixx + Ixy * Ixy));
+                        const auto j11 = weightA * brightness.j11(r, c) + weightC * gradient.j11(r, c);
+                        const auto j12 = weightA * brightness.j12(r, c) + weightC * gradient.j12(r, c);
+                        const auto j22 = weightA * brightness.j22(r, c) + weightC * gradient.j22(r, c);
+                        const auto j13 = weightA * brightness.j13(r, c) + weightC * gradient.j13(r, c);
+                        const auto j23 = weightA * brightness.j23(r, c) + weightC * gradient.j23(r, c);
 
-                v = (a * Iy * It + gamma_ * c * (Ixt * Ixy + Iyt * Iyy)
-                    + alpha_ * b * vavg
-                    - u * (a * Ix * Iy + gamma_ * c * Ixy * (Ixx + Iyy)))
-                    / (a * Iy * Iy + 4 * alpha_ * b + gamma_ * c * (Iyy * Iyy + Ixy * Ixy));
+                        // the data terms are linearized around the flow of
+                        // the warp, thus J [u v] = J [u0 v0] - [j13 j23]
+                        system.j11(r, c) = j11;
+                        system.j12(r, c) = j12;
+                        system.j22(r, c) = j22;
+                        system.b1(r, c) = j11 * u0(r, c) + j12 * v0(r, c) - j13;
+                        system.b2(r, c) = j12 * u0(r, c) + j22 * v0(r, c) - j23;
+                    }
+                });
+
+                // smoothness weights between neighbouring pixels
+                parallel::forEach(0, cols, [&](const Index c)
+                {
+                    for(Index r = 0; r < rows; ++r)
+                    {
+                        system.weightX(r, c) = c + 1 < cols ? _alpha * (diffusivity(r, c) + diffusivity(r, c + 1)) / 2 : Scalar{0};
+                        system.weightY(r, c) = r + 1 < rows ? _alpha * (diffusivity(r, c) + diffusivity(r + 1, c)) / 2 : Scalar{0};
+                    }
+                });
+
+                internal::solveFlowSOR(system, u, v, _innerIterations, _omega);
             }
+        }
+
+        /** Computes the tensors of the brightness and gradient constancy
+          * terms between the first image and the second image warped by the
+          * current flow. The spatial derivatives are computed on the mean of
+          * both images. Pixels, which are warped outside of the second image,
+          * have no data terms. */
+        template<typename ColorSpace>
+        void computeDataTensors(const Image<ColorSpace> &imgA,
+            const Image<ColorSpace> &imgB,
+            const Plane &u,
+            const Plane &v,
+            DataTensor &brightness,
+            DataTensor &gradient) const
+        {
+            constexpr Index Dimension = ColorSpace::Dimension;
+            const auto rows = imgA.rows();
+            const auto cols = imgA.cols();
+
+            Image<ColorSpace> warped;
+            Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> inside;
+            internal::warpFlowImage(imgB, u, v, warped, inside);
+
+            const auto gradientA = _gradient(imgA, GradientMode::XY{}, _handling);
+            const auto gradientB = _gradient(warped, GradientMode::XY{}, _handling);
+            const Image<ColorSpace> meanX = (gradientA.x + gradientB.x) * static_cast<Scalar>(0.5);
+            const Image<ColorSpace> meanY = (gradientA.y + gradientB.y) * static_cast<Scalar>(0.5);
 
-            flowImg.resize(height, width, 2);
-            for(Index c = 0; c < width; ++c)
+            // second derivatives are only needed for the gradient constancy
+            decltype(_gradient(meanX, GradientMode::XY{}, _handling)) gradientX;
+            decltype(_gradient(meanY, GradientMode::XY{}, _handling)) gradientY;
+            if(_gamma > 0)
             {
-                for(Index r = 0; r < height; ++r)
+                gradientX = _gradient(meanX, GradientMode::XY{}, _handling);
+                gradientY = _gradient(meanY, GradientMode::XY{}, _handling);
+            }
+
+            const auto scale = Scalar{1} / static_cast<Scalar>(internal::derivativeScale<typename GradientFilter::KernelX>());
+            const auto channelScale = Scalar{1} / static_cast<Scalar>(Dimension);
+
+            brightness.resize(rows, cols);
+            gradient.resize(rows, cols);
+
+            parallel::forEach(0, cols, [&](const Index c)
+            {
+                for(Index r = 0; r < rows; ++r)
                 {
-                    flowImg(r, c, 0) = -u(r, c, 0);
-                    flowImg(r, c, 1) = -v(r, c, 0);
+                    Eigen::Matrix<Scalar, 3, 3> tensorA = Eigen::Matrix<Scalar, 3, 3>::Zero();
+                    Eigen::Matrix<Scalar, 3, 3> tensorC = Eigen::Matrix<Scalar, 3, 3>::Zero();
+                    if(inside(r, c))
+                    {
+                        for(Index d = 0; d < Dimension; ++d)
+                        {
+                            const Eigen::Matrix<Scalar, 3, 1> data(
+                                static_cast<Scalar>(meanX(r, c)[d]) * scale,
+                                static_cast<Scalar>(meanY(r, c)[d]) * scale,
+                                static_cast<Scalar>(warped(r, c)[d]) - static_cast<Scalar>(imgA(r, c)[d]));
+                            tensorA += data * data.transpose();
+
+                            if(_gamma > 0)
+                            {
+                                const auto ixy = (static_cast<Scalar>(gradientX.y(r, c)[d]) + static_cast<Scalar>(gradientY.x(r, c)[d])) * scale * scale / 2;
+                                const Eigen::Matrix<Scalar, 3, 1> dataX(
+                                    static_cast<Scalar>(gradientX.x(r, c)[d]) * scale * scale,
+                                    ixy,
+                                    (static_cast<Scalar>(gradientB.x(r, c)[d]) - static_cast<Scalar>(gradientA.x(r, c)[d])) * scale);
+                                const Eigen::Matrix<Scalar, 3, 1> dataY(
+                                    ixy,
+                                    static_cast<Scalar>(gradientY.y(r, c)[d]) * scale * scale,
+                                    (static_cast<Scalar>(gradientB.y(r, c)[d]) - static_cast<Scalar>(gradientA.y(r, c)[d])) * scale);
+                                tensorC += dataX * dataX.transpose() + dataY * dataY.transpose();
+                            }
+                        }
+                    }
+
+                    tensorA *= channelScale;
+                    tensorC *= channelScale;
+                    setTensor(brightness, r, c, tensorA);
+                    setTensor(gradient, r, c, tensorC);
                 }
-            }
+            });
+        }
+
+        static void setTensor(DataTensor &tensor, const Index r, const Index c, const Eigen::Matrix<Scalar, 3, 3> &values)
+        {
+            tensor.j11(r, c) = values(0, 0);
+            tensor.j12(r, c) = values(0, 1);
+            tensor.j22(r, c) = values(1, 1);
+            tensor.j13(r, c) = values(0, 2);
+            tensor.j23(r, c) = values(1, 2);
+            tensor.j33(r, c) = values(2, 2);
         }
     };
 }
@@ -0,0 +1,548 @@
+/* variational_flow_solver.h
+ *
+ * Author: Fabian Meyer
+ * Created On: 18 Oct 2026
+ */
+
+#ifndef NVISION_VARIATIONAL_FLOW_SOLVER_H_
+#define NVISION_VARIATIONAL_FLOW_SOLVER_H_
+
+#include <algorithm>
+#include <vector>
+#include "nvision/src/core/image.h"
+#include "nvision/src/core/image_interpolation.h"
+#include "nvision/src/core/image_pyramid.h"
+#include "nvision/src/core/parallel.h"
+#include "nvision/src/optflow/flow_field.h"
+
+namespace nvision::internal
+{
+    /** Returns the response of a compile-time derivative kernel to a unit
+      * ramp, which is used to normalize the gradients to pixel units, e.g.
+      * 8 for Sobel and 2 for central differences. */
+    template<typename Kernel>
+    constexpr int derivativeScale()
+    {
+        int result = 0;
+        for(Index r = -Kernel::Rows / 2; r <= Kernel::Rows / 2; ++r)
+            for(Index c = -Kernel::Cols / 2; c <= Kernel::Cols / 2; ++c)
+                result += Kernel::weight(r, c) * static_cast<int>(c);
+        return result;
+    }
+
+    /** Linear system of a variational optical flow method
+      *
+      *   (J + L) [u v] = [b1 b2]
+      *
+      * The symmetric motion tensor J = [j11 j12; j12 j22] couples both flow
+      * components of a pixel. The Laplacian L couples neighbouring pixels by
+      * the smoothness weights; weightX connects (r, c) and (r, c + 1),
+      * weightY connects (r, c) and (r + 1, c). No flux crosses the borders. */
+    template<typename Scalar>
+    struct FlowSystem
+    {
+        FlowPlane<Scalar> j11;
+        FlowPlane<Scalar> j12;
+        FlowPlane<Scalar> j22;
+        FlowPlane<Scalar> b1;
+        FlowPlane<Scalar> b2;
+        FlowPlane<Scalar> weightX;
+        FlowPlane<Scalar> weightY;
+
+        void resize(const Index rows, const Index cols)
+        {
+            j11.resize(rows, cols);
+            j12.resize(rows, cols);
+            j22.resize(rows, cols);
+            b1.resize(rows, cols);
+            b2.resize(rows, cols);
+            weightX.resize(rows, cols);
+            weightY.resize(rows, cols);
+        }
+
+        /** Sets all smoothness weights to the given constant. */
+        void setConstantWeights(const Scalar weight)
+        {
+            weightX.setConstant(weight);
+            weightY.setConstant(weight);
+            weightX.rightCols(1).setZero();
+            weightY.bottomRows(1).setZero();
+        }
+
+        Index rows() const
+        {
+            return j11.rows();
+        }
+
+        Index cols() const
+        {
+            return j11.cols();
+        }
+    };
+
+    /** Solves the 2x2 system of a single pixel, whose neighbours are kept
+      * fixed, and passes the solution to func(u, v). */
+    template<typename Scalar, typename Func>
+    inline void solveFlowPixel(const FlowSystem<Scalar> &system,
+        const FlowPlane<Scalar> &u,
+        const FlowPlane<Scalar> &v,
+        const Index r,
+        const Index c,
+        Func &&func)
+    {
+        const auto rows = system.rows();
+        const auto cols = system.cols();
+
+        Scalar weightSum = 0;
+        Scalar sumU = system.b1(r, c);
+        Scalar sumV = system.b2(r, c);
+        const auto add = [&](const Scalar weight, const Index row, const Index col)
+        {
+            weightSum += weight;
+            sumU += weight * u(row, col);
+            sumV += weight * v(row, col);
+        };
+
+        if(r > 0)
+            add(system.weightY(r - 1, c), r - 1, c);
+        if(r + 1 < rows)
+            add(system.weightY(r, c), r + 1, c);
+        if(c > 0)
+            add(system.weightX(r, c - 1), r, c - 1);
+        if(c + 1 < cols)
+            add(system.weightX(r, c), r, c + 1);
+
+        const auto a11 = system.j11(r, c) + weightSum;
+        const auto a22 = system.j22(r, c) + weightSum;
+        const auto a12 = system.j12(r, c);
+        const auto det = a11 * a22 - a12 * a12;
+        if(det > Scalar{0})
+            func((a22 * sumU - a12 * sumV) / det, (a11 * sumV - a12 * sumU) / det);
+        else
+            func(u(r, c), v(r, c));
+    }
+
+    /** Applies red-black SOR sweeps to the flow system. All pixels of one
+      * color only depend on pixels of the other color, thus each half sweep
+      * runs in parallel over the columns.
+      * @param system linear system
+      * @param u horizontal flow component, receives the solution
+      * @param v vertical flow component, receives the solution
+      * @param iterations number of sweeps
+      * @param omega relaxation factor in (0, 2), 1 yields Gauss-Seidel */
+    template<typename Scalar>
+    inline void solveFlowSOR(const FlowSystem<Scalar> &system,
+        FlowPlane<Scalar> &u,
+        FlowPlane<Scalar> &v,
+        const Index iterations,
+        const Scalar omega)
+    {
+        const auto rows = system.rows();
+        const auto cols = system.cols();
+        for(Index i = 0; i < iterations; ++i)
+        {
+            for(Index color = 0; color < 2; ++color)
+            {
+                parallel::forEach(0, cols, [&](const Index c)
+                {
+                    const auto update = [&](const Index r)
+                    {
+                        solveFlowPixel(system, u, v, r, c, [&](const Scalar newU, const Scalar newV)
+                        {
+                            u(r, c) += omega * (newU - u(r, c));
+                            v(r, c) += omega * (newV - v(r, c));
+                        });
+                    };
+
+                    const auto first = (c + color) % 2;
+                    if(c == 0 || c + 1 == cols)
+                    {
+                        for(Index r = first; r < rows; r += 2)
+                            update(r);
+                        return;
+                    }
+
+                    // interior pixels have all four neighbours
+                    if(first == 0)
+                        update(0);
+                    Index r = first == 0 ? 2 : 1;
+                    for(; r + 1 < rows; r += 2)
+                    {
+                        const auto weightN = system.weightY(r - 1, c);
+                        const auto weightS = system.weightY(r, c);
+                        const auto weightW = system.weightX(r, c - 1);
+                        const auto weightE = system.weightX(r, c);
+                        const auto weightSum = weightN + weightS + weightW + weightE;
+                        const auto sumU = system.b1(r, c) + weightN * u(r - 1, c) + weightS * u(r + 1, c)
+                            + weightW * u(r, c - 1) + weightE * u(r, c + 1);
+                        const auto sumV = system.b2(r, c) + weightN * v(r - 1, c) + weightS * v(r + 1, c)
+                            + weightW * v(r, c - 1) + weightE * v(r, c + 1);
+
+                        const auto a11 = system.j11(r, c) + weightSum;
+                        const auto a22 = system.j22(r, c) + weightSum;
+                        const auto a12 = system.j12(r, c);
+                        const auto det = a11 * a22 - a12 * a12;
+                        if(det > Scalar{0})
+                        {
+                            const auto invDet = Scalar{1} / det;
+                            u(r, c) += omega * ((a22 * sumU - a12 * sumV) * invDet - u(r, c));
+                            v(r, c) += omega * ((a11 * sumV - a12 * sumU) * invDet - v(r, c));
+                        }
+                    }
+                    if(r < rows)
+                        update(r);
+                });
+            }
+        }
+    }
+
+    /** Computes the residual b - (J + L) [u v] of the flow system. */
+    template<typename Scalar>
+    inline void computeFlowResidual(const FlowSystem<Scalar> &system,
+        const FlowPlane<Scalar> &u,
+        const FlowPlane<Scalar> &v,
+        FlowPlane<Scalar> &residualU,
+        FlowPlane<Scalar> &residualV)
+    {
+        const auto rows = system.rows();
+        const auto cols = system.cols();
+        residualU.resize(rows, cols);
+        residualV.resize(rows, cols);
+
+        parallel::forEach(0, cols, [&](const Index c)
+        {
+            for(Index r = 0; r < rows; ++r)
+            {
+                auto resU = system.b1(r, c) - system.j11(r, c) * u(r, c) - system.j12(r, c) * v(r, c);
+                auto resV = system.b2(r, c) - system.j12(r, c) * u(r, c) - system.j22(r, c) * v(r, c);
+                const auto add = [&](const Scalar weight, const Index row, const Index col)
+                {
+                    resU += weight * (u(row, col) - u(r, c));
+                    resV += weight * (v(row, col) - v(r, c));
+                };
+
+                if(r > 0)
+                    add(system.weightY(r - 1, c), r - 1, c);
+                if(r + 1 < rows)
+                    add(system.weightY(r, c), r + 1, c);
+                if(c > 0)
+                    add(system.weightX(r, c - 1), r, c - 1);
+                if(c + 1 < cols)
+                    add(system.weightX(r, c), r, c + 1);
+
+                residualU(r, c) = resU;
+                residualV(r, c) = resV;
+            }
+        });
+    }
+
+    /** Restricts a plane to half its size by averaging blocks of 2x2
+      * pixels. */
+    template<typename Scalar>
+    inline FlowPlane<Scalar> restrictFlowPlane(const FlowPlane<Scalar> &fine)
+    {
+        const auto rows = (fine.rows() + 1) / 2;
+        const auto cols = (fine.cols() + 1) / 2;
+        FlowPlane<Scalar> coarse(rows, cols);
+        for(Index c = 0; c < cols; ++c)
+        {
+            const auto c1 = 2 * c;
+            const auto c2 = std::min(c1 + 1, fine.cols() - 1);
+            for(Index r = 0; r < rows; ++r)
+            {
+                const auto r1 = 2 * r;
+                const auto r2 = std::min(r1 + 1, fine.rows() - 1);
+                coarse(r, c) = (fine(r1, c1) + fine(r2, c1) + fine(r1, c2) + fine(r2, c2)) / 4;
+            }
+        }
+        return coarse;
+    }
+
+    /** Restricts the motion tensor and the smoothness weights of a flow
+      * system to half its resolution. The weights are averaged over the
+      * fine edges, which cross the coarse edge, and scaled by the squared
+      * ratio of the grid spacings. */
+    template<typename Scalar>
+    inline FlowSystem<Scalar> restrictFlowSystem(const FlowSystem<Scalar> &fine)
+    {
+        FlowSystem<Scalar> coarse;
+        coarse.j11 = restrictFlowPlane(fine.j11);
+        coarse.j12 = restrictFlowPlane(fine.j12);
+        coarse.j22 = restrictFlowPlane(fine.j22);
+
+        const auto rows = coarse.j11.rows();
+        const auto cols = coarse.j11.cols();
+        coarse.b1.setZero(rows, cols);
+        coarse.b2.setZero(rows, cols);
+        coarse.weightX.setZero(rows, cols);
+        coarse.weightY.setZero(rows, cols);
+
+        for(Index c = 0; c < cols; ++c)
+        {
+            for(Index r = 0; r < rows; ++r)
+            {
+                const auto r1 = 2 * r;
+                const auto r2 = std::min(r1 + 1, fine.rows() - 1);
+                const auto c1 = 2 * c;
+                const auto c2 = std::min(c1 + 1, fine.cols() - 1);
+                if(c + 1 < cols)
+                    coarse.weightX(r, c) = (fine.weightX(r1, c2) + fine.weightX(r2, c2)) / 8;
+                if(r + 1 < rows)
+                    coarse.weightY(r, c) = (fine.weightY(r2, c1) + fine.weightY(r2, c2)) / 8;
+            }
+        }
+
+        return coarse;
+    }
+
+    /** Interpolates a coarse plane bilinearly to the fine resolution and
+      * adds it to the fine plane. */
+    template<typename Scalar>
+    inline void prolongateFlowPlane(const FlowPlane<Scalar> &coarse, FlowPlane<Scalar> &fine)
+    {
+        const auto coordinate = [](const Index idx, const Index size, Index &idx1, Index &idx2, Scalar &weight)
+        {
+            const auto pos = std::clamp((static_cast<Scalar>(idx) + Scalar{0.5}) / 2 - Scalar{0.5}, Scalar{0}, static_cast<Scalar>(size - 1));
+            idx1 = static_cast<Index>(pos);
+            idx2 = std::min(idx1 + 1, size - 1);
+            weight = pos - static_cast<Scalar>(idx1);
+        };
+
+        parallel::forEach(0, fine.cols(), [&](const Index c)
+        {
+            Index c1, c2;
+            Scalar wc;
+            coordinate(c, coarse.cols(), c1, c2, wc);
+            for(Index r = 0; r < fine.rows(); ++r)
+            {
+                Index r1, r2;
+                Scalar wr;
+                coordinate(r, coarse.rows(), r1, r2, wr);
+                fine(r, c) += (1 - wr) * ((1 - wc) * coarse(r1, c1) + wc * coarse(r1, c2))
+                    + wr * ((1 - wc) * coarse(r2, c1) + wc * coarse(r2, c2));
+            }
+        });
+    }
+
+    /** Resamples a flow component bilinearly to the given size, e.g. to
+      * propagate the flow to the next level of an image pyramid.
+      * @param plane flow component
+      * @param rows number of rows of the result
+      * @param cols number of columns of the result
+      * @param scale factor, which is applied to the flow values
+      * @return resampled flow component */
+    template<typename Scalar>
+    inline FlowPlane<Scalar> resampleFlowPlane(const FlowPlane<Scalar> &plane, const Index rows, const Index cols, const Scalar scale)
+    {
+        const auto scaleRow = static_cast<Scalar>(plane.rows()) / static_cast<Scalar>(rows);
+        const auto scaleCol = static_cast<Scalar>(plane.cols()) / static_cast<Scalar>(cols);
+
+        FlowPlane<Scalar> result(rows, cols);
+        parallel::forEach(0, cols, [&](const Index c)
+        {
+            const auto col = std::min(static_cast<Scalar>(c) * scaleCol, static_cast<Scalar>(plane.cols() - 1));
+            const auto c1 = static_cast<Index>(col);
+            const auto c2 = std::min(c1 + 1, plane.cols() - 1);
+            const auto wc = col - static_cast<Scalar>(c1);
+            for(Index r = 0; r < rows; ++r)
+            {
+                const auto row = std::min(static_cast<Scalar>(r) * scaleRow, static_cast<Scalar>(plane.rows() - 1));
+                const auto r1 = static_cast<Index>(row);
+                const auto r2 = std::min(r1 + 1, plane.rows() - 1);
+                const auto wr = row - static_cast<Scalar>(r1);
+                result(r, c) = scale * ((1 - wr) * ((1 - wc) * plane(r1, c1) + wc * plane(r1, c2))
+                    + wr * ((1 - wc) * plane(r2, c1) + wc * plane(r2, c2)));
+            }
+        });
+
+        return result;
+    }
+
+    /** Warps an image with the given flow by bilinear interpolation, such
+      * that warped(r, c) = img(r + v, c + u).
+      * @param img image which is warped
+      * @param u horizontal flow component
+      * @param v vertical flow component
+      * @param warped receives the warped image
+      * @param inside receives whether the flow of a pixel stays within the image */
+    template<typename Scalar, typename ColorSpace>
+    inline void warpFlowImage(const Image<ColorSpace> &img,
+        const FlowPlane<Scalar> &u,
+        const FlowPlane<Scalar> &v,
+        Image<ColorSpace> &warped,
+        Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> &inside)
+    {
+        const auto rows = img.rows();
+        const auto cols = img.cols();
+        warped.resize(rows, cols);
+        inside.resize(rows, cols);
+
+        parallel::forEach(0, cols, [&](const Index c)
+        {
+            for(Index r = 0; r < rows; ++r)
+            {
+                const auto row = static_cast<Scalar>(r) + v(r, c);
+                const auto col = static_cast<Scalar>(c) + u(r, c);
+                inside(r, c) = row >= 0 && row <= static_cast<Scalar>(rows - 1) && col >= 0 && col <= static_cast<Scalar>(cols - 1);
+                warped(r, c) = image::interpolateBilinear(img, row, col);
+            }
+        });
+    }
+
+    /** Estimates the flow between two images coarse to fine over image
+      * pyramids. The flow of each level is initialized with the upsampled
+      * flow of the next coarser level and passed to refine(imgA, imgB, u, v).
+      * Levels with less than 16 pixels on a side are skipped, because the
+      * downsampling aliases them.
+      * @param imgA first image
+      * @param imgB second image
+      * @param levels maximum number of pyramid levels
+      * @param factor scale factor between two consecutive levels
+      * @param u receives the horizontal flow component
+      * @param v receives the vertical flow component
+      * @param refine functor, which refines the flow on a single level */
+    template<typename Scalar, typename DerivedA, typename DerivedB, typename Refine>
+    inline void estimateFlowCoarseToFine(const ImageBase<DerivedA> &imgA,
+        const ImageBase<DerivedB> &imgB,
+        const Index levels,
+        const Scalar factor,
+        FlowPlane<Scalar> &u,
+        FlowPlane<Scalar> &v,
+        Refine &&refine)
+    {
+        using ColorSpace = typename ImageBase<DerivedA>::Scalar::ColorSpace;
+
+        constexpr Index minLevelSize = 16;
+        auto levelCount = levels;
+        while(levelCount > 1 && static_cast<Scalar>(std::min(imgA.rows(), imgA.cols())) * std::pow(factor, static_cast<Scalar>(levelCount - 1)) < minLevelSize)
+            --levelCount;
+
+        const ImagePyramid<Scalar, ColorSpace> pyramidA(imgA, levelCount, factor);
+        const ImagePyramid<Scalar, ColorSpace> pyramidB(imgB, levelCount, factor);
+
+        for(Index level = levelCount - 1; level >= 0; --level)
+        {
+            const auto &levelA = pyramidA.images()[level];
+            const auto &levelB = pyramidB.images()[level];
+
+            if(level == levelCount - 1)
+            {
+                u.setZero(levelA.rows(), levelA.cols());
+                v.setZero(levelA.rows(), levelA.cols());
+            }
+            else
+            {
+                u = resampleFlowPlane(u, levelA.rows(), levelA.cols(), static_cast<Scalar>(levelA.cols()) / static_cast<Scalar>(u.cols()));
+                v = resampleFlowPlane(v, levelA.rows(), levelA.cols(), static_cast<Scalar>(levelA.rows()) / static_cast<Scalar>(v.rows()));
+            }
+
+            refine(levelA, levelB, u, v);
+        }
+    }
+
+    /** Hierarchy of flow systems for multigrid, the first level is the
+      * finest one. */
+    template<typename Scalar>
+    using FlowHierarchy = std::vector<FlowSystem<Scalar>>;
+
+    /** Builds the multigrid hierarchy of the given fine system, coarsening
+      * until one side has less than minSize pixels. */
+    template<typename Scalar>
+    inline FlowHierarchy<Scalar> makeFlowHierarchy(const FlowSystem<Scalar> &system, const Index minSize = 8)
+    {
+        FlowHierarchy<Scalar> hierarchy;
+        hierarchy.push_back(system);
+        while(std::min(hierarchy.back().rows(), hierarchy.back().cols()) >= 2 * minSize)
+            hierarchy.push_back(restrictFlowSystem(hierarchy.back()));
+        return hierarchy;
+    }
+
+    /** Applies a single multigrid V-cycle to the given level of the
+      * hierarchy. The right hand sides of all coarser levels are
+      * overwritten with the restricted residuals. */
+    template<typename Scalar>
+    inline void flowVCycle(FlowHierarchy<Scalar> &hierarchy,
+        const size_t level,
+        FlowPlane<Scalar> &u,
+        FlowPlane<Scalar> &v)
+    {
+        constexpr Index smoothingSteps = 2;
+        constexpr Index coarsestSteps = 30;
+        const auto &system = hierarchy[level];
+
+        if(level + 1 == hierarchy.size())
+        {
+            solveFlowSOR(system, u, v, coarsestSteps, Scalar{1.5});
+            return;
+        }
+
+        solveFlowSOR(system, u, v, smoothingSteps, Scalar{1});
+
+        FlowPlane<Scalar> residualU;
+        FlowPlane<Scalar> residualV;
+        computeFlowResidual(system, u, v, residualU, residualV);
+
+        auto &coarse = hierarchy[level + 1];
+        coarse.b1 = restrictFlowPlane(residualU);
+        coarse.b2 = restrictFlowPlane(residualV);
+
+        FlowPlane<Scalar> errorU = FlowPlane<Scalar>::Zero(coarse.rows(), coarse.cols());
+        FlowPlane<Scalar> errorV = FlowPlane<Scalar>::Zero(coarse.rows(), coarse.cols());
+        flowVCycle(hierarchy, level + 1, errorU, errorV);
+
+        prolongateFlowPlane(errorU, u);
+        prolongateFlowPlane(errorV, v);
+
+        solveFlowSOR(system, u, v, smoothingSteps, Scalar{1});
+    }
+
+    /** Solves the finest system of the hierarchy with full multigrid.
+      * The right hand side is restricted to all levels, solved on the
+      * coarsest level and interpolated level by level, each followed by a
+      * V-cycle. The interpolated solution is refined by the given number of
+      * V-cycles on the finest level. For a hierarchy with a single level
+      * each V-cycle solves the system directly.
+      * @param hierarchy multigrid hierarchy
+      * @param u horizontal flow component, must be zero initially
+      * @param v vertical flow component, must be zero initially
+      * @param cycles number of V-cycles on the finest level, at least one */
+    template<typename Scalar>
+    inline void solveFlowMultigrid(FlowHierarchy<Scalar> &hierarchy,
+        FlowPlane<Scalar> &u,
+        FlowPlane<Scalar> &v,
+        const Index cycles)
+    {
+        assert(cycles > 0);
+
+        for(size_t level = 1; level < hierarchy.size(); ++level)
+        {
+            hierarchy[level].b1 = restrictFlowPlane(hierarchy[level - 1].b1);
+            hierarchy[level].b2 = restrictFlowPlane(hierarchy[level - 1].b2);
+        }
+
+        std::vector<FlowPlane<Scalar>> levelU(hierarchy.size());
+        std::vector<FlowPlane<Scalar>> levelV(hierarchy.size());
+        for(size_t level = hierarchy.size(); level-- > 1;)
+        {
+            levelU[level].setZero(hierarchy[level].rows(), hierarchy[level].cols());
+            levelV[level].setZero(hierarchy[level].rows(), hierarchy[level].cols());
+            if(level + 1 < hierarchy.size())
+            {
+                prolongateFlowPlane(levelU[level + 1], levelU[level]);
+                prolongateFlowPlane(levelV[level + 1], levelV[level]);
+            }
+            flowVCycle(hierarchy, level, levelU[level], levelV[level]);
+        }
+
+        if(hierarchy.size() > 1)
+        {
+            prolongateFlowPlane(levelU[1], u);
+            prolongateFlowPlane(levelV[1], v);
+        }
+
+        for(Index i = 0; i < cycles; ++i)
+            flowVCycle(hierarchy, 0, u, v);
+    }
+}
+
+#endif